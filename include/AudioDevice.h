@@ -33,6 +33,7 @@
 
 class AudioEngine;
 class AudioPort;
+class Mixer;
 class QThread;
 
 
@@ -61,6 +62,13 @@ public:
 	virtual void unregisterPort( AudioPort * _port );
 	virtual void renamePort( AudioPort * _port );
 
+	// called by the mixer on the rendering thread after all channels are
+	// processed, so that audio-drivers can provide the output of the
+	// individual channels - currently only supported by JACK
+	virtual void processMixerChannels( Mixer * /* _mixer */ )
+	{
+	}
+
 
 	inline bool supportsCapture() const
 	{
@@ -102,6 +110,11 @@ protected:
 	// called by according driver for fetching new sound-data
 	fpp_t getNextBuffer( surroundSampleFrame * _ab );
 
+	// same as getNextBuffer(), but without copying the sound-data if it
+	// doesn't need to be resampled - the returned buffer stays valid
+	// until the next call
+	const surroundSampleFrame * getNextBufferDirect( fpp_t & _frames );
+
 	// convert a given audio-buffer to a buffer in signed 16-bit samples
 	// returns num of bytes in outbuf
 	int convertToS16( const surroundSampleFrame * _ab,
@@ -152,6 +165,8 @@ private:
 	SRC_STATE * m_srcState;
 
 	surroundSampleFrame * m_buffer;
+	// buffer from the audio engine's FIFO, returned by getNextBufferDirect()
+	const surroundSampleFrame * m_fifoBuffer;
 
 } ;
 
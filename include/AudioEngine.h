@@ -29,20 +29,27 @@
 #include <QtCore/QThread>
 #include <QtCore/QVector>
 #include <QtCore/QWaitCondition>
+#include <atomic>
+#include <memory>
 #include <samplerate.h>
 
 
 #include "lmms_basics.h"
 #include "LocklessList.h"
+#include "Midi.h"
 #include "Note.h"
 #include "FifoBuffer.h"
 #include "AudioEngineProfiler.h"
+#include "VoiceLimiter.h"
 #include "PlayHandle.h"
 
 
 class AudioDevice;
 class MidiClient;
+class MidiPort;
 class AudioPort;
+template<class T> class LocklessRingBuffer;
+template<class T> class LocklessRingBufferReader;
 
 
 const fpp_t MINIMUM_BUFFER_SIZE = 32;
@@ -191,6 +198,12 @@ public:
 
 	void removeAudioPort(AudioPort * port);
 
+	//! Highest latency of all audio ports, the others are delayed to it
+	inline f_cnt_t maxLatency() const
+	{
+		return m_maxLatency;
+	}
+
 
 	// MIDI-client-stuff
 	inline const QString & midiClientName() const
@@ -203,6 +216,16 @@ public:
 		return m_midiClient;
 	}
 
+	// MIDI ports whose queued input events are processed each period
+	inline void addMidiPort(MidiPort * port)
+	{
+		requestChangeInModel();
+		m_midiPorts.push_back(port);
+		doneChangeInModel();
+	}
+
+	void removeMidiPort(MidiPort * port);
+
 
 	// play-handle stuff
 	bool addPlayHandle( PlayHandle* handle );
@@ -229,6 +252,11 @@ public:
 		return m_framesPerPeriod;
 	}
 
+	//! Render periods of @p frames, the callback size of the audio device,
+	//! clamped to MINIMUM_BUFFER_SIZE and the configured size. Only the
+	//! first device can do this, before anything allocated by the period.
+	void requestFramesPerPeriod( fpp_t frames );
+
 
 	AudioEngineProfiler& profiler()
 	{
@@ -240,6 +268,11 @@ public:
 		return m_profiler.cpuLoad();
 	}
 
+	VoiceLimiter& voiceLimiter()
+	{
+		return m_voiceLimiter;
+	}
+
 	const qualitySettings & currentQualitySettings() const
 	{
 		return m_qualitySettings;
@@ -293,22 +326,28 @@ public:
 		return m_fifoWriter != nullptr;
 	}
 
-	void pushInputFrames( sampleFrame * _ab, const f_cnt_t _frames );
-
-	void addInputFrames ( sampleFrame * _data, const f_cnt_t _frames);
-
-	sampleFrame* inputFrameBuffer;
-
-	f_cnt_t inputFrameCount = 0;
+	// called by audio devices which support capture, from any thread -
+	// doesn't lock or allocate, frames which don't fit are dropped
+	void pushInputFrames( const sampleFrame * _ab, const f_cnt_t _frames );
 
+	// input of the current period, always framesPerPeriod() frames
 	inline const sampleFrame * inputBuffer()
 	{
-		return m_inputBuffer[ m_inputBufferRead ];
+		return m_inputBuffer;
 	}
 
+	// number of frames the device captured for the current period,
+	// 0 if it didn't deliver a full period in time
 	inline f_cnt_t inputBufferFrames() const
 	{
-		return m_inputBufferFrames[ m_inputBufferRead ];
+		return m_inputBufferFrames;
+	}
+
+	// number of times monitored input was skipped to keep its latency low,
+	// recording still gets every frame
+	inline int inputOverruns() const
+	{
+		return m_inputOverruns;
 	}
 
 	inline const surroundSampleFrame * nextBuffer()
@@ -383,14 +422,26 @@ private:
 	bool m_renderOnly;
 
 	QVector<AudioPort *> m_audioPorts;
+	f_cnt_t m_maxLatency;
+	QVector<MidiPort *> m_midiPorts;
+	MidiClock::time_point m_lastPeriodStart;
 
 	fpp_t m_framesPerPeriod;
-
-	sampleFrame * m_inputBuffer[2];
-	f_cnt_t m_inputBufferFrames[2];
-	f_cnt_t m_inputBufferSize[2];
-	int m_inputBufferRead;
-	int m_inputBufferWrite;
+	// set once the first audio device is created
+	bool m_framesPerPeriodFixed;
+
+	void readInput();
+
+	std::unique_ptr<LocklessRingBuffer<sampleFrame>> m_inputRing;
+	// monitoring takes one period per period, recording all frames
+	std::unique_ptr<LocklessRingBufferReader<sampleFrame>> m_inputReader;
+	std::unique_ptr<LocklessRingBufferReader<sampleFrame>> m_recordReader;
+	sampleFrame * m_inputBuffer;
+	sampleFrame * m_recordBuffer;
+	f_cnt_t m_inputBufferFrames;
+	// largest block the device captured at once
+	std::atomic<f_cnt_t> m_inputBlockFrames;
+	std::atomic<int> m_inputOverruns;
 
 	surroundSampleFrame * m_outputBufferRead;
 	surroundSampleFrame * m_outputBufferWrite;
@@ -431,6 +482,7 @@ private:
 	fifoWriter * m_fifoWriter;
 
 	AudioEngineProfiler m_profiler;
+	VoiceLimiter m_voiceLimiter;
 
 	bool m_metronomeActive;
 
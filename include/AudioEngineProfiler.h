@@ -48,12 +48,19 @@ public:
 		return m_cpuLoad;
 	}
 
+	//! Load of the last period in percent, without smoothing
+	float periodLoad() const
+	{
+		return m_periodLoad;
+	}
+
 	void setOutputFile( const QString& outputFile );
 
 
 private:
 	MicroTimer m_periodTimer;
 	int m_cpuLoad;
+	float m_periodLoad;
 	QFile m_outputFile;
 };
 
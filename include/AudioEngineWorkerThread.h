@@ -29,6 +29,8 @@
 
 #include <atomic>
 
+#include "lmms_basics.h"
+
 class AudioEngine;
 class QWaitCondition;
 class ThreadableJob;
@@ -104,6 +106,20 @@ public:
 
 	static void startAndWaitForJobs();
 
+	// number of threads processing jobs, including the inline one
+	static int slotCount()
+	{
+		return qMax( workerThreads.size(), 1 );
+	}
+
+	// index of the calling thread in [0, slotCount()) - the thread processing
+	// jobs inline (the audio engine thread) gets the last one
+	static int currentSlot();
+
+	// period buffer owned by the calling thread, e.g. for rendering voices
+	// before they are accumulated
+	static sampleFrame * scratchBuffer();
+
 
 private:
 	void run() override;
@@ -113,6 +129,7 @@ private:
 	static QList<AudioEngineWorkerThread *> workerThreads;
 
 	volatile bool m_quit;
+	sampleFrame * m_scratchBuffer;
 } ;
 
 
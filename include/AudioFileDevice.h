@@ -47,6 +47,21 @@ public:
 
 	OutputSettings const & getOutputSettings() const { return m_outputSettings; }
 
+	//! Fetch the next period from the audio engine, resampled to the
+	//! output sample rate, and return its number of frames
+	fpp_t fetchBuffer( surroundSampleFrame * _ab )
+	{
+		return getNextBuffer( _ab );
+	}
+
+	//! Encode the given frames - unlike fetchBuffer(), this may be called
+	//! from a thread other than the rendering one
+	void encodeBuffer( const surroundSampleFrame * _ab,
+				const fpp_t _frames, const float _master_gain )
+	{
+		writeBuffer( _ab, _frames, _master_gain );
+	}
+
 
 protected:
 	int writeData( const void* data, int len );
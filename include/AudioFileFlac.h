@@ -29,6 +29,7 @@
 
 #include "AudioFileDevice.h"
 #include <sndfile.h>
+#include <vector>
 
 class AudioFileFlac: public AudioFileDevice
 {
@@ -62,6 +63,10 @@ private:
 	SF_INFO  m_sfinfo;
 	SNDFILE* m_sf;
 
+	//! conversion buffers, only growing
+	std::vector<sample_t> m_floatBuffer;
+	std::vector<int_sample_t> m_intBuffer;
+
 	virtual void writeBuffer(surroundSampleFrame const* _ab,
 						fpp_t const frames,
 						float master_gain) override;
@@ -34,6 +34,8 @@
 
 #include "lame/lame.h"
 
+#include <vector>
+
 
 class AudioFileMP3 : public AudioFileDevice
 {
@@ -67,6 +69,10 @@ private:
 
 private:
 	lame_t m_lame;
+
+	//! interleaved input and encoder output, only growing
+	std::vector<float> m_interleavedBuffer;
+	std::vector<unsigned char> m_encodingBuffer;
 };
 
 #endif
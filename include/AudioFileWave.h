@@ -30,6 +30,7 @@
 #include "AudioFileDevice.h"
 
 #include <sndfile.h>
+#include <vector>
 
 
 class AudioFileWave : public AudioFileDevice
@@ -64,6 +65,10 @@ private:
 private:
 	SF_INFO m_si;
 	SNDFILE * m_sf;
+
+	//! conversion buffers, only growing
+	std::vector<float> m_floatBuffer;
+	std::vector<int_sample_t> m_intBuffer;
 } ;
 
 #endif
@@ -35,16 +35,20 @@
 #endif
 
 #include <atomic>
+#include <vector>
 #include <QtCore/QVector>
 #include <QtCore/QList>
 #include <QtCore/QMap>
+#include <QtCore/QString>
 
 #include "AudioDevice.h"
 #include "AudioDeviceSetupWidget.h"
 
 class QLineEdit;
 class LcdSpinBox;
+class LedCheckBox;
 class MidiJack;
+class MixerChannel;
 
 
 class AudioJack : public QObject, public AudioDevice
@@ -79,12 +83,18 @@ public:
 	private:
 		QLineEdit * m_clientName;
 		LcdSpinBox * m_channels;
+		LedCheckBox * m_mixerOutputs;
 
 	} ;
 
 
 private slots:
 	void restartAfterZombified();
+	//! Register or unregister outputs to match the mixer channels
+	void updateMixerOutputs();
+	//! Delete the replaced lists no thread uses anymore, retry later if
+	//! there are some left
+	void freeRetiredMixerOutputs();
 
 
 private:
@@ -98,6 +108,9 @@ private:
 	virtual void unregisterPort( AudioPort * _port );
 	virtual void renamePort( AudioPort * _port );
 
+	void processMixerChannels( Mixer * _mixer ) override;
+	void nextMixerPeriod();
+
 	int processCallback( jack_nframes_t _nframes, void * _udata );
 
 	static int staticProcessCallback( jack_nframes_t _nframes,
@@ -113,11 +126,67 @@ private:
 	std::atomic<MidiJack *> m_midiClient;
 	QVector<jack_port_t *> m_outputPorts;
 	jack_default_audio_sample_t * * m_tempOutBufs;
-	surroundSampleFrame * m_outBuf;
+	// current period of the audio engine, not copied
+	const surroundSampleFrame * m_outBuf;
 
 	f_cnt_t m_framesDoneInCurBuf;
 	f_cnt_t m_framesToDoInCurBuf;
 
+	// Outputs of the mixer channels except master. The rendering thread
+	// stores each period in a ring, ahead of the master output by the
+	// FIFO of the audio engine, and the process callback plays the
+	// period rendered together with the current master buffer.
+	static const int MixerOutputPeriods = 32;
+	struct MixerOutput
+	{
+		// only compared, as the channel may have been deleted already
+		const MixerChannel * channel;
+		QString name;
+		jack_port_t * ports[DEFAULT_CHANNELS];
+		jack_default_audio_sample_t * buffers[DEFAULT_CHANNELS];
+		// process cycle the buffers belong to
+		unsigned int cycle;
+		std::vector<sampleFrame> periods;
+	} ;
+	typedef std::vector<MixerOutput *> MixerOutputList;
+
+	// a replaced list and the outputs which are not in the new one
+	struct RetiredMixerOutputs
+	{
+		MixerOutputList * list;
+		MixerOutputList removed;
+		// false if the ports went away with the client
+		bool unregister;
+	} ;
+
+	//! Make @p outputs the current outputs. The previous list and
+	//! @p removed are deleted once no thread uses them anymore.
+	void publishMixerOutputs( MixerOutputList * outputs,
+				const MixerOutputList & removed, bool unregister = true );
+	//! Return the current outputs and mark them as used in @p inUse
+	MixerOutputList * acquireMixerOutputs(
+				std::atomic<MixerOutputList *> & inUse );
+	//! Write frames [@p done, @p done + @p todo) of the outputs in the
+	//! process callback, silence if @p silent or there's no period for
+	//! m_outBuf
+	void writeMixerOutputs( jack_nframes_t nframes, jack_nframes_t done,
+				jack_nframes_t todo, float gain, bool silent );
+
+	bool m_mixerOutputsEnabled;
+	// The list is replaced as a whole, in index order of the channels, so
+	// neither the process callback nor the rendering thread ever waits
+	// for the GUI thread or sees a list being changed
+	std::atomic<MixerOutputList *> m_mixerOutputs;
+	std::atomic<MixerOutputList *> m_mixerOutputsProcessing;
+	std::atomic<MixerOutputList *> m_mixerOutputsRendering;
+	// only accessed by the GUI thread, oldest first
+	std::vector<RetiredMixerOutputs> m_retiredMixerOutputs;
+	std::atomic<unsigned int> m_processCycle;
+	std::atomic<int> m_mixerPeriodsWritten;
+	int m_mixerPeriodsRead;
+	// period in the ring belonging to m_outBuf, -1 if there is none
+	int m_curMixerPeriod;
+
 
 #ifdef AUDIO_PORT_SUPPORT
 	struct StereoPort
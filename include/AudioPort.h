@@ -25,7 +25,9 @@
 #ifndef AUDIO_PORT_H
 #define AUDIO_PORT_H
 
+#include <atomic>
 #include <memory>
+#include <vector>
 #include <QtCore/QString>
 #include <QtCore/QMutex>
 #include <QtCore/QMutexLocker>
@@ -43,7 +45,7 @@ class AudioPort : public ThreadableJob
 public:
 	AudioPort( const QString & _name, bool _has_effect_chain = true,
 		FloatModel * volumeModel = nullptr, FloatModel * panningModel = nullptr,
-		BoolModel * mutedModel = nullptr );
+		BoolModel * mutedModel = nullptr, BoolModel * monitorModel = nullptr );
 	virtual ~AudioPort();
 
 	inline sampleFrame * buffer()
@@ -97,6 +99,19 @@ public:
 	void setName( const QString & _new_name );
 
 
+	//! Latency of what is rendered into this port, e.g. by a pipelined
+	//! remote plugin. The output of all ports is delayed to the highest one,
+	//! but by at most MaxCompensatedPeriods periods. May be called from any
+	//! thread.
+	void setLatency( f_cnt_t latency )
+	{
+		m_latency = latency;
+	}
+
+	//! The latency set plus the one of the effects
+	f_cnt_t latency() const;
+
+
 	bool processEffects();
 
 	// ThreadableJob stuff
@@ -109,9 +124,30 @@ public:
 	void addPlayHandle( PlayHandle * handle );
 	void removePlayHandle( PlayHandle * handle );
 
+	// mix a rendered voice into the accumulator of the calling worker
+	// thread - all accumulators are summed up once in doProcessing()
+	void accumulate( const sampleFrame * buf );
+
 private:
+	//! Delay the port buffer by the latency other ports have more, returns
+	//! whether there's something to be mixed
+	bool compensateLatency( bool hasOutput, fpp_t fpp );
+
+	// size of the delay line, which is allocated once so that latency
+	// changes don't allocate while rendering
+	static constexpr f_cnt_t MaxCompensatedPeriods = 4;
+
+	struct Accumulator
+	{
+		sampleFrame * buffer;
+		bool used;
+	} ;
+
 	volatile bool m_bufferUsage;
 
+	// one per worker thread, so voices can be mixed without locking
+	std::vector<Accumulator> m_accumulators;
+
 	sampleFrame * m_portBuffer;
 	QMutex m_portBufferLock;
 
@@ -128,6 +164,16 @@ private:
 	FloatModel * m_volumeModel;
 	FloatModel * m_panningModel;
 	BoolModel * m_mutedModel;
+	// if set and enabled, the audio input is mixed in before the effects
+	BoolModel * m_monitorModel;
+
+	std::atomic<f_cnt_t> m_latency;
+	std::vector<sampleFrame> m_delayBuffer;
+	// frames of m_delayBuffer in use
+	f_cnt_t m_delay;
+	f_cnt_t m_delayPosition;
+	// frames of sound which are still in the delay buffer
+	f_cnt_t m_delayedFrames;
 
 	friend class AudioEngine;
 	friend class AudioEngineWorkerThread;
@@ -88,6 +88,7 @@ private:
 	volatile bool m_quit;
 
 	bool m_convertEndian;
+	int_sample_t * m_pcmBuffer;
 
 	bool m_connected;
 	QSemaphore m_connectedSemaphore;
@@ -37,6 +37,7 @@
 #endif
 
 #include <math.h>
+#include <type_traits>
 
 #include "lmms_basics.h"
 #include "lmms_constants.h"
@@ -329,8 +330,60 @@ public:
 
 	inline sample_t update( sample_t _in0, ch_cnt_t _chnl )
 	{
-		sample_t out;
+		return dispatch( [this, _in0, _chnl]( auto type )
+		{
+			return updateAs<decltype( type )::value>( _in0, _chnl );
+		} );
+	}
+
+	//! Call @p func with the current filter type as std::integral_constant,
+	//! so that it is only switched on once per call instead of per sample
+	template<typename F>
+	inline auto dispatch( F && func )
+	{
 		switch( m_type )
+		{
+			case Moog:
+				return func( std::integral_constant<FilterTypes, Moog>() );
+			case Tripole:
+				return func( std::integral_constant<FilterTypes, Tripole>() );
+			case Lowpass_SV:
+				return func( std::integral_constant<FilterTypes, Lowpass_SV>() );
+			case Bandpass_SV:
+				return func( std::integral_constant<FilterTypes, Bandpass_SV>() );
+			case Highpass_SV:
+				return func( std::integral_constant<FilterTypes, Highpass_SV>() );
+			case Notch_SV:
+				return func( std::integral_constant<FilterTypes, Notch_SV>() );
+			case Lowpass_RC12:
+				return func( std::integral_constant<FilterTypes, Lowpass_RC12>() );
+			case Bandpass_RC12:
+				return func( std::integral_constant<FilterTypes, Bandpass_RC12>() );
+			case Highpass_RC12:
+				return func( std::integral_constant<FilterTypes, Highpass_RC12>() );
+			case Lowpass_RC24:
+				return func( std::integral_constant<FilterTypes, Lowpass_RC24>() );
+			case Bandpass_RC24:
+				return func( std::integral_constant<FilterTypes, Bandpass_RC24>() );
+			case Highpass_RC24:
+				return func( std::integral_constant<FilterTypes, Highpass_RC24>() );
+			case Formantfilter:
+				return func( std::integral_constant<FilterTypes, Formantfilter>() );
+			case FastFormant:
+				return func( std::integral_constant<FilterTypes, FastFormant>() );
+			default:
+				// all biquad types share the same code
+				return func( std::integral_constant<FilterTypes, LowPass>() );
+		}
+	}
+
+	//! Filter one sample with the filter type fixed at compile time - use
+	//! dispatch() to call this from loops without switching per sample
+	template<FilterTypes Type>
+	inline sample_t updateAs( sample_t _in0, ch_cnt_t _chnl )
+	{
+		sample_t out;
+		switch( Type )
 		{
 			case Moog:
 			{
@@ -419,7 +472,7 @@ public:
 				}
 
 				/* mix filter output into output buffer */
-				return m_type == Lowpass_SV 
+				return Type == Lowpass_SV 
 					? m_delay4[_chnl]
 					: m_delay3[_chnl];
 			}
@@ -506,7 +559,7 @@ public:
 					m_rchp0[_chnl] = hp;
 					m_rcbp0[_chnl] = bp;
 				}
-				return m_type == Highpass_RC12 ? hp : bp;
+				return Type == Highpass_RC12 ? hp : bp;
 			}
 
 			case Lowpass_RC24:
@@ -573,7 +626,7 @@ public:
 					m_rcbp0[_chnl] = bp;
 
 					// second stage gets the output of the first stage as input...
-					in = m_type == Highpass_RC24
+					in = Type == Highpass_RC24
 						? hp + m_rcbp1[_chnl] * m_rcq
 						: bp + m_rcbp1[_chnl] * m_rcq;
 
@@ -589,7 +642,7 @@ public:
 					m_rchp1[_chnl] = hp;
 					m_rcbp1[_chnl] = bp;
 				}
-				return m_type == Highpass_RC24 ? hp : bp;
+				return Type == Highpass_RC24 ? hp : bp;
 			}
 
 			case Formantfilter:
@@ -599,7 +652,7 @@ public:
 				sample_t hp, bp, in;
 
 				out = 0;
-				const int os = m_type == FastFormant ? 1 : 4; // no oversampling for fast formant
+				const int os = Type == FastFormant ? 1 : 4; // no oversampling for fast formant
 				for( int o = 0; o < os; ++o )
 				{
 					// first formant
@@ -686,7 +739,7 @@ public:
 
 					out += bp;
 				}
-            	return m_type == FastFormant ? out * 2.0f : out * 0.5f;
+            	return Type == FastFormant ? out * 2.0f : out * 0.5f;
 			}
 
 			default:
@@ -696,7 +749,7 @@ public:
 
 		if( m_doubleFilter )
 		{
-			return m_subFilter->update( out, _chnl );
+			return m_subFilter->template updateAs<Type>( out, _chnl );
 		}
 
 		// Clipper band limited sigmoid
@@ -0,0 +1,113 @@
+/*
+ * BatchRenderer.h - renders a list of projects with a single engine
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef BATCH_RENDERER_H
+#define BATCH_RENDERER_H
+
+#include <memory>
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QStringList>
+#include <QVector>
+
+#include "ProjectRenderer.h"
+#include "OutputSettings.h"
+
+class QTemporaryDir;
+class RenderManager;
+
+
+/**
+	Renders the projects of a job list one after another
+
+	The job list has one job per line, the project file optionally followed
+	by a tab and the output file. Empty lines and lines starting with '#'
+	are ignored. Without an output file, the output is written next to the
+	project, like for the "render" command.
+
+	The engine is initialized only once for all jobs. With more than one
+	worker, the jobs are split among child processes instead, each of them
+	running "render-batch" on its share of the list.
+*/
+class BatchRenderer : public QObject
+{
+	Q_OBJECT
+public:
+	struct Job
+	{
+		QString project;
+		QString output;
+	} ;
+
+	BatchRenderer( const AudioEngine::qualitySettings & qualitySettings,
+			const OutputSettings & outputSettings,
+			ProjectRenderer::ExportFileFormats fmt,
+			bool loop );
+	~BatchRenderer() override;
+
+	//! Read the jobs from @p jobList, return false if it can't be read
+	bool loadJobList( const QString & jobList );
+
+	//! Render all jobs in this process, the engine must be initialized
+	void start();
+	//! Split the jobs among @p workers child processes, started with
+	//! @p arguments with the job list replaced by their share of it
+	void startWorkers( int workers, const QStringList & arguments,
+				int jobListArgument );
+
+	//! Number of jobs which could not be rendered
+	int failedJobs() const
+	{
+		return m_failed;
+	}
+
+signals:
+	void finished();
+
+private slots:
+	void renderNextJob();
+	void jobFinished();
+	void workerFinished( int exitCode, QProcess::ExitStatus exitStatus );
+
+private:
+	//! Peak resident memory in KiB, of the current job if supported
+	static long peakMemory();
+	static void resetPeakMemory();
+
+	const AudioEngine::qualitySettings m_qualitySettings;
+	const OutputSettings m_outputSettings;
+	ProjectRenderer::ExportFileFormats m_format;
+	bool m_loop;
+
+	QVector<Job> m_jobs;
+	int m_nextJob;
+	int m_failed;
+
+	std::unique_ptr<RenderManager> m_renderManager;
+	QElapsedTimer m_jobTimer;
+
+	std::unique_ptr<QTemporaryDir> m_workerDir;
+	QVector<QProcess *> m_workers;
+	int m_runningWorkers;
+} ;
+
+#endif
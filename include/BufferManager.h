@@ -29,11 +29,18 @@
 #include "lmms_export.h"
 #include "lmms_basics.h"
 
+//! One period as a separate array per channel, as plugin hosts need it
+struct PlanarBuffer
+{
+	sample_t * channels[DEFAULT_CHANNELS];
+};
+
 class LMMS_EXPORT BufferManager
 {
 public:
 	static void init( fpp_t framesPerPeriod );
 	static sampleFrame * acquire();
+	static PlanarBuffer acquirePlanar();
 	// audio-buffer-mgm
 	static void clear( sampleFrame * ab, const f_cnt_t frames,
 						const f_cnt_t offset = 0 );
@@ -42,6 +49,7 @@ public:
 						const f_cnt_t offset = 0 );
 #endif
 	static void release( sampleFrame * buf );
+	static void release( const PlanarBuffer & buf );
 };
 
 #endif
@@ -74,6 +74,10 @@ public:
 
 	void write( QTextStream& strm );
 	bool writeFile(const QString& fn, bool withResources = false);
+	//! Writes to a temporary file next to fullName and renames it over
+	//! fullName afterwards. Does not interact with the user, so it can be
+	//! called from any thread that exclusively owns this DataFile.
+	bool writeAtomically(const QString& fullName, bool keepBackup);
 	bool copyResources(const QString& resourcesDir); //!< Copies resources to the resourcesDir and changes the DataFile to use local paths to them
 	bool hasLocalPlugins(QDomElement parent = QDomElement(), bool firstCall = true) const;
 
@@ -0,0 +1,65 @@
+/*
+ * DataFileWriter.h - writes DataFiles to disk in a background thread
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef DATA_FILE_WRITER_H
+#define DATA_FILE_WRITER_H
+
+#include <atomic>
+#include <memory>
+
+#include <QtCore/QThread>
+
+#include "DataFile.h"
+#include "lmms_export.h"
+
+
+//! Serializes, compresses and writes a DataFile outside of the GUI thread.
+//! The DataFile is moved into the writer, so the caller can keep editing the
+//! project while the snapshot is written.
+class LMMS_EXPORT DataFileWriter : public QThread
+{
+	Q_OBJECT
+public:
+	DataFileWriter(QObject * parent = nullptr);
+	~DataFileWriter() override;
+
+	//! Starts writing dataFile to fileName. Returns false without taking
+	//! the DataFile if a previous write is still in progress.
+	bool write(std::unique_ptr<DataFile> dataFile, const QString & fileName);
+
+	bool succeeded() const
+	{
+		return m_success;
+	}
+
+private:
+	void run() override;
+
+	std::unique_ptr<DataFile> m_dataFile;
+	QString m_fileName;
+	bool m_keepBackup;
+	std::atomic<bool> m_success;
+} ;
+
+#endif
@@ -26,15 +26,20 @@
 #ifndef EFFECT_H
 #define EFFECT_H
 
+#include <memory>
+#include <vector>
+
 #include "Plugin.h"
 #include "Engine.h"
 #include "AudioEngine.h"
 #include "AutomatableModel.h"
+#include "BufferManager.h"
 #include "TempoSyncKnobModel.h"
 #include "MemoryManager.h"
 
 class EffectChain;
 class EffectControls;
+class Oversampler;
 
 
 class LMMS_EXPORT Effect : public Plugin
@@ -59,6 +64,48 @@ public:
 	virtual bool processAudioBuffer( sampleFrame * _buf,
 						const fpp_t _frames ) = 0;
 
+	//! Run processAudioBuffer(), at a higher rate if oversampling is set
+	bool processOversampled( sampleFrame * _buf, const fpp_t _frames );
+
+	//! Whether the next period can be passed to processPlanarBuffer(),
+	//! asked each period. Not supported with oversampling.
+	virtual bool processesPlanar() const
+	{
+		return false;
+	}
+
+	//! Like processAudioBuffer(), but with one array per channel, so plugin
+	//! hosts can let the plugin work on them directly
+	virtual bool processPlanarBuffer( const PlanarBuffer & _buf,
+						const fpp_t _frames )
+	{
+		return false;
+	}
+
+	//! Effects returning true must use sampleRate() instead of the engine's
+	//! sample rate and must accept oversamplingFactor() times more frames
+	virtual bool supportsOversampling() const
+	{
+		return false;
+	}
+
+	inline int oversamplingFactor() const
+	{
+		return m_oversamplingFactor;
+	}
+
+	//! The rate processAudioBuffer() runs at
+	inline sample_rate_t sampleRate() const
+	{
+		return Engine::audioEngine()->processingSampleRate() * m_oversamplingFactor;
+	}
+
+	//! Frames processOversampled() delays the signal by, also if bypassed
+	inline f_cnt_t latency() const
+	{
+		return static_cast<f_cnt_t>( m_dryDelay.size() );
+	}
+
 	inline ch_cnt_t processorCount() const
 	{
 		return m_processors;
@@ -196,6 +243,10 @@ protected:
 	void reinitSRC();
 
 
+private slots:
+	void updateOversampling();
+
+
 private:
 	EffectChain * m_parent;
 	void resample( int _i, const sampleFrame * _src_buf,
@@ -214,9 +265,17 @@ private:
 	FloatModel m_wetDryModel;
 	FloatModel m_gateModel;
 	TempoSyncKnobModel m_autoQuitModel;
+	//! number of 2x oversampling stages
+	IntModel m_oversamplingModel;
 	
 	bool m_autoQuitDisabled;
 
+	std::unique_ptr<Oversampler> m_oversampler;
+	int m_oversamplingFactor;
+	//! the input delayed by the latency of the oversampler
+	std::vector<sampleFrame> m_dryDelay;
+	f_cnt_t m_dryDelayPosition;
+
 	SRC_DATA m_srcData[2];
 	SRC_STATE * m_srcState[2];
 
@@ -29,6 +29,7 @@
 #include "Model.h"
 #include "SerializingObject.h"
 #include "AutomatableModel.h"
+#include "BufferManager.h"
 
 class Effect;
 
@@ -54,6 +55,10 @@ public:
 	void moveUp( Effect * _effect );
 	bool processAudioBuffer( sampleFrame * _buf, const fpp_t _frames, bool hasInputNoise );
 	void startRunning();
+	//! Whether any effect would still be processed without input
+	bool isRunning() const;
+	//! Frames the effects delay the signal by
+	f_cnt_t latency() const;
 
 	void clear();
 
@@ -64,6 +69,9 @@ private:
 
 	BoolModel m_enabledModel;
 
+	//! the signal while effects which process planar audio run
+	PlanarBuffer m_planarBuffer;
+
 
 	friend class EffectRackView;
 
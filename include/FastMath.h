@@ -0,0 +1,222 @@
+/*
+ * FastMath.h - fast approximations of transcendental functions for DSP code
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <cstdint>
+#include <cstring>
+
+#include "lmms_constants.h"
+
+// Fast replacements for the libm functions in per-sample code. They have no
+// branches, so loops calling them, like the block variants at the end of this
+// file, are vectorized by the compiler. The error bounds are checked by
+// tests/src/core/FastMathTest.cpp, which also benchmarks them.
+
+constexpr float F_LOG2_E = 1.44269504088896340736f;
+constexpr float F_LN_2 = 0.69314718055994530942f;
+//! log2(10) / 20, converts dBFS to a power of 2
+constexpr float F_DBFS_TO_LOG2 = 0.16609640474436811739f;
+//! 20 * log10(2), converts a power of 2 to dBFS
+constexpr float F_LOG2_TO_DBFS = 6.02059991327962390427f;
+
+
+//! largest integer not above @p x, for |x| < 2^31
+static inline int32_t fastFloorToInt( float x )
+{
+	const int32_t i = static_cast<int32_t>( x );
+	return i - ( static_cast<float>( i ) > x ? 1 : 0 );
+}
+
+
+//! @p x limited to [@p lo, @p hi]. The selection is done on the bit patterns,
+//! since GCC doesn't vectorize selecting floats with its default flags.
+static inline float fastClampf( float x, float lo, float hi )
+{
+	int32_t xb, lob, hib;
+	std::memcpy( &xb, &x, sizeof( xb ) );
+	std::memcpy( &lob, &lo, sizeof( lob ) );
+	std::memcpy( &hib, &hi, sizeof( hib ) );
+	const int32_t under = x < lo ? -1 : 0;
+	const int32_t over = x > hi ? -1 : 0;
+	xb = ( xb & ~( under | over ) ) | ( lob & under ) | ( hib & over );
+	std::memcpy( &x, &xb, sizeof( x ) );
+	return x;
+}
+
+
+//! @brief 2^x, with a relative error below 3e-7 (about 2 ulp)
+//! @param x Clamped to [-126, 127], so the result is always a normal number
+static inline float fastExp2f( float x )
+{
+	x = fastClampf( x, -126.0f, 127.0f );
+	// 2^x = 2^i * e^(f * ln 2) with f in [-0.5, 0.5], the offset makes
+	// the truncation round down
+	const int32_t i = static_cast<int32_t>( x + 128.5f ) - 128;
+	const float y = ( x - static_cast<float>( i ) ) * F_LN_2;
+	// Taylor series, the remainder is below y^7 / 7! < 1.2e-7
+	float p = 1.0f / 720.0f;
+	p = p * y + 1.0f / 120.0f;
+	p = p * y + 1.0f / 24.0f;
+	p = p * y + 1.0f / 6.0f;
+	p = p * y + 0.5f;
+	p = p * y + 1.0f;
+	p = p * y + 1.0f;
+
+	const int32_t bits = ( i + 127 ) << 23;
+	float scale;
+	std::memcpy( &scale, &bits, sizeof( scale ) );
+	return p * scale;
+}
+
+
+//! @brief e^x, with a relative error below 3e-7 + 1e-7 * |x|
+//! (the rounding of x * log2(e) dominates for large |x|)
+static inline float fastExpf( float x )
+{
+	return fastExp2f( x * F_LOG2_E );
+}
+
+
+//! @brief log2(x), with an absolute error below 2e-7 * max(1, |log2(x)|)
+//! @param x Must be a positive normal number, 0 and denormals are not handled
+static inline float fastLog2f( float x )
+{
+	int32_t bits;
+	std::memcpy( &bits, &x, sizeof( bits ) );
+	// center the mantissa around 1: m in [sqrt(2) / 2, sqrt(2)], where
+	// 0x3504f3 is the mantissa of sqrt(2)
+	const int32_t high = ( bits & 0x007fffff ) > 0x3504f3 ? 1 : 0;
+	const int32_t e = ( ( bits >> 23 ) & 0xff ) - 127 + high;
+	bits = ( bits & 0x007fffff ) | ( 0x3f800000 - ( high << 23 ) );
+	float m;
+	std::memcpy( &m, &bits, sizeof( m ) );
+
+	// ln(m) = 2 * atanh(s), |s| < 0.172, the remainder is below 3e-8
+	const float s = ( m - 1.0f ) / ( m + 1.0f );
+	const float s2 = s * s;
+	float p = 2.0f / 7.0f;
+	p = p * s2 + 2.0f / 5.0f;
+	p = p * s2 + 2.0f / 3.0f;
+	p = p * s2 + 2.0f;
+	return static_cast<float>( e ) + p * s * F_LOG2_E;
+}
+
+
+//! sin(y) for y in [-pi/2, pi/2], the remainder is below 6e-8
+static inline float fastSinPoly( float y )
+{
+	const float y2 = y * y;
+	float p = -1.0f / 39916800.0f;
+	p = p * y2 + 1.0f / 362880.0f;
+	p = p * y2 - 1.0f / 5040.0f;
+	p = p * y2 + 1.0f / 120.0f;
+	p = p * y2 - 1.0f / 6.0f;
+	p = p * y2 + 1.0f;
+	return p * y;
+}
+
+
+// pi split into a part with few significant bits, so q * pi can be
+// subtracted without rounding for |q| < 2^16
+constexpr float F_PI_HI = 3.140625f;
+constexpr float F_PI_LO = 9.67653589793e-4f;
+
+
+//! @brief sin(x), with an absolute error below 2.5e-7 for |x| < 10^4
+static inline float fastSinf( float x )
+{
+	// sin(x) = (-1)^q * sin(x - q * pi)
+	const int32_t q = fastFloorToInt( x * F_PI_R + 0.5f );
+	const float qf = static_cast<float>( q );
+	const float y = ( x - qf * F_PI_HI ) - qf * F_PI_LO;
+	const float sign = ( q & 1 ) ? -1.0f : 1.0f;
+	return sign * fastSinPoly( y );
+}
+
+
+//! @brief cos(x), with an absolute error below 3e-7 for |x| < 10^4
+static inline float fastCosf( float x )
+{
+	// cos(x) = sin(x + pi/2), without rounding x + pi/2 for large x
+	const int32_t q = fastFloorToInt( x * F_PI_R + 1.0f );
+	const float qf = static_cast<float>( q );
+	const float y = ( ( x - qf * F_PI_HI ) - qf * F_PI_LO ) +
+				( 0.5f * F_PI_HI + 0.5f * F_PI_LO );
+	const float sign = ( q & 1 ) ? -1.0f : 1.0f;
+	return sign * fastSinPoly( y );
+}
+
+
+//! @brief tanh(x), with an absolute error below 3e-7
+static inline float fastTanhf( float x )
+{
+	// beyond 9, tanh(x) rounds to +-1 anyway
+	x = fastClampf( x, -9.0f, 9.0f );
+	const float e = fastExp2f( 2.0f * F_LOG2_E * x );
+	return ( e - 1.0f ) / ( e + 1.0f );
+}
+
+
+//! @brief Same as dbfsToAmp(), with a relative error below 3e-7 + 1e-8 * |dbfs|
+//! @param dbfs Results below about -758 dBFS are clamped
+static inline float fastDbfsToAmp( float dbfs )
+{
+	return fastExp2f( dbfs * F_DBFS_TO_LOG2 );
+}
+
+
+//! @brief Same as ampToDbfs(), with an absolute error below
+//! 2e-7 * max(6, |result|) dB
+//! @param amp Must be a positive normal number
+static inline float fastAmpToDbfs( float amp )
+{
+	return fastLog2f( amp ) * F_LOG2_TO_DBFS;
+}
+
+
+
+
+// Block variants, writing f(in[i]) to out[i]. In-place use is allowed.
+
+#define FAST_MATH_BLOCK( name, func ) \
+static inline void name( const float * in, float * out, int frames ) \
+{ \
+	for( int i = 0; i < frames; ++i ) \
+	{ \
+		out[i] = func( in[i] ); \
+	} \
+}
+
+FAST_MATH_BLOCK( fastExp2fBlock, fastExp2f )
+FAST_MATH_BLOCK( fastExpfBlock, fastExpf )
+FAST_MATH_BLOCK( fastLog2fBlock, fastLog2f )
+FAST_MATH_BLOCK( fastSinfBlock, fastSinf )
+FAST_MATH_BLOCK( fastCosfBlock, fastCosf )
+FAST_MATH_BLOCK( fastTanhfBlock, fastTanhf )
+FAST_MATH_BLOCK( fastDbfsToAmpBlock, fastDbfsToAmp )
+FAST_MATH_BLOCK( fastAmpToDbfsBlock, fastAmpToDbfs )
+
+#undef FAST_MATH_BLOCK
+
+#endif
@@ -26,6 +26,7 @@
 #ifndef INSTRUMENT_H
 #define INSTRUMENT_H
 
+#include <atomic>
 #include <QString>
 #include "lmms_export.h"
 #include "lmms_basics.h"
@@ -51,10 +52,20 @@ public:
 		IsSingleStreamed = 0x01,	/*! Instrument provides a single audio stream for all notes */
 		IsMidiBased = 0x02,			/*! Instrument is controlled by MIDI events rather than NotePlayHandles */
 		IsNotBendable = 0x04,		/*! Instrument can't react to pitch bend changes */
+		NeverSleeps = 0x08,			/*! Instrument may produce sound without notes or events */
 	};
 
 	Q_DECLARE_FLAGS(Flags, Flag);
 
+	//! Number of notes instruments prepare their per-note state for,
+	//! see VoicePool
+	static constexpr int DefaultPolyphony = 32;
+
+	//! Output level below which single streamed instruments count as silent
+	static constexpr float SleepThreshold = 0.00001f;
+	//! Milliseconds of silence without notes before they stop rendering
+	static constexpr int SleepTimeout = 500;
+
 	Instrument(InstrumentTrack * _instrument_track,
 			const Descriptor * _descriptor,
 			const Descriptor::SubPluginFeatures::Key * key = nullptr);
@@ -79,7 +90,7 @@ public:
 
 	// needed for deleting plugin-specific-data of a note - plugin has to
 	// cast void-ptr so that the plugin-data is deleted properly
-	// (call of dtor if it's a class etc.)
+	// (call of dtor if it's a class etc.) or given back to its VoicePool
 	virtual void deleteNotePluginData( NotePlayHandle * _note_to_play );
 
 	// Get number of sample-frames that should be used when playing beat
@@ -130,6 +141,24 @@ public:
 		return m_instrumentTrack;
 	}
 
+	//! Whether play() can be skipped, since the output stayed silent without
+	//! notes and nothing woke the instrument up since then
+	bool isSleeping() const
+	{
+		return m_sleeping && !m_wakeUp;
+	}
+
+	//! Makes a sleeping instrument play again from the next period on, called
+	//! for new notes and MIDI events from any thread
+	void wakeUp()
+	{
+		m_wakeUp = true;
+	}
+
+	//! Lets the instrument sleep once its output @p buf stayed silent for
+	//! SleepTimeout while @p hasNotes was false, called after play()
+	void checkSilence( const sampleFrame * buf, bool hasNotes );
+
 
 protected:
 	// fade in to prevent clicks
@@ -144,6 +173,10 @@ protected:
 private:
 	InstrumentTrack * m_instrumentTrack;
 
+	std::atomic<bool> m_wakeUp;
+	bool m_sleeping;
+	f_cnt_t m_silentFrames;
+
 } ;
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(Instrument::Flags)
@@ -33,6 +33,7 @@
 class ComboBox;
 class GroupBox;
 class InstrumentTrack;
+class LcdSpinBox;
 class LedCheckBox;
 
 
@@ -50,6 +51,10 @@ public:
 
 	LedCheckBox *rangeImportCheckbox() {return m_rangeImportCheckbox;}
 
+	GroupBox *polyphonyGroupBox() {return m_polyphonyGroupBox;}
+	LcdSpinBox *maxVoicesSpinBox() {return m_maxVoicesSpinBox;}
+	ComboBox *voiceStealingCombo() {return m_voiceStealingCombo;}
+
 private:
 	GroupBox *m_pitchGroupBox;
 	GroupBox *m_microtunerGroupBox;
@@ -58,6 +63,10 @@ private:
 	ComboBox *m_keymapCombo;
 
 	LedCheckBox *m_rangeImportCheckbox;
+
+	GroupBox *m_polyphonyGroupBox;
+	LcdSpinBox *m_maxVoicesSpinBox;
+	ComboBox *m_voiceStealingCombo;
 };
 
 #endif
@@ -63,6 +63,8 @@ public:
 		while( nphsLeft );
 		
 		m_instrument->play( _working_buffer );
+
+		m_instrument->checkSilence( _working_buffer, !nphv.isEmpty() );
 	}
 
 	bool isFinished() const override
@@ -70,6 +72,13 @@ public:
 		return false;
 	}
 
+	// a sleeping instrument isn't even queued, so its buffer stays released
+	// and the audio port doesn't mix it
+	bool requiresProcessing() const override
+	{
+		return !m_instrument->isSleeping();
+	}
+
 	bool isFromTrack( const Track* _track ) const override
 	{
 		return m_instrument->isFromTrack( _track );
@@ -212,6 +212,18 @@ public:
 		return &m_mixerChannelModel;
 	}
 
+	//! Maximum number of voices of this track, 0 if not limited
+	int maxVoices() const
+	{
+		return m_limitVoicesModel.value() ? m_maxVoicesModel.value() : 0;
+	}
+
+	//! Policy for choosing the voices to steal, a VoiceLimiter::StealPolicy
+	int voiceStealing() const
+	{
+		return m_voiceStealingModel.value();
+	}
+
 	void setPreviewMode( const bool );
 
 	bool isPreviewMode() const
@@ -283,6 +295,9 @@ private:
 	IntModel m_pitchRangeModel;
 	IntModel m_mixerChannelModel;
 	BoolModel m_useMasterPitchModel;
+	BoolModel m_limitVoicesModel;
+	IntModel m_maxVoicesModel;
+	ComboBoxModel m_voiceStealingModel;
 
 	Instrument * m_instrument;
 	InstrumentSoundShaping m_soundShaping;
@@ -30,6 +30,8 @@
 
 #include <ladspa.h>
 
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonObject>
 #include <QtCore/QMap>
 #include <QtCore/QPair>
 #include <QtCore/QString>
@@ -72,7 +74,10 @@ enum ladspaPluginType
 
 typedef struct ladspaManagerStorage
 {
+	//! null until the library is loaded, see LadspaManager::getDescriptor()
 	LADSPA_Descriptor_Function descriptorFunction;
+	QString file;
+	QString name;
 	uint32_t index;
 	ladspaPluginType type;
 	uint16_t inputChannels;
@@ -329,8 +334,14 @@ public:
 						LADSPA_Handle _instance );
 
 private:
-	void  addPlugins( LADSPA_Descriptor_Function _descriptor_func,
-						const QString & _file );
+	//! Register a plug-in from the data returned by describePlugins()
+	void  addPlugin( const QFileInfo & _file, const QJsonObject & _plugin,
+				LADSPA_Descriptor_Function _descriptor_func );
+	//! Return the cacheable data of all plug-ins of a library
+	QJsonObject  describePlugins(
+				LADSPA_Descriptor_Function _descriptor_func );
+	//! Load the library of @p _description and of all plug-ins sharing it
+	bool  loadLibrary( ladspaManagerDescription * _description );
 	uint16_t  getPluginInputs( const LADSPA_Descriptor * _descriptor );
 	uint16_t  getPluginOutputs( const LADSPA_Descriptor * _descriptor );
 
@@ -50,9 +50,14 @@ public:
 		delete m_allocator;
 	}
 
-	void push( T value )
+	//! Returns false if the list is full and the value was not added
+	bool push( T value )
 	{
 		Element * e = m_allocator->alloc();
+		if( e == nullptr )
+		{
+			return false;
+		}
 		e->value = value;
 		e->next = m_first.load(std::memory_order_relaxed);
 
@@ -62,6 +67,7 @@ public:
 		{
 			// Empty loop (compare_exchange_weak updates e->next)
 		}
+		return true;
 	}
 
 	Element * popList()
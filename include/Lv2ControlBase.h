@@ -31,6 +31,7 @@
 
 #include <lilv/lilv.h>
 
+#include "BufferManager.h"
 #include "DataFile.h"
 #include "LinkedModelGroups.h"
 #include "lmms_export.h"
@@ -115,6 +116,11 @@ protected:
 	void copyBuffersFromLmms(const sampleFrame *buf, fpp_t frames);
 	//! Copy our ports into buffers passed by LMMS
 	void copyBuffersToLmms(sampleFrame *buf, fpp_t frames) const;
+	//! Whether run() can work in place on the channels of a PlanarBuffer
+	bool canProcessPlanar() const { return m_planar; }
+	//! Connect our audio ports to the channels of @p buf, so run() works on
+	//! them without copying. copyBuffersFromLmms() connects them back.
+	void connectPlanarBuffer(const PlanarBuffer &buf);
 	//! Run the Lv2 plugin instance for @param frames frames
 	void run(fpp_t frames);
 
@@ -142,14 +148,22 @@ private:
 	//! Inform the plugin about a file name change
 	virtual void setNameFromFile(const QString &fname) = 0;
 
+	//! Directory for the state files of processor @p idx, next to the
+	//! project file @p project
+	QString stateDirectory(const QString& project, std::size_t idx) const;
+
 	//! Independent processors
 	//! If this is a mono effect, the vector will have size 2 in order to
 	//! fulfill LMMS' requirement of having stereo input and output
 	std::vector<std::unique_ptr<Lv2Proc>> m_procs;
 
+	//! Name of the state directory, shared by all processors
+	QString m_stateDirName;
+
 	bool m_valid = true;
 	bool m_hasGUI = false;
 	unsigned m_channelsPerProc;
+	bool m_planar = false;
 
 	const LilvPlugin* m_plugin;
 };
@@ -123,6 +123,7 @@ public:
 		bool operator()(char const *a, char const *b) const;
 	};
 
+	LilvWorld* world() { return m_world; }
 	UridMap& uridMap() { return m_uridMap; }
 	const Lv2UridCache& uridCache() const { return m_uridCache; }
 	const std::set<const char*, CmpStr>& supportedFeatureURIs() const
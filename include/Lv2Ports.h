@@ -188,6 +188,12 @@ struct Audio : public VisitablePort<Audio, PortBase>
 	//! @param channel channel index into each sample frame
 	void copyBuffersToCore(sampleFrame *lmmsBuf,
 		unsigned channel, fpp_t frames) const;
+	//! Copy both channels of a buffer passed by LMMS into two ports at once
+	static void copyStereoBuffersFromCore(Audio& left, Audio& right,
+		const sampleFrame *lmmsBuf, fpp_t frames);
+	//! Copy two ports into both channels of a buffer passed by LMMS at once
+	static void copyStereoBuffersToCore(sampleFrame *lmmsBuf,
+		const Audio& left, const Audio& right, fpp_t frames);
 
 	bool isSideChain() const { return m_sidechain; }
 	bool isOptional() const { return m_optional; }
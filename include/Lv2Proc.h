@@ -33,6 +33,7 @@
 #include <memory>
 #include <QObject>
 
+#include "BufferManager.h"
 #include "Lv2Basics.h"
 #include "Lv2Features.h"
 #include "Lv2Options.h"
@@ -55,6 +56,8 @@ namespace Lv2Ports
 	enum class Vis;
 }
 
+class Lv2Worker;
+
 
 //! Class representing one Lv2 processor, i.e. one Lv2 handle
 //! For Mono effects, 1 Lv2ControlBase references 2 Lv2Proc
@@ -141,12 +144,36 @@ public:
 	 */
 	void copyBuffersToCore(sampleFrame *buf, unsigned firstChan, unsigned num,
 								fpp_t frames) const;
+	//! Whether the audio ports can be connected to @p num channels of a
+	//! PlanarBuffer, so run() works on them in place
+	bool canConnectChannels(unsigned num) const;
+	/**
+	 * Connect the audio ports to channels of a buffer, realtime safe
+	 * @param buf the buffer, or null to connect the ports back to their
+	 *   own buffers, which copyBuffersFromCore() fills
+	 * @param firstChan The channel of @p buf for our first input and output
+	 * @param num Number of channels we process
+	 */
+	void connectChannels(const PlanarBuffer *buf, unsigned firstChan,
+								unsigned num);
 	//! Run the Lv2 plugin instance for @param frames frames
 	void run(fpp_t frames);
 
 	void handleMidiInputEvent(const class MidiEvent &event,
 		const TimePos &time, f_cnt_t offset);
 
+	/*
+		state
+	*/
+	//! Return the plugin's state as a string, or an empty string if the
+	//! plugin does not implement the Lv2 state extension. If @p dir is
+	//! given, files of the state are saved there, relative to each other.
+	QString saveState(const QString& dir = QString());
+	//! Restore a state from saveState(), from the files in @p dir if there
+	//! are any. Plugins supporting state:threadSafeRestore are restored
+	//! while the engine keeps running.
+	void restoreState(const QString& state, const QString& dir = QString());
+
 	/*
 		misc
 	 */
@@ -170,11 +197,17 @@ private:
 	LilvInstance* m_instance;
 	Lv2Features m_features;
 	Lv2Options m_options;
+	//! worker for work scheduled from run(), null if the plugin has no worker
+	std::unique_ptr<Lv2Worker> m_worker;
+	//! synchronous worker for work scheduled from restore()
+	std::unique_ptr<Lv2Worker> m_stateWorker;
 
 	// full list of ports
 	std::vector<std::unique_ptr<Lv2Ports::PortBase>> m_ports;
 	// quick reference to specific, unique ports
 	StereoPortRef m_inPorts, m_outPorts;
+	//! first channel the audio ports are connected to, or null
+	const sample_t* m_connectedChannel = nullptr;
 	Lv2Ports::AtomSeq *m_midiIn = nullptr, *m_midiOut = nullptr;
 
 	// MIDI
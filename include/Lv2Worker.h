@@ -0,0 +1,121 @@
+/*
+ * Lv2Worker.h - Lv2Worker class
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LV2WORKER_H
+#define LV2WORKER_H
+
+#include "lmmsconfig.h"
+
+#ifdef LMMS_HAVE_LV2
+
+#include <atomic>
+#include <lv2.h>
+#include <lv2/lv2plug.in/ns/ext/worker/worker.h>
+#include <memory>
+#include <vector>
+#include <QSemaphore>
+#include <QThread>
+
+#include "../src/3rdparty/ringbuffer/include/ringbuffer/ringbuffer.h"
+
+
+/**
+	Implementation of the Lv2 Worker extension
+
+	The plugin schedules work from its audio thread (or from restore()). In
+	threaded mode, the requests travel through a lock-free ringbuffer to a
+	non-RT thread which calls the plugin's work() function. In non-threaded
+	mode, work() is called immediately (used while restoring state).
+	Responses always travel through a second ringbuffer and are delivered to
+	the plugin by emitResponses(), which must be called from the audio thread
+	after each run().
+*/
+class Lv2Worker
+{
+public:
+	Lv2Worker(bool threaded);
+	~Lv2Worker();
+
+	//! Must be called after instantiation, before the first run()
+	void setHandle(LV2_Handle handle, const LV2_Worker_Interface* iface);
+	//! Stop the worker thread, finishing the current work
+	void stop();
+
+	//! Return the data of the LV2_WORKER__schedule feature
+	LV2_Worker_Schedule* feature() { return &m_scheduleFeature; }
+
+	//! Deliver pending responses to the plugin (audio thread)
+	void emitResponses();
+	//! Call the plugin's end_run(), if any (audio thread)
+	void endRun();
+
+private:
+	class WorkerThread : public QThread
+	{
+	public:
+		WorkerThread(Lv2Worker* worker) : m_worker(worker) {}
+	private:
+		void run() override { m_worker->workerFunc(); }
+		Lv2Worker* m_worker;
+	};
+
+	static LV2_Worker_Status staticScheduleWork(
+		LV2_Worker_Schedule_Handle handle, uint32_t size, const void* data);
+	static LV2_Worker_Status staticRespond(
+		LV2_Worker_Respond_Handle handle, uint32_t size, const void* data);
+	LV2_Worker_Status scheduleWork(uint32_t size, const void* data);
+	LV2_Worker_Status respond(uint32_t size, const void* data);
+
+	//! Write a size-prefixed message with one single ringbuffer write
+	static bool writeMessage(ringbuffer_t<char>& ring,
+		std::vector<char>& stage, uint32_t size, const void* data);
+	//! Read one size-prefixed message into @p dest, return its size
+	static uint32_t readMessage(ringbuffer_reader_t<char>& reader,
+		std::vector<char>& dest);
+
+	void workerFunc();
+
+	static constexpr std::size_t m_ringSize = 1 << 12;
+
+	const LV2_Worker_Interface* m_iface = nullptr;
+	LV2_Handle m_handle = nullptr;
+	LV2_Worker_Schedule m_scheduleFeature;
+	const bool m_threaded;
+
+	//! requests: written by the audio thread, read by the worker thread
+	ringbuffer_t<char> m_requests;
+	ringbuffer_reader_t<char> m_requestsReader;
+	//! responses: written by the worker thread, read by the audio thread
+	ringbuffer_t<char> m_responses;
+	ringbuffer_reader_t<char> m_responsesReader;
+
+	//! preallocated message buffers, one per accessing thread
+	std::vector<char> m_requestStage, m_responseStage;
+	std::vector<char> m_requestData, m_responseData;
+
+	QSemaphore m_sem;
+	std::atomic<bool> m_exit;
+	std::unique_ptr<WorkerThread> m_thread;
+};
+
+#endif // LMMS_HAVE_LV2
+#endif // LV2WORKER_H
@@ -25,12 +25,15 @@
 #ifndef MAIN_WINDOW_H
 #define MAIN_WINDOW_H
 
+#include <atomic>
+
 #include <QtCore/QBasicTimer>
 #include <QtCore/QTimer>
 #include <QtCore/QList>
 #include <QMainWindow>
 
 #include "ConfigManager.h"
+#include "DataFileWriter.h"
 #include "SubWindow.h"
 
 class QAction;
@@ -219,6 +222,12 @@ private:
 	QBasicTimer m_updateTimer;
 	QTimer m_autoSaveTimer;
 	int m_autoSaveInterval;
+	DataFileWriter m_autoSaveWriter;
+	//! modification count of the last auto-save written, updated by the
+	//! writer thread once the file is on disk
+	std::atomic<unsigned int> m_autoSaveModificationCount;
+	//! modification count of the auto-save being written
+	unsigned int m_autoSavePendingCount;
 
 	friend class GuiApplication;
 
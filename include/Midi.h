@@ -25,9 +25,15 @@
 #ifndef MIDI_H
 #define MIDI_H
 
+#include <chrono>
+
 #include "lmms_basics.h"
 
 
+//! Clock used for timestamping incoming MIDI events
+using MidiClock = std::chrono::steady_clock;
+
+
 enum MidiEventTypes
 {
 	// messages
@@ -131,8 +131,10 @@ public:
 
 
 protected:
-	// generic raw-MIDI-parser which generates appropriate MIDI-events
-	void parseData( const unsigned char c );
+	// generic raw-MIDI-parser which generates appropriate MIDI-events,
+	// timestamp is the time the byte was received at
+	void parseData( const unsigned char c,
+			MidiClock::time_point timestamp = MidiClock::now() );
 
 	// to be implemented by actual client-implementation
 	virtual void sendByte( const unsigned char c ) = 0;
@@ -163,6 +165,8 @@ private:
 		uint32_t m_buffer[RAW_MIDI_PARSE_BUF_SIZE];
 					// buffer for incoming data
 		MidiEvent m_midiEvent;	// midi-event
+		MidiClock::time_point m_timestamp;
+					// time the last byte was received
 	} m_midiParseData;
 
 } ;
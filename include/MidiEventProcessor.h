@@ -46,6 +46,13 @@ public:
 	virtual void processInEvent( const MidiEvent& event, const TimePos& time = TimePos(), f_cnt_t offset = 0 ) = 0;
 	virtual void processOutEvent( const MidiEvent& event, const TimePos& time = TimePos(), f_cnt_t offset = 0 ) = 0;
 
+	// called by MidiPort on the thread of the MIDI client before an input
+	// event is queued for processInEvent(), the only place where the
+	// source port of the event is still valid
+	virtual void inEventReceived( const MidiEvent& event )
+	{
+	}
+
 } ;
 
 #endif
@@ -31,12 +31,13 @@
 #include <QtCore/QMap>
 
 #include "Midi.h"
+#include "MidiEvent.h"
 #include "TimePos.h"
 #include "AutomatableModel.h"
+#include "LocklessList.h"
 
 
 class MidiClient;
-class MidiEvent;
 class MidiEventProcessor;
 class MidiPortMenu;
 
@@ -102,9 +103,19 @@ public:
 		return outputChannel() ? outputChannel() - 1 : 0;
 	}
 
-	void processInEvent( const MidiEvent& event, const TimePos& time = TimePos() );
+	// called by MIDI clients from their own threads - the event is only
+	// queued here and handed to the event processor by the audio thread
+	void processInEvent( const MidiEvent& event, const TimePos& time = TimePos(),
+				MidiClock::time_point timestamp = MidiClock::now() );
 	void processOutEvent( const MidiEvent& event, const TimePos& time = TimePos() );
 
+	// called by the audio thread at the start of each period - queued events
+	// are spread over the period according to their timestamps relative to
+	// the previous period, so live input gets a constant latency of one
+	// period instead of jittering with the scheduling of the MIDI thread
+	void processQueuedInEvents( MidiClock::time_point lastPeriodStart,
+				MidiClock::time_point periodStart, fpp_t frames );
+
 
 	void saveSettings( QDomDocument& doc, QDomElement& thisElement ) override;
 	void loadSettings( const QDomElement& thisElement ) override;
@@ -164,6 +175,14 @@ private:
 	Map m_readablePorts;
 	Map m_writablePorts;
 
+	struct QueuedInEvent
+	{
+		MidiEvent event;
+		TimePos time;
+		MidiClock::time_point timestamp;
+	} ;
+	LocklessList<QueuedInEvent> m_inEventQueue;
+
 
 	friend class ControllerConnectionDialog;
 	friend class InstrumentMidiIOView;
@@ -26,6 +26,7 @@
 #define MIX_HELPERS_H
 
 #include "lmms_basics.h"
+#include "lmms_export.h"
 
 class ValueBuffer;
 namespace MixHelpers
@@ -39,6 +40,8 @@ void setNaNHandler( bool use );
 
 bool sanitize( sampleFrame * src, int frames );
 
+bool sanitize( sample_t * src, int frames );
+
 /*! \brief Add samples from src to dst */
 void add( sampleFrame* dst, const sampleFrame* src, int frames );
 
@@ -71,7 +74,22 @@ void addMultipliedStereo( sampleFrame* dst, const sampleFrame* src, float coeffS
 void multiplyAndAddMultiplied( sampleFrame* dst, const sampleFrame* src, float coeffDst, float coeffSrc, int frames );
 
 /*! \brief Multiply dst by coeffDst and add samples from srcLeft/srcRight multiplied by coeffSrc */
-void multiplyAndAddMultipliedJoined( sampleFrame* dst, const sample_t* srcLeft, const sample_t* srcRight, float coeffDst, float coeffSrc, int frames );
+LMMS_EXPORT void multiplyAndAddMultipliedJoined( sampleFrame* dst, const sample_t* srcLeft, const sample_t* srcRight, float coeffDst, float coeffSrc, int frames );
+
+/*! \brief Multiply channel of dst by coeffDst and add planar samples from src multiplied by coeffSrc */
+LMMS_EXPORT void multiplyAndAddMultipliedChannel( sampleFrame* dst, const sample_t* src, int channel, float coeffDst, float coeffSrc, int frames );
+
+/*! \brief Copy channel of src into the planar buffer dst */
+LMMS_EXPORT void deinterleave( sample_t* dst, const sampleFrame* src, int channel, int frames );
+
+/*! \brief Copy both channels of src into the planar buffers dstLeft and dstRight */
+LMMS_EXPORT void deinterleave( sample_t* dstLeft, sample_t* dstRight, const sampleFrame* src, int frames );
+
+/*! \brief Copy the planar buffer src into channel of dst */
+LMMS_EXPORT void interleave( sampleFrame* dst, const sample_t* src, int channel, int frames );
+
+/*! \brief Copy the planar buffers srcLeft and srcRight into dst */
+LMMS_EXPORT void interleave( sampleFrame* dst, const sample_t* srcLeft, const sample_t* srcRight, int frames );
 
 }
 
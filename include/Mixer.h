@@ -49,6 +49,9 @@ class MixerChannel : public ThreadableJob
 		bool m_hasInput;
 		// set to true if any effect in the channel is enabled and running
 		bool m_stillRunning;
+		// set to true if the channel had neither input nor running effects,
+		// so its buffer stayed silent and didn't need to be processed
+		bool m_sleeping;
 
 		float m_peakLeft;
 		float m_peakRight;
@@ -198,6 +201,8 @@ public:
 	// rename channels when moving etc. if they still have their original name
 	void validateChannelName( int index, int oldIndex );
 
+	void renameChannel( int index, const QString & name );
+
 	void toggledSolo();
 	void activateSolo();
 	void deactivateSolo();
@@ -209,6 +214,10 @@ public:
 
 	MixerRouteVector m_mixerRoutes;
 
+signals:
+	// emitted after channels were added, deleted, moved or renamed
+	void channelsChanged();
+
 private:
 	// the mixer channels in the mixer. index 0 is always master.
 	QVector<MixerChannel *> m_mixerChannels;
@@ -209,6 +209,34 @@ public:
 		setUsesBuffer( false );
 	}
 
+	/*! Ends the note quickly to free its voice: a note which already started
+	    fades out within the next period, others don't start at all */
+	void steal();
+
+	/*! Returns whether the voice of the note was stolen */
+	bool isStolen() const
+	{
+		return m_stolen;
+	}
+
+	/*! Returns the estimated peak level of the note, before the track's
+	    volume and effects */
+	float level() const
+	{
+		return m_level;
+	}
+
+	void setLevel( float level )
+	{
+		m_level = level;
+	}
+
+	/*! Returns how long rendering the last period took, in nanoseconds */
+	qint64 renderTime() const
+	{
+		return m_renderTime;
+	}
+
 	/*! Returns whether note is muted */
 	bool isMuted() const
 	{
@@ -329,6 +357,11 @@ private:
 	Origin m_origin;
 
 	bool m_frequencyNeedsUpdate;				// used to update pitch
+
+	bool m_stolen;							// voice was taken by VoiceLimiter
+	f_cnt_t m_stealFramesLeft;				// frames of the fade out left
+	float m_level;							// peak of the last period
+	qint64 m_renderTime;					// cost of the last period in ns
 } ;
 
 
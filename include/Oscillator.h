@@ -35,6 +35,7 @@
 #endif
 
 #include "Engine.h"
+#include "FastMath.h"
 #include "lmms_constants.h"
 #include "lmmsconfig.h"
 #include "AudioEngine.h"
@@ -102,10 +103,27 @@ public:
 
 	void update(sampleFrame* ab, const fpp_t frames, const ch_cnt_t chnl, bool modulator = false);
 
+	inline Oscillator * subOsc() const
+	{
+		return m_subOsc;
+	}
+
+	//! Start over at the phase offset, including the sub-oscillators,
+	//! so the oscillator can be reused for another note
+	void reset()
+	{
+		m_phaseOffset = m_ext_phaseOffset;
+		m_phase = m_ext_phaseOffset;
+		if (m_subOsc != nullptr)
+		{
+			m_subOsc->reset();
+		}
+	}
+
 	// now follow the wave-shape-routines...
 	static inline sample_t sinSample( const float _sample )
 	{
-		return sinf( _sample * F_2PI );
+		return fastSinf( _sample * F_2PI );
 	}
 
 	static inline sample_t triangleSample( const float _sample )
@@ -0,0 +1,87 @@
+/*
+ * Oversampler.h - polyphase half-band up- and downsampling
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef OVERSAMPLER_H
+#define OVERSAMPLER_H
+
+#include <vector>
+
+#include "lmms_basics.h"
+#include "lmms_export.h"
+
+
+//! Runs a processor at 2, 4 or 8 times the engine rate by cascading
+//! polyphase half-band filters, each of them doubling or halving the rate
+class LMMS_EXPORT Oversampler
+{
+public:
+	static constexpr int MaxStages = 3;
+
+	//! Allocate everything for blocks of up to @p maxFrames frames
+	Oversampler( fpp_t maxFrames );
+
+	//! Set the number of 2x stages and clear the filter history
+	void setStages( int stages );
+	int stages() const
+	{
+		return m_stages;
+	}
+	int factor() const
+	{
+		return 1 << m_stages;
+	}
+
+	//! Buffer large enough for factor() * maxFrames frames
+	sampleFrame * buffer()
+	{
+		return m_buffer.data();
+	}
+
+	//! Convert @p frames frames of @p in into factor() * @p frames frames
+	void upsample( const sampleFrame * in, sampleFrame * out, fpp_t frames );
+	//! Convert factor() * @p frames frames of @p in into @p frames frames
+	void downsample( const sampleFrame * in, sampleFrame * out, fpp_t frames );
+
+	//! Frames the signal is delayed by upsampling and downsampling it
+	f_cnt_t latency() const;
+
+private:
+	//! filter history followed by the current input, per stage and direction
+	struct Stage
+	{
+		std::vector<sampleFrame> up;
+		std::vector<sampleFrame> down;
+	};
+
+	static void upsampleStage( std::vector<sampleFrame> & work,
+			const sampleFrame * in, sampleFrame * out, fpp_t frames );
+	static void downsampleStage( std::vector<sampleFrame> & work,
+			const sampleFrame * in, sampleFrame * out, fpp_t frames,
+			bool pad );
+
+	int m_stages;
+	Stage m_stage[MaxStages];
+	std::vector<sampleFrame> m_scratch[2];
+	std::vector<sampleFrame> m_buffer;
+} ;
+
+#endif
@@ -27,6 +27,7 @@
 #ifndef PIANO_ROLL_H
 #define PIANO_ROLL_H
 
+#include <QPixmap>
 #include <QVector>
 #include <QWidget>
 #include <QInputDialog>
@@ -485,6 +486,35 @@ private:
 	QBrush m_blackKeyInactiveBackground;
 	QBrush m_blackKeyDisabledBackground;
 
+	//! Everything the background grid depends on
+	struct GridCacheKey
+	{
+		QSize size;
+		qreal devicePixelRatio = 0;
+		int position = 0;
+		int ppb = 0;
+		int zoom = 0;
+		int quantization = 0;
+		int keyLineHeight = 0;
+		int startKey = 0;
+		int keysVisible = 0;
+		int notesEditHeight = 0;
+		int whiteKeyWidth = 0;
+		int numerator = 0;
+		int denominator = 0;
+		QList<int> markedSemiTones;
+		QVector<QRgb> colors;
+
+		bool operator==(const GridCacheKey& other) const;
+	};
+
+	//! Redraw m_gridCache if anything the grid depends on has changed
+	void updateGridCache(int q, int topKey);
+
+	QPixmap m_gridCache;
+	GridCacheKey m_gridCacheKey;
+	bool m_drawNoteNames;
+
 signals:
 	void positionChanged( const TimePos & );
 } ;
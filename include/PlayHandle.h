@@ -146,9 +146,18 @@ public:
 	
 	void releaseBuffer();
 	
+	// returns nullptr for handles which are mixed into the accumulators
+	// of their audio port instead of having a buffer on their own
 	sampleFrame * buffer();
 
 private:
+	// notes don't need to be isolated from each other, while everything
+	// else gets checked for silence and must not be mixed before
+	bool accumulates() const
+	{
+		return m_type == TypeNotePlayHandle;
+	}
+
 	Type m_type;
 	f_cnt_t m_offset;
 	QThread* m_affinity;
@@ -76,6 +76,7 @@ private:
 	constexpr static int DEFAULT_HEIGHT{24};
 
 	PluginKey m_pluginKey;
+	//! only fetched when painted, as this can load the plugin's library
 	QPixmap m_logo;
 
 	bool m_mouseOver;
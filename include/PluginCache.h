@@ -0,0 +1,72 @@
+/*
+ * PluginCache.h - persistent cache for plugin metadata
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef PLUGIN_CACHE_H
+#define PLUGIN_CACHE_H
+
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonObject>
+#include <QPair>
+#include <QString>
+
+#include "lmms_export.h"
+
+
+/**
+	Metadata which was read from plugin files, so they don't need to be
+	loaded at every startup
+
+	Each entry belongs to one file and is only valid as long as the path,
+	modification time and size of the file are the same. An entry can also
+	belong to a directory, then everything in it is checked. The whole cache
+	is dropped when LMMS is updated. Entries of files which were not asked
+	for during this run are removed when saving.
+*/
+class LMMS_EXPORT PluginCache
+{
+public:
+	//! Load the cache called @p name from the cache directory
+	PluginCache( const QString & name );
+	//! Save the cache if anything has changed
+	~PluginCache();
+
+	//! Return the data stored for @p file, or an empty object if there
+	//! is none or the file has changed since
+	QJsonObject entry( const QFileInfo & file );
+	void setEntry( const QFileInfo & file, const QJsonObject & data );
+
+	void save();
+
+private:
+	//! Modification time and size of @p file, or the newest modification
+	//! time and total size of everything in it if it's a directory
+	QPair<qint64, qint64> stamp( const QFileInfo & file );
+
+	QString m_fileName;
+	QJsonObject m_entries;
+	QJsonObject m_usedEntries;
+	bool m_modified;
+	QHash<QString, QPair<qint64, qint64>> m_directoryStamps;
+} ;
+
+#endif
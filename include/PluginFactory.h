@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <QtCore/QFileInfo>
 #include <QtCore/QHash>
@@ -37,6 +38,7 @@
 #include "lmms_export.h"
 #include "Plugin.h"
 
+class QJsonObject;
 class QLibrary;
 
 class LMMS_EXPORT PluginFactory
@@ -88,16 +90,30 @@ public:
 	/// It can be retrieved by calling this function.
 	QString errorString(QString pluginName) const;
 
+	/// Libraries of plugins which were found in the cache are only loaded
+	/// when they are needed. Returns false and saves the error string if
+	/// the library of @p info can not be loaded.
+	bool load(const PluginInfo& info);
+
 public slots:
 	void discoverPlugins();
 
 private:
+	//! Create a descriptor of the plugin @p info from its cache @p entry
+	Plugin::Descriptor* cachedDescriptor(const QJsonObject& entry, PluginInfo& info);
+
 	DescriptorMap m_descriptors;
 	PluginInfoList m_pluginInfos;
 
 	QMap<QString, PluginInfoAndKey> m_pluginByExt;
 	QVector<std::string> m_garbage; //!< cleaned up at destruction
 
+	struct CachedPlugin;
+	//! descriptors of the plugins which were not loaded during discovery
+	std::vector<std::unique_ptr<CachedPlugin>> m_cachedPlugins;
+	//! libraries without a plugin, which plugins may depend on
+	QList<QFileInfo> m_dependencies;
+
 	QHash<QString, QString> m_errors;
 
 	static std::unique_ptr<PluginFactory> s_instance;
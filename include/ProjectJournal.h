@@ -25,7 +25,11 @@
 #ifndef PROJECT_JOURNAL_H
 #define PROJECT_JOURNAL_H
 
+#include <memory>
+
+#include <QtCore/QByteArray>
 #include <QtCore/QHash>
+#include <QtCore/QMutex>
 #include <QtCore/QStack>
 
 #include "lmms_basics.h"
@@ -38,7 +42,8 @@ class JournallingObject;
 class ProjectJournal
 {
 public:
-	static const int MAX_UNDO_STATES;
+	//! Memory for the undo and redo history, unless set in the settings
+	static const int DEFAULT_UNDO_MEMORY_MB;
 
 	ProjectJournal();
 	virtual ~ProjectJournal();
@@ -97,18 +102,47 @@ public:
 private:
 	typedef QHash<jo_id_t, JournallingObject *> JoIdMap;
 
+	//! The serialized state of an object, compressed in the background
+	class Snapshot
+	{
+	public:
+		Snapshot( const QByteArray & xml ) :
+			m_data( xml ),
+			m_compressed( false )
+		{
+		}
+
+		//! Bytes currently taken, less once compressed
+		int size() const;
+		QByteArray xml() const;
+		void compress();
+
+	private:
+		mutable QMutex m_mutex;
+		QByteArray m_data;
+		bool m_compressed;
+	} ;
+	typedef std::shared_ptr<Snapshot> SnapshotPtr;
+
 	struct CheckPoint
 	{
-		CheckPoint( jo_id_t initID = 0, const DataFile& initData = DataFile( DataFile::JournalData ) ) :
+		CheckPoint( jo_id_t initID = 0, SnapshotPtr initData = nullptr ) :
 			joID( initID ),
 			data( initData )
 		{
 		}
 		jo_id_t joID;
-		DataFile data;
+		SnapshotPtr data;
 	} ;
 	typedef QStack<CheckPoint> CheckPointStack;
 
+	class Compressor;
+
+	SnapshotPtr saveSnapshot( JournallingObject * jo );
+	void restoreSnapshot( JournallingObject * jo, const Snapshot & snapshot );
+	//! Drop the oldest undo steps until the history fits the memory limit
+	void limitMemory();
+
 	JoIdMap m_joIDs;
 
 	CheckPointStack m_undoCheckPoints;
@@ -116,6 +150,8 @@ private:
 
 	bool m_journalling;
 
+	std::unique_ptr<Compressor> m_compressor;
+
 } ;
 
 
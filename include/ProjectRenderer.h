@@ -25,9 +25,12 @@
 #ifndef PROJECT_RENDERER_H
 #define PROJECT_RENDERER_H
 
+#include <vector>
+
 #include "AudioFileDevice.h"
 #include "lmmsconfig.h"
 #include "AudioEngine.h"
+#include "FifoBuffer.h"
 #include "OutputSettings.h"
 
 #include "lmms_export.h"
@@ -74,6 +77,12 @@ public:
 
 	static const FileEncodeDevice fileEncodeDevices[];
 
+	//! Speed of the last rendering as a multiple of real time
+	double realTimeFactor() const
+	{
+		return m_realTimeFactor;
+	}
+
 public slots:
 	void startProcessing();
 	void abortProcessing();
@@ -86,14 +95,44 @@ signals:
 
 
 private:
+	//! Rendered audio on its way to the encoder
+	struct Block
+	{
+		std::vector<surroundSampleFrame> data;
+		fpp_t frames;
+	} ;
+
+	//! Encodes the blocks while the next ones are being rendered
+	class EncoderThread : public QThread
+	{
+	public:
+		EncoderThread( ProjectRenderer * renderer ) : m_renderer( renderer ) {}
+	private:
+		void run() override { m_renderer->encode(); }
+		ProjectRenderer * m_renderer;
+	} ;
+
 	void run() override;
+	void encode();
+
+	//! the encoders get many periods at once
+	static constexpr fpp_t BlockFrames = 32 * DEFAULT_BUFFER_SIZE;
+	static constexpr int BlockCount = 4;
 
 	AudioFileDevice * m_fileDev;
 	AudioEngine::qualitySettings m_qualitySettings;
 
+	std::vector<Block> m_blocks;
+	//! blocks ready for rendering into and ready for encoding,
+	//! a null block tells the encoder to stop
+	FifoBuffer<Block *> m_freeBlocks;
+	FifoBuffer<Block *> m_renderedBlocks;
+
 	volatile int m_progress;
 	volatile bool m_abort;
 
+	double m_realTimeFactor;
+
 } ;
 
 #endif
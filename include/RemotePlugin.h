@@ -808,6 +808,20 @@ public:
 
 	bool process( const sampleFrame * _in_buf, sampleFrame * _out_buf );
 
+	//! In pipelined mode, instruments (i.e. process() without input) get
+	//! the output of the previous period, while the current one is being
+	//! processed by the remote process in parallel to the engine
+	void setPipelined( bool _on );
+	//! Whether the user enabled pipelining for instruments
+	static bool pipeliningEnabled();
+	inline bool isPipelined() const
+	{
+		return m_pipelined;
+	}
+
+	//! Latency the output of process() has, for compensation
+	f_cnt_t latency() const;
+
 	void processMidiEvent( const MidiEvent&, const f_cnt_t _offset );
 
 	void updateSampleRate( sample_rate_t _sr )
@@ -864,6 +878,10 @@ protected:
 	bool m_failed;
 private:
 	void resizeSharedProcessingMemory();
+	//! Number of floats in one of the two shared memory slots
+	size_t slotSize() const;
+	//! Process incoming messages until at most _max requests are pending
+	void waitForProcessing( int _max );
 
 
 	QProcess m_process;
@@ -885,6 +903,14 @@ private:
 	int m_inputCount;
 	int m_outputCount;
 
+	bool m_pipelined;
+	//! slot of the shared memory the next period is written to
+	int m_currentSlot;
+	//! IdStartProcessing messages without IdProcessingDone
+	int m_pendingRequests;
+	//! whether the other slot holds output of the previous period
+	bool m_pipelineFilled;
+
 #ifndef SYNC_WITH_SHM_FIFO
 	int m_server;
 	QString m_socketFile;
@@ -986,7 +1012,7 @@ public:
 
 private:
 	void setShmKey( key_t _key, int _size );
-	void doProcessing();
+	void doProcessing( int _slot );
 
 #ifdef USE_QT_SHMEM
 	QSharedMemory m_shmObj;
@@ -1355,7 +1381,7 @@ bool RemotePluginClient::processMessage( const message & _m )
 			break;
 
 		case IdStartProcessing:
-			doProcessing();
+			doProcessing( _m.getInt( 0 ) );
 			reply_message.id = IdProcessingDone;
 			reply = true;
 			break;
@@ -1428,12 +1454,16 @@ void RemotePluginClient::setShmKey( key_t _key, int _size )
 
 
 
-void RemotePluginClient::doProcessing()
+void RemotePluginClient::doProcessing( int _slot )
 {
 	if( m_shm != nullptr )
 	{
-		process( (sampleFrame *)( m_inputCount > 0 ? m_shm : nullptr ),
-				(sampleFrame *)( m_shm +
+		// the host double-buffers, so it can fill one slot while we
+		// process the other one
+		float * shm = m_shm +
+			_slot * ( m_inputCount + m_outputCount ) * m_bufferSize;
+		process( (sampleFrame *)( m_inputCount > 0 ? shm : nullptr ),
+				(sampleFrame *)( shm +
 					( m_inputCount*m_bufferSize ) ) );
 	}
 	else
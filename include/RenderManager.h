@@ -52,6 +52,9 @@ public:
 
 	void abortProcessing();
 
+	/// Average speed of the renderings as a multiple of real time
+	double realTimeFactor() const;
+
 signals:
 	void progressChanged( int );
 	void finished();
@@ -74,6 +77,9 @@ private:
 
 	std::unique_ptr<ProjectRenderer> m_activeRenderer;
 
+	double m_realTimeFactorSum;
+	int m_renderCount;
+
 	QVector<Track*> m_tracksToRender;
 	QVector<Track*> m_unmuted;
 } ;
@@ -26,6 +26,7 @@
 #ifndef SAMPLE_BUFFER_H
 #define SAMPLE_BUFFER_H
 
+#include <atomic>
 #include <memory>
 #include <QtCore/QReadWriteLock>
 #include <QtCore/QObject>
@@ -43,6 +44,8 @@
 
 class QPainter;
 class QRect;
+class QRunnable;
+class WaveformPeaks;
 
 // values for buffer margins, used for various libsamplerate interpolation modes
 // the array positions correspond to the converter_type parameter values in libsamplerate
@@ -67,6 +70,9 @@ public:
 		handleState(bool varyingPitch = false, int interpolationMode = SRC_LINEAR);
 		virtual ~handleState();
 
+		//! Start over, only allocating if the sinc mode changed
+		void reset(bool varyingPitch, int interpolationMode);
+
 		const f_cnt_t frameIndex() const
 		{
 			return m_frameIndex;
@@ -94,11 +100,21 @@ public:
 
 
 	private:
+		// returns a scratch buffer holding at least the given amount of
+		// frames, only reallocating if the current one is too small
+		sampleFrame * fragmentBuffer(f_cnt_t frames);
+
 		f_cnt_t m_frameIndex;
-		const bool m_varyingPitch;
+		bool m_varyingPitch;
 		bool m_isBackwards;
+		// only allocated for the sinc modes, zero order hold and linear
+		// interpolation are done by SampleBuffer itself
 		SRC_STATE * m_resamplingData;
 		int m_interpolationMode;
+		// fractional read position for the built-in interpolator
+		double m_frameFraction;
+		sampleFrame * m_fragment;
+		f_cnt_t m_fragmentCapacity;
 
 		friend class SampleBuffer;
 
@@ -300,6 +316,12 @@ private:
 
 	void update(bool keepSettings = false);
 
+	// must be called before m_data changes, without holding m_varLock,
+	// drops the peaks and the cached result of toBase64()
+	void invalidateCaches();
+	// (re)builds m_peaks in the background after m_data changed
+	void buildPeaks();
+
 	void convertIntToFloat(int_sample_t * & ibuf, f_cnt_t frames, int channels);
 	void directFloatWrite(sample_t * & fbuf, f_cnt_t frames, int channels);
 
@@ -338,18 +360,42 @@ private:
 	bool m_reversed;
 	float m_frequency;
 	sample_rate_t m_sampleRate;
+	// used by visualize(), only accessed through std::atomic_load/store
+	std::shared_ptr<const WaveformPeaks> m_peaks;
+	// job of the global thread pool building m_peaks
+	std::unique_ptr<QRunnable> m_peaksJob;
+	std::atomic<bool> m_cancelPeaks;
+	// changes with m_data, the key of the cached toBase64() result
+	quint64 m_dataRevision;
 
 	sampleFrame * getSampleFragment(
 		f_cnt_t index,
 		f_cnt_t frames,
 		LoopMode loopMode,
-		sampleFrame * * tmp,
+		handleState * state,
 		bool * backwards,
 		f_cnt_t loopStart,
 		f_cnt_t loopEnd,
 		f_cnt_t end
 	) const;
 
+	f_cnt_t interpolateFragment(
+		const sampleFrame * src,
+		sampleFrame * dst,
+		const fpp_t frames,
+		const double step,
+		handleState * state
+	) const;
+
+	f_cnt_t resampleFragment(
+		const sampleFrame * src,
+		const f_cnt_t srcFrames,
+		sampleFrame * dst,
+		const fpp_t frames,
+		const double step,
+		handleState * state
+	) const;
+
 	f_cnt_t getLoopedIndex(f_cnt_t index, f_cnt_t startf, f_cnt_t endf) const;
 	f_cnt_t getPingPongIndex(f_cnt_t index, f_cnt_t startf, f_cnt_t endf) const;
 
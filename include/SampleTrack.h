@@ -90,6 +90,7 @@ private:
 	FloatModel m_volumeModel;
 	FloatModel m_panningModel;
 	IntModel m_mixerChannelModel;
+	BoolModel m_monitorModel;
 	AudioPort m_audioPort;
 	bool m_isPlaying;
 
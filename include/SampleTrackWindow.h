@@ -33,6 +33,8 @@
 #include "EffectRackView.h"
 #include "SampleTrack.h"
  
+class LedCheckBox;
+
 
 class SampleTrackWindow : public QWidget, public ModelView, public SerializingObjectHook
 {
@@ -82,6 +84,7 @@ private:
 	QLineEdit * m_nameLineEdit;
 	Knob * m_volumeKnob;
 	Knob * m_panningKnob;
+	LedCheckBox * m_monitorButton;
 	MixerLineLcdSpinBox * m_mixerChannelNumber;
 
 	EffectRackView * m_effectRack;
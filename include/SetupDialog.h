@@ -88,18 +88,22 @@ private slots:
 	void resetAutoSave();
 	void toggleAutoSave(bool enabled);
 	void toggleRunningAutoSave(bool enabled);
+	void setUndoMemory(int steps);
 	void toggleSmoothScroll(bool enabled);
 	void toggleAnimateAFP(bool enabled);
 	void toggleSyncVSTPlugins(bool enabled);
 	void vstEmbedMethodChanged();
 	void toggleVSTAlwaysOnTop(bool en);
 	void toggleDisableAutoQuit(bool enabled);
+	void togglePipelineRemotePlugins(bool enabled);
 
 	// Audio settings widget.
 	void audioInterfaceChanged(const QString & driver);
 	void toggleHQAudioDev(bool enabled);
 	void setBufferSize(int value);
 	void resetBufferSize();
+	void setMaxVoices(int steps);
+	void toggleAdaptiveVoices(bool enabled);
 
 	// MIDI settings widget.
 	void midiInterfaceChanged(const QString & driver);
@@ -152,6 +156,9 @@ private:
 	QLabel * m_saveIntervalLbl;
 	LedCheckBox * m_autoSave;
 	LedCheckBox * m_runningAutoSave;
+	int m_undoMemory;
+	QSlider * m_undoMemorySlider;
+	QLabel * m_undoMemoryLbl;
 	bool m_smoothScroll;
 	bool m_animateAFP;
 	QLabel * m_vstEmbedLbl;
@@ -161,6 +168,7 @@ private:
 	bool m_vstAlwaysOnTop;
 	bool m_syncVSTPlugins;
 	bool m_disableAutoQuit;
+	bool m_pipelineRemotePlugins;
 
 
 	typedef QMap<QString, AudioDeviceSetupWidget *> AswMap;
@@ -176,6 +184,11 @@ private:
 	int m_bufferSize;
 	QSlider * m_bufferSizeSlider;
 	QLabel * m_bufferSizeLbl;
+	int m_maxVoices;
+	QSlider * m_maxVoicesSlider;
+	QLabel * m_maxVoicesLbl;
+	QComboBox * m_voiceStealingComboBox;
+	bool m_adaptiveVoices;
 
 	// MIDI settings widgets.
 	QComboBox * m_midiInterfaces;
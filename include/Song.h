@@ -44,6 +44,7 @@
 
 
 class AutomationTrack;
+class DataFile;
 class Pattern;
 class SampleTCO;
 class TimeLineWidget;
@@ -295,6 +296,8 @@ public:
 	bool guiSaveProject();
 	bool guiSaveProjectAs(const QString & filename);
 	bool saveProjectFile(const QString & filename, bool withResources = false);
+	//! Stores the whole project in dataFile without writing it to disk
+	void saveProjectState(DataFile & dataFile);
 
 	const QString & projectFileName() const
 	{
@@ -322,6 +325,13 @@ public:
 		return m_modified;
 	}
 
+	//! Changes whenever the project is modified, saved or loaded, so
+	//! periodic savers can tell whether there is anything new to save
+	unsigned int modificationCount() const
+	{
+		return m_modificationCount;
+	}
+
 	QString nodeName() const override
 	{
 		return "song";
@@ -355,6 +365,8 @@ public:
 	}
 
 	bool isSavingProject() const;
+	//! The file saveProjectFile() is writing to, empty otherwise
+	const QString& savingFileName() const { return m_savingFileName; }
 
 	std::shared_ptr<const Scale> getScale(unsigned int index) const;
 	std::shared_ptr<const Keymap> getKeymap(unsigned int index) const;
@@ -454,7 +466,9 @@ private:
 
 	QString m_fileName;
 	QString m_oldFileName;
+	QString m_savingFileName;
 	bool m_modified;
+	unsigned int m_modificationCount;
 	bool m_loadOnLaunch;
 
 	volatile bool m_recording;
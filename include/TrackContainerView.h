@@ -120,6 +120,10 @@ public:
 
 	void clearAllTracks();
 
+	// whether a part of the given track view is inside the visible area of
+	// the scroll area - tracks outside of it defer repositioning their TCOs
+	bool isInViewport( const TrackView * _tv ) const;
+
 	QString nodeName() const override
 	{
 		return "trackcontainerview";
@@ -130,6 +134,8 @@ public:
 
 public slots:
 	void realignTracks();
+	// catch up on what tracks deferred while they were scrolled out of view
+	void updateVisibleTracks();
 	TrackView * createTrackView( Track * _t );
 	void deleteTrackView( TrackView * _tv );
 
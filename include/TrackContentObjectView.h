@@ -125,6 +125,7 @@ public slots:
 	virtual bool close();
 	void remove();
 	void update() override;
+	void updateLength();
 
 	void selectColor();
 	void randomizeColor();
@@ -177,7 +178,6 @@ protected:
 
 
 protected slots:
-	void updateLength();
 	void updatePosition();
 
 
@@ -72,6 +72,17 @@ public:
 
 	TimePos endPosition( const TimePos & posStart );
 
+	// defer changePosition() and the update of all TCO views until the
+	// track gets visible again
+	void invalidate()
+	{
+		m_invalid = true;
+	}
+	bool isInvalid() const
+	{
+		return m_invalid;
+	}
+
 	// qproperty access methods
 
 	QBrush darkerColor() const;
@@ -131,6 +142,8 @@ private:
 
 	QPixmap m_background;
 
+	bool m_invalid;
+
 	// qproperty fields
 	QBrush m_darkerColor;
 	QBrush m_lighterColor;
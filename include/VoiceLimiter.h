@@ -0,0 +1,106 @@
+/*
+ * VoiceLimiter.h - enforces polyphony limits by stealing voices
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef VOICE_LIMITER_H
+#define VOICE_LIMITER_H
+
+#include <vector>
+
+#include "lmms_export.h"
+#include "PlayHandle.h"
+
+class InstrumentTrack;
+class NotePlayHandle;
+
+
+/**
+	Keeps the number of playing notes within the limits
+
+	Each instrument track can limit its own voices, and there is a global
+	limit for all of them. Above a limit, the voices chosen by the steal
+	policy are faded out within one period (NotePlayHandle::steal()).
+	Released voices are always stolen before held ones.
+
+	In adaptive mode, voices are also stolen whenever the last period took
+	longer than AdaptiveLoadLimit percent of its length, the least audible
+	ones in relation to their rendering time first, until enough time is
+	freed to get back to AdaptiveLoadTarget. Only the time the voices took
+	themselves can be freed, so nothing is stolen if the rest of the period
+	is above the target already. This doesn't happen while exporting, where
+	there is no deadline.
+*/
+class LMMS_EXPORT VoiceLimiter
+{
+public:
+	enum StealPolicy
+	{
+		StealOldest,	//!< the voices which started first
+		StealQuietest,	//!< the voices with the lowest level
+		StealSameKey	//!< voices of keys which were played again, then the oldest
+	} ;
+
+	//! Highest limit of a single track
+	static constexpr int MaxVoices = 256;
+	//! Highest global limit
+	static constexpr int MaxGlobalVoices = PlayHandle::MaxNumber;
+
+	static constexpr float AdaptiveLoadLimit = 90.0f;
+	static constexpr float AdaptiveLoadTarget = 75.0f;
+
+	VoiceLimiter();
+
+	//! Read the global limit, policy and adaptive mode from the configuration
+	void loadSettings();
+
+	//! Steal voices of @p playHandles before they are rendered. @p load is
+	//! the load of the last period in percent, which took @p periodLength ns.
+	void process( const PlayHandleList & playHandles, float load, qint64 periodLength );
+
+private:
+	struct Voice
+	{
+		NotePlayHandle * note;
+		InstrumentTrack * track;
+		//! a newer note of the same key and track is playing
+		bool replaced;
+	} ;
+	typedef std::vector<Voice>::iterator VoiceIterator;
+
+	static bool stealFirst( const Voice & a, const Voice & b, StealPolicy policy );
+	static float audibility( const Voice & voice );
+
+	//! Steal @p count voices of [@p begin, @p end) according to @p policy
+	static void steal( VoiceIterator begin, VoiceIterator end, int count,
+							StealPolicy policy );
+	void limitTracks();
+	void adapt( float load, qint64 periodLength );
+	void removeStolen();
+
+	int m_maxVoices;
+	StealPolicy m_policy;
+	bool m_adaptive;
+
+	// reserved for all play handles, so the audio thread doesn't allocate
+	std::vector<Voice> m_voices;
+} ;
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ * VoicePool.h - preallocated per-note state of instruments
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef VOICE_POOL_H
+#define VOICE_POOL_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <QMutex>
+
+#include "Instrument.h"
+#include "NotePlayHandle.h"
+
+
+/**
+	Per-note state of an instrument, created in advance and recycled
+
+	Instruments keep the state of each playing note in
+	NotePlayHandle::m_pluginData. Instead of allocating it on the audio
+	thread when a note starts, they take a voice from this pool in
+	playNote() and give it back in deleteNotePluginData(). The reset hook
+	prepares a recycled voice for the new note.
+
+	Only if more notes play at once than voices were created, another
+	voice is allocated, which then stays in the pool.
+*/
+template<class Voice>
+class VoicePool
+{
+public:
+	using CreateFunc = std::function<Voice*()>;
+	using ResetFunc = std::function<void(Voice*, NotePlayHandle*)>;
+
+	VoicePool(CreateFunc create, ResetFunc reset,
+			int size = Instrument::DefaultPolyphony) :
+		m_create(std::move(create)),
+		m_reset(std::move(reset))
+	{
+		reserve(size);
+	}
+
+	//! The voice of @p n, taken from the pool and reset when @p n starts
+	Voice* voice(NotePlayHandle* n)
+	{
+		if (n->m_pluginData == nullptr)
+		{
+			Voice* v = acquire();
+			m_reset(v, n);
+			n->m_pluginData = v;
+		}
+		return static_cast<Voice*>(n->m_pluginData);
+	}
+
+	//! Give the voice of @p n back, to be called by deleteNotePluginData()
+	void release(NotePlayHandle* n)
+	{
+		QMutexLocker lock(&m_mutex);
+		// the capacity always covers all voices, so this doesn't allocate
+		m_free.push_back(static_cast<Voice*>(n->m_pluginData));
+		n->m_pluginData = nullptr;
+	}
+
+	//! Create voices until there are at least @p size of them
+	void reserve(int size)
+	{
+		QMutexLocker lock(&m_mutex);
+		if (size > 0) { grow(static_cast<std::size_t>(size)); }
+	}
+
+private:
+	Voice* acquire()
+	{
+		QMutexLocker lock(&m_mutex);
+		if (m_free.empty())
+		{
+			grow(m_voices.size() + 1);
+		}
+		Voice* v = m_free.back();
+		m_free.pop_back();
+		return v;
+	}
+
+	void grow(std::size_t size)
+	{
+		if (size <= m_voices.size()) { return; }
+		m_voices.reserve(size);
+		m_free.reserve(size);
+		while (m_voices.size() < size)
+		{
+			m_voices.emplace_back(m_create());
+			m_free.push_back(m_voices.back().get());
+		}
+	}
+
+	CreateFunc m_create;
+	ResetFunc m_reset;
+
+	std::vector<std::unique_ptr<Voice>> m_voices;
+	std::vector<Voice*> m_free;
+	QMutex m_mutex;
+} ;
+
+#endif
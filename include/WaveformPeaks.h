@@ -0,0 +1,74 @@
+/*
+ * WaveformPeaks.h - multi-resolution peak cache for drawing waveforms
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef WAVEFORM_PEAKS_H
+#define WAVEFORM_PEAKS_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "lmms_basics.h"
+#include "lmms_export.h"
+
+
+//! Min, max and sum of squares of a sample for buckets of 64, 512 and 4096
+//! frames, so that waveforms can be drawn without scanning all the frames
+class LMMS_EXPORT WaveformPeaks
+{
+public:
+	static constexpr int Levels = 3;
+	static constexpr f_cnt_t BucketSizes[Levels] = { 64, 512, 4096 };
+
+	//! Build the cache for @p frames frames of @p data. Returns nullptr
+	//! if @p cancel got set in the meantime.
+	static std::shared_ptr<const WaveformPeaks> build( const sampleFrame * data,
+				f_cnt_t frames, const std::atomic<bool> & cancel );
+
+	//! Coarsest level whose buckets don't exceed @p framesPerPixel frames,
+	//! or -1 if the raw frames should be scanned instead
+	int levelFor( double framesPerPixel ) const;
+
+	//! Merge the buckets of @p level covering the frames [from, to) into
+	//! @p min, @p max and @p sumSq, return the number of frames merged
+	f_cnt_t scan( int level, f_cnt_t from, f_cnt_t to,
+				float & min, float & max, float & sumSq ) const;
+
+private:
+	struct Peak
+	{
+		float min;
+		float max;
+		// over both channels
+		float sumSq;
+	} ;
+
+	WaveformPeaks( f_cnt_t frames ) :
+		m_frames( frames )
+	{
+	}
+
+	f_cnt_t m_frames;
+	std::vector<Peak> m_levels[Levels];
+} ;
+
+#endif
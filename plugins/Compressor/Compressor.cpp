@@ -25,6 +25,7 @@
 #include "Compressor.h"
 
 #include "embed.h"
+#include "FastMath.h"
 #include "interpolation.h"
 #include "lmms_math.h"
 #include "plugin_export.h"
@@ -101,7 +102,7 @@ CompressorEffect::~CompressorEffect()
 float CompressorEffect::msToCoeff(float ms)
 {
 	// Convert time in milliseconds to applicable lowpass coefficient
-	return exp(m_coeffPrecalc / ms);
+	return fastExpf(m_coeffPrecalc / ms);
 }
 
 
@@ -419,7 +420,7 @@ bool CompressorEffect::processAudioBuffer(sampleFrame* buf, const fpp_t frames)
 			// For the visualizer
 			m_displayPeak[i] = qMax(m_yL[i], m_displayPeak[i]);
 
-			const float currentPeakDbfs = ampToDbfs(m_yL[i]);
+			const float currentPeakDbfs = fastAmpToDbfs(m_yL[i]);
 
 			// Now find the gain change that should be applied,
 			// depending on the measured input value.
@@ -439,7 +440,7 @@ bool CompressorEffect::processAudioBuffer(sampleFrame* buf, const fpp_t frames)
 					: m_thresholdVal + (currentPeakDbfs - m_thresholdVal) * m_ratioVal;
 			}
 
-			m_gainResult[i] = dbfsToAmp(m_gainResult[i]) / m_yL[i];
+			m_gainResult[i] = fastDbfsToAmp(m_gainResult[i]) / m_yL[i];
 			m_gainResult[i] = qMax(m_rangeVal, m_gainResult[i]);
 		}
 
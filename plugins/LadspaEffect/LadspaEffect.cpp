@@ -24,7 +24,7 @@
  */
 
 
-#include <QtCore/QVarLengthArray>
+#include <algorithm>
 #include <QMessageBox>
 
 #include "LadspaEffect.h"
@@ -39,6 +39,7 @@
 #include "AutomationPattern.h"
 #include "ControllerConnection.h"
 #include "MemoryManager.h"
+#include "MixHelpers.h"
 #include "ValueBuffer.h"
 #include "Song.h"
 
@@ -72,6 +73,7 @@ LadspaEffect::LadspaEffect( Model * _parent,
 	Effect( &ladspaeffect_plugin_descriptor, _parent, _key ),
 	m_controls( nullptr ),
 	m_maxSampleRate( 0 ),
+	m_resampleBuffer( nullptr ),
 	m_key( LadspaSubPluginFeatures::subPluginKeyToLadspaKey( _key ) )
 {
 	Ladspa2LMMS * manager = Engine::getLADSPAManager();
@@ -138,22 +140,158 @@ bool LadspaEffect::processAudioBuffer( sampleFrame * _buf,
 		return( false );
 	}
 
+	connectAudioPorts( nullptr );
+
 	int frames = _frames;
 	sampleFrame * o_buf = nullptr;
-	QVarLengthArray<sample_t> sBuf(_frames * DEFAULT_CHANNELS);
 
 	if( m_maxSampleRate < Engine::audioEngine()->processingSampleRate() )
 	{
 		o_buf = _buf;
-		_buf = reinterpret_cast<sampleFrame*>(sBuf.data());
+		_buf = m_resampleBuffer;
 		sampleDown( o_buf, _buf, m_maxSampleRate );
 		frames = _frames * m_maxSampleRate /
 				Engine::audioEngine()->processingSampleRate();
 	}
 
-	// Copy the LMMS audio buffer to the LADSPA input buffer and initialize
-	// the control ports.  
-	ch_cnt_t channel = 0;
+	// Copy the LMMS audio buffer to the LADSPA input buffers, in one pass
+	// if a single processor takes both channels
+	if( m_inPorts.size() == DEFAULT_CHANNELS )
+	{
+		MixHelpers::deinterleave( m_inPorts[0]->buffer,
+					m_inPorts[1]->buffer, _buf, frames );
+	}
+	else
+	{
+		for( int channel = 0; channel < m_inPorts.size(); ++channel )
+		{
+			MixHelpers::deinterleave( m_inPorts[channel]->buffer, _buf,
+								channel, frames );
+		}
+	}
+
+	updateControlPorts( frames );
+
+	// Process the buffers.
+	for( ch_cnt_t proc = 0; proc < processorCount(); ++proc )
+	{
+		(m_descriptor->run)( m_handles[proc], frames );
+	}
+
+	// Mix the LADSPA output buffers into the LMMS buffer.
+	const float d = dryLevel();
+	const float w = wetLevel();
+	if( m_outPorts.size() == DEFAULT_CHANNELS )
+	{
+		MixHelpers::multiplyAndAddMultipliedJoined( _buf,
+			m_outPorts[0]->buffer, m_outPorts[1]->buffer, d, w, frames );
+	}
+	else
+	{
+		for( int channel = 0; channel < m_outPorts.size(); ++channel )
+		{
+			MixHelpers::multiplyAndAddMultipliedChannel( _buf,
+				m_outPorts[channel]->buffer, channel, d, w, frames );
+		}
+	}
+
+	double out_sum = 0.0;
+	for( fpp_t frame = 0; frame < frames; ++frame )
+	{
+		for( int channel = 0; channel < m_outPorts.size(); ++channel )
+		{
+			out_sum += _buf[frame][channel] * _buf[frame][channel];
+		}
+	}
+
+	if( o_buf != nullptr )
+	{
+		sampleBack( _buf, o_buf, m_maxSampleRate );
+	}
+
+	checkGate( out_sum / frames );
+
+
+	bool is_running = isRunning();
+	m_pluginMutex.unlock();
+	return( is_running );
+}
+
+
+
+
+bool LadspaEffect::processesPlanar() const
+{
+	// the output replaces the input, so there's no dry signal to mix in
+	return m_planar && wetLevel() == 1.0f &&
+		m_maxSampleRate >= Engine::audioEngine()->processingSampleRate();
+}
+
+
+
+
+bool LadspaEffect::processPlanarBuffer( const PlanarBuffer & _buf,
+							const fpp_t _frames )
+{
+	m_pluginMutex.lock();
+	if( !isOkay() || dontRun() || !isRunning() || !isEnabled() || !m_planar )
+	{
+		m_pluginMutex.unlock();
+		return( false );
+	}
+
+	// the plugin processes the channels in place, nothing is copied
+	connectAudioPorts( &_buf );
+	updateControlPorts( _frames );
+
+	for( ch_cnt_t proc = 0; proc < processorCount(); ++proc )
+	{
+		(m_descriptor->run)( m_handles[proc], _frames );
+	}
+
+	double out_sum = 0.0;
+	for( const sample_t * channel : _buf.channels )
+	{
+		for( fpp_t frame = 0; frame < _frames; ++frame )
+		{
+			out_sum += channel[frame] * channel[frame];
+		}
+	}
+	checkGate( out_sum / _frames );
+
+	bool is_running = isRunning();
+	m_pluginMutex.unlock();
+	return( is_running );
+}
+
+
+
+
+void LadspaEffect::connectAudioPorts( const PlanarBuffer * _buf )
+{
+	const sample_t * channels = _buf ? _buf->channels[0] : nullptr;
+	if( channels == m_connectedChannels )
+	{
+		return;
+	}
+
+	// only differs if m_planar is set, so there's an output per input
+	for( int channel = 0; channel < m_inPorts.size(); ++channel )
+	{
+		for( port_desc_t * pp : { m_inPorts[channel], m_outPorts[channel] } )
+		{
+			( m_descriptor->connect_port )( m_handles[pp->proc], pp->port_id,
+				_buf ? _buf->channels[channel] : pp->buffer );
+		}
+	}
+	m_connectedChannels = channels;
+}
+
+
+
+
+void LadspaEffect::updateControlPorts( const fpp_t _frames )
+{
 	for( ch_cnt_t proc = 0; proc < processorCount(); ++proc )
 	{
 		for( int port = 0; port < m_portCount; ++port )
@@ -161,21 +299,12 @@ bool LadspaEffect::processAudioBuffer( sampleFrame * _buf,
 			port_desc_t * pp = m_ports.at( proc ).at( port );
 			switch( pp->rate )
 			{
-				case CHANNEL_IN:
-					for( fpp_t frame = 0; 
-						frame < frames; ++frame )
-					{
-						pp->buffer[frame] = 
-							_buf[frame][channel];
-					}
-					++channel;
-					break;
 				case AUDIO_RATE_INPUT:
 				{
 					ValueBuffer * vb = pp->control->valueBuffer();
 					if( vb )
 					{
-						memcpy( pp->buffer, vb->values(), frames * sizeof(float) );
+						memcpy( pp->buffer, vb->values(), _frames * sizeof(float) );
 					}
 					else
 					{
@@ -184,12 +313,7 @@ bool LadspaEffect::processAudioBuffer( sampleFrame * _buf,
 						// This only supports control rate ports, so the audio rates are
 						// treated as though they were control rate by setting the
 						// port buffer to all the same value.
-						for( fpp_t frame = 0; 
-							frame < frames; ++frame )
-						{
-							pp->buffer[frame] = 
-								pp->value;
-						}
+						std::fill( pp->buffer, pp->buffer + _frames, pp->value );
 					}
 					break;
 				}
@@ -203,68 +327,11 @@ bool LadspaEffect::processAudioBuffer( sampleFrame * _buf,
 					pp->buffer[0] = 
 						pp->value;
 					break;
-				case CHANNEL_OUT:
-				case AUDIO_RATE_OUTPUT:
-				case CONTROL_RATE_OUTPUT:
-					break;
-				default:
-					break;
-			}
-		}
-	}
-
-
-	// Process the buffers.
-	for( ch_cnt_t proc = 0; proc < processorCount(); ++proc )
-	{
-		(m_descriptor->run)( m_handles[proc], frames );
-	}
-
-	// Copy the LADSPA output buffers to the LMMS buffer.
-	double out_sum = 0.0;
-	channel = 0;
-	const float d = dryLevel();
-	const float w = wetLevel();
-	for( ch_cnt_t proc = 0; proc < processorCount(); ++proc )
-	{
-		for( int port = 0; port < m_portCount; ++port )
-		{
-			port_desc_t * pp = m_ports.at( proc ).at( port );
-			switch( pp->rate )
-			{
-				case CHANNEL_IN:
-				case AUDIO_RATE_INPUT:
-				case CONTROL_RATE_INPUT:
-					break;
-				case CHANNEL_OUT:
-					for( fpp_t frame = 0; 
-						frame < frames; ++frame )
-					{
-						_buf[frame][channel] = d * _buf[frame][channel] + w * pp->buffer[frame];
-						out_sum += _buf[frame][channel] * _buf[frame][channel];
-					}
-					++channel;
-					break;
-				case AUDIO_RATE_OUTPUT:
-				case CONTROL_RATE_OUTPUT:
-					break;
 				default:
 					break;
 			}
 		}
 	}
-
-	if( o_buf != nullptr )
-	{
-		sampleBack( _buf, o_buf, m_maxSampleRate );
-	}
-
-	checkGate( out_sum / frames );
-
-
-	bool is_running = isRunning();
-	m_pluginMutex.unlock();
-	return( is_running );
 }
 
 
@@ -284,7 +351,15 @@ void LadspaEffect::setControl( int _control, LADSPA_Data _value )
 
 void LadspaEffect::pluginInstantiation()
 {
+	m_planar = false;
+	m_connectedChannels = nullptr;
+
 	m_maxSampleRate = maxSamplerate( displayName() );
+	if( m_maxSampleRate < Engine::audioEngine()->processingSampleRate() )
+	{
+		m_resampleBuffer = MM_ALLOC<sampleFrame>(
+					Engine::audioEngine()->framesPerPeriod() );
+	}
 
 	Ladspa2LMMS * manager = Engine::getLADSPAManager();
 
@@ -327,6 +402,7 @@ void LadspaEffect::pluginInstantiation()
 					p->buffer = MM_ALLOC<LADSPA_Data>( Engine::audioEngine()->framesPerPeriod() );
 					inbuf[ inputch ] = p->buffer;
 					inputch++;
+					m_inPorts.append( p );
 				}
 				else if( p->name.toUpper().contains( "OUT" ) &&
 					manager->isPortOutput( m_key, port ) )
@@ -342,6 +418,7 @@ void LadspaEffect::pluginInstantiation()
 						p->buffer = MM_ALLOC<LADSPA_Data>( Engine::audioEngine()->framesPerPeriod() );
 						m_inPlaceBroken = true;
 					}
+					m_outPorts.append( p );
 				}
 				else if( manager->isPortInput( m_key, port ) )
 				{
@@ -530,6 +607,11 @@ void LadspaEffect::pluginInstantiation()
 	{
 		manager->activate( m_key, m_handles[proc] );
 	}
+
+	// the outputs share the buffers of the inputs, so the plugin can just
+	// as well work in place on the channels of the effect chain
+	m_planar = !m_inPlaceBroken && m_inPorts.size() == DEFAULT_CHANNELS &&
+					m_outPorts.size() == DEFAULT_CHANNELS;
 	m_controls = new LadspaControls( this );
 }
 
@@ -538,6 +620,12 @@ void LadspaEffect::pluginInstantiation()
 
 void LadspaEffect::pluginDestruction()
 {
+	if( m_resampleBuffer )
+	{
+		MM_FREE( m_resampleBuffer );
+		m_resampleBuffer = nullptr;
+	}
+
 	if( !isOkay() )
 	{
 		return;
@@ -564,6 +652,8 @@ void LadspaEffect::pluginDestruction()
 	m_ports.clear();
 	m_handles.clear();
 	m_portControls.clear();
+	m_inPorts.clear();
+	m_outPorts.clear();
 }
 
 
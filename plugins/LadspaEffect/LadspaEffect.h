@@ -45,6 +45,9 @@ public:
 
 	virtual bool processAudioBuffer( sampleFrame * _buf,
 							const fpp_t _frames );
+	virtual bool processesPlanar() const;
+	virtual bool processPlanarBuffer( const PlanarBuffer & _buf,
+							const fpp_t _frames );
 	
 	void setControl( int _control, LADSPA_Data _data );
 
@@ -67,6 +70,11 @@ private:
 	void pluginInstantiation();
 	void pluginDestruction();
 
+	//! Connect the audio ports to the channels of @p _buf, or back to
+	//! their own buffers if it's null
+	void connectAudioPorts( const PlanarBuffer * _buf );
+	void updateControlPorts( const fpp_t _frames );
+
 	static sample_rate_t maxSamplerate( const QString & _name );
 
 
@@ -74,6 +82,8 @@ private:
 	LadspaControls * m_controls;
 
 	sample_rate_t m_maxSampleRate;
+	//! holds the input if it must be downsampled for the plugin
+	sampleFrame * m_resampleBuffer;
 	ladspa_key_t m_key;
 	int m_portCount;
 	bool m_inPlaceBroken;
@@ -83,6 +93,15 @@ private:
 
 	QVector<multi_proc_t> m_ports;
 	multi_proc_t m_portControls;
+	//! audio ports of all processors, in channel order
+	QVector<port_desc_t *> m_inPorts;
+	QVector<port_desc_t *> m_outPorts;
+	//! whether the plugin can work in place on one PlanarBuffer channel
+	//! per audio port
+	bool m_planar;
+	//! first channel the audio ports are connected to, null for their own
+	//! buffers
+	const sample_t * m_connectedChannels;
 
 } ;
 
@@ -102,6 +102,42 @@ bool Lv2Effect::processAudioBuffer(sampleFrame *buf, const fpp_t frames)
 
 
 
+bool Lv2Effect::processesPlanar() const
+{
+	// the output replaces the input, so there's no dry signal to mix in
+	return m_controls.canProcessPlanar() && wetLevel() == 1.0f;
+}
+
+
+
+
+bool Lv2Effect::processPlanarBuffer(const PlanarBuffer& buf, const fpp_t frames)
+{
+	if (!isEnabled() || !isRunning()) { return false; }
+
+	// the plugin processes the channels in place, nothing is copied
+	m_controls.connectPlanarBuffer(buf);
+	m_controls.copyModelsFromLmms();
+	m_controls.run(frames);
+	m_controls.copyModelsToLmms();
+
+	double outSum = .0;
+	for (const sample_t* channel : buf.channels)
+	{
+		for (fpp_t f = 0; f < frames; ++f)
+		{
+			const double s = static_cast<double>(channel[f]);
+			outSum += s*s;
+		}
+	}
+	checkGate(outSum / frames);
+
+	return isRunning();
+}
+
+
+
+
 extern "C"
 {
 
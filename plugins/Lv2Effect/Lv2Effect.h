@@ -41,6 +41,8 @@ public:
 	bool isValid() const { return m_controls.isValid(); }
 
 	bool processAudioBuffer( sampleFrame* buf, const fpp_t frames ) override;
+	bool processesPlanar() const override;
+	bool processPlanarBuffer(const PlanarBuffer& buf, const fpp_t frames) override;
 	EffectControls* controls() override { return &m_controls; }
 
 	Lv2FxControls* lv2Controls() { return &m_controls; }
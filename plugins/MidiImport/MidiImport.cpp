@@ -30,6 +30,7 @@
 #include <QMessageBox>
 #include <QProgressDialog>
 
+#include <memory>
 #include <sstream>
 #include <unordered_map>
 
@@ -306,20 +307,35 @@ bool MidiImport::readSMF( TrackContainer* tc )
 {
 	const int MIDI_CC_COUNT = 128 + 1; // 0-127 (128) + pitch bend
 	const int preTrackSteps = 2;
-	QProgressDialog pd( TrackContainer::tr( "Importing MIDI-file..." ),
-	TrackContainer::tr( "Cancel" ), 0, preTrackSteps, getGUI()->mainWindow() );
-	pd.setWindowTitle( TrackContainer::tr( "Please wait..." ) );
-	pd.setWindowModality(Qt::WindowModal);
-	pd.setMinimumDuration( 0 );
+	// without GUI (e.g. in the benchmarks), import without progress dialog
+	std::unique_ptr<QProgressDialog> pd;
+	if( getGUI() != nullptr )
+	{
+		pd = std::make_unique<QProgressDialog>( TrackContainer::tr( "Importing MIDI-file..." ),
+			TrackContainer::tr( "Cancel" ), 0, preTrackSteps, getGUI()->mainWindow() );
+		pd->setWindowTitle( TrackContainer::tr( "Please wait..." ) );
+		pd->setWindowModality(Qt::WindowModal);
+		pd->setMinimumDuration( 0 );
+	}
+	const auto setProgress = [&pd]( int value )
+	{
+		if( pd )
+		{
+			pd->setValue( value );
+		}
+	};
 
-	pd.setValue( 0 );
+	setProgress( 0 );
 
 	std::istringstream stream(readAllData().toStdString());
 	Alg_seq_ptr seq = new Alg_seq(stream, true);
 	seq->convert_to_beats();
 
-	pd.setMaximum( seq->tracks()  + preTrackSteps );
-	pd.setValue( 1 );
+	if( pd )
+	{
+		pd->setMaximum( seq->tracks()  + preTrackSteps );
+	}
+	setProgress( 1 );
 	
 	// 128 CC + Pitch Bend
 	smfMidiCC ccs[MIDI_CC_COUNT];
@@ -361,7 +377,7 @@ bool MidiImport::readSMF( TrackContainer* tc )
 	timeSigNumeratorPat->updateLength();
 	timeSigDenominatorPat->updateLength();
 
-	pd.setValue( 2 );
+	setProgress( 2 );
 
 	// Tempo stuff
 	AutomationPattern * tap = tc->tempoAutomationPattern();
@@ -405,7 +421,7 @@ bool MidiImport::readSMF( TrackContainer* tc )
 	{
 		QString trackName = QString( tr( "Track" ) + " %1" ).arg( t );
 		Alg_track_ptr trk = seq->track( t );
-		pd.setValue( t + preTrackSteps );
+		setProgress( t + preTrackSteps );
 
 		for( int c = 0; c < MIDI_CC_COUNT; c++ )
 		{
@@ -24,7 +24,8 @@
 
 // TODO:
 // - Better voice allocation: long releases get cut short :(
-// - RT safety = get rid of mutex = make emulator code thread-safe
+// - RT safety = get rid of the global mutex = make emulator code thread-safe,
+//   the OPL core still renders through static state shared by all chips
 
 // - Extras:
 //   - double release: first release is in effect until noteoff (heard if percussive sound),
@@ -44,6 +45,7 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QByteArray>
+#include <algorithm>
 #include <assert.h>
 #include <math.h>
 
@@ -86,8 +88,10 @@ PLUGIN_EXPORT Plugin * lmms_plugin_main( Model *m, void * )
 
 }
 
-// I'd much rather do without a mutex, but it looks like
-// the emulator code isn't really ready for threads
+// The OPL core keeps the state of the chip it is rendering in static
+// variables and shares its tables between chips, so rendering and creating
+// or destroying emulators must not run concurrently. Register writes only
+// touch the chip itself and are guarded by the per-instance mutex.
 QMutex OpulenzInstrument::emulatorMutex;
 
 // Weird ordering of voice parameters
@@ -160,6 +164,8 @@ OpulenzInstrument::OpulenzInstrument( InstrumentTrack * _instrument_track ) :
 	// Can the buffer size change suddenly? I bet that would break lots of stuff
 	frameCount = Engine::audioEngine()->framesPerPeriod();
 	renderbuffer = new short[frameCount];
+	// more than one event per frame is unlikely, so this won't grow
+	eventQueue.reserve(frameCount);
 
 	// Some kind of sane defaults
 	pitchbend = 0;
@@ -219,17 +225,20 @@ OpulenzInstrument::OpulenzInstrument( InstrumentTrack * _instrument_track ) :
 }
 
 OpulenzInstrument::~OpulenzInstrument() {
-	delete theEmulator;
 	Engine::audioEngine()->removePlayHandlesOfTypes( instrumentTrack(),
 				PlayHandle::TypeNotePlayHandle
 				| PlayHandle::TypeInstrumentPlayHandle );
+	emulatorMutex.lock();
+	delete theEmulator;
+	emulatorMutex.unlock();
 	delete [] renderbuffer;
 }
 
 // Samplerate changes when choosing oversampling, so this is more or less mandatory
 void OpulenzInstrument::reloadEmulator() {
-	delete theEmulator;
+	instanceMutex.lock();
 	emulatorMutex.lock();
+	delete theEmulator;
 	theEmulator = new CTemuopl(Engine::audioEngine()->processingSampleRate(), true, false);
 	theEmulator->init();
 	theEmulator->write(0x01,0x20);
@@ -238,10 +247,11 @@ void OpulenzInstrument::reloadEmulator() {
 		voiceNote[i] = OPL2_VOICE_FREE;
 		voiceLRU[i] = i;
 	}
+	instanceMutex.unlock();
 	updatePatch();
 }
 
-// This shall only be called from code protected by the holy Mutex!
+// This shall only be called from code holding instanceMutex!
 void OpulenzInstrument::setVoiceVelocity(int voice, int vel) {
 	int vel_adjusted;
 	// Velocity calculation, some kind of approximation
@@ -293,9 +303,22 @@ int OpulenzInstrument::pushVoice(int v) {
 	return i;
 }
 
+// Events are queued and applied in play(), so that they take effect at
+// their offset instead of at the start of the period
 bool OpulenzInstrument::handleMidiEvent( const MidiEvent& event, const TimePos& time, f_cnt_t offset )
 {
-	emulatorMutex.lock();
+	instanceMutex.lock();
+	// keep the queue sorted by offset, events with equal offsets in order
+	auto pos = std::upper_bound(eventQueue.begin(), eventQueue.end(), offset,
+		[](f_cnt_t o, const QueuedEvent& e) { return o < e.offset; });
+	eventQueue.insert(pos, QueuedEvent{event, offset});
+	instanceMutex.unlock();
+	return true;
+}
+
+// This shall only be called from code holding instanceMutex!
+void OpulenzInstrument::applyMidiEvent( const MidiEvent& event )
+{
 	int key, vel, voice, tmp_pb;
 
 	switch(event.type()) {
@@ -382,8 +405,6 @@ bool OpulenzInstrument::handleMidiEvent( const MidiEvent& event, const TimePos&
 #endif
 		break;
         }
-	emulatorMutex.unlock();
-	return true;
 }
 
 QString OpulenzInstrument::nodeName() const
@@ -399,18 +420,23 @@ PluginView * OpulenzInstrument::instantiateView( QWidget * _parent )
 
 void OpulenzInstrument::play( sampleFrame * _working_buffer )
 {
-	emulatorMutex.lock();
-	theEmulator->update(renderbuffer, frameCount);
-
-	for( fpp_t frame = 0; frame < frameCount; ++frame )
-        {
-                sample_t s = float(renderbuffer[frame]) / 8192.0;
-                for( ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch )
-                {
-                        _working_buffer[frame][ch] = s;
-                }
+	instanceMutex.lock();
+	// Render up to each event, then let it change the registers
+	fpp_t rendered = 0;
+	for( const QueuedEvent& e : eventQueue )
+	{
+		const fpp_t offset = qMin<f_cnt_t>(e.offset, frameCount);
+		if( offset > rendered ) {
+			renderFrames(_working_buffer + rendered, offset - rendered);
+			rendered = offset;
+		}
+		applyMidiEvent(e.event);
 	}
-	emulatorMutex.unlock();
+	eventQueue.clear();
+	if( rendered < frameCount ) {
+		renderFrames(_working_buffer + rendered, frameCount - rendered);
+	}
+	instanceMutex.unlock();
 
 	// Throw the data to the track...
 	instrumentTrack()->processAudioBuffer( _working_buffer, frameCount, nullptr );
@@ -487,9 +513,26 @@ void OpulenzInstrument::loadSettings( const QDomElement & _this )
 
 }
 
+// This shall only be called from code holding instanceMutex!
+void OpulenzInstrument::renderFrames( sampleFrame * buf, fpp_t frames )
+{
+	emulatorMutex.lock();
+	theEmulator->update(renderbuffer, frames);
+	emulatorMutex.unlock();
+
+	for( fpp_t frame = 0; frame < frames; ++frame )
+        {
+                sample_t s = float(renderbuffer[frame]) / 8192.0;
+                for( ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch )
+                {
+                        buf[frame][ch] = s;
+                }
+	}
+}
+
 // Load a patch into the emulator
 void OpulenzInstrument::loadPatch(const unsigned char inst[14]) {
-	emulatorMutex.lock();
+	instanceMutex.lock();
 	for(int v=0; v<OPL2_VOICES; ++v) {
 		theEmulator->write(0x20+adlib_opadd[v],inst[0]); // op1 AM/VIB/EG/KSR/Multiplier
 		theEmulator->write(0x23+adlib_opadd[v],inst[1]); // op2
@@ -503,7 +546,7 @@ void OpulenzInstrument::loadPatch(const unsigned char inst[14]) {
 		theEmulator->write(0xe3+adlib_opadd[v],inst[9]); // op2
 		theEmulator->write(0xc0+v,inst[10]);             // feedback/algorithm
 	}
-	emulatorMutex.unlock();
+	instanceMutex.unlock();
 }
 
 void OpulenzInstrument::tuneEqual(int center, float Hz) {
@@ -566,6 +609,7 @@ void OpulenzInstrument::updatePatch() {
 	inst[13] = 0;
 
 	// Not part of the per-voice patch info
+	instanceMutex.lock();
 	theEmulator->write(0xBD, (trem_depth_mdl.value() ? 128 : 0 ) +
 			   (vib_depth_mdl.value() ? 64 : 0 ));
 
@@ -575,6 +619,7 @@ void OpulenzInstrument::updatePatch() {
 			setVoiceVelocity(voice, velocities[voiceNote[voice]] );
 		}
 	}
+	instanceMutex.unlock();
 #ifdef false
 		printf("UPD: %02x %02x %02x %02x %02x -- %02x %02x %02x %02x %02x %02x\n",
 		       inst[0], inst[1], inst[2], inst[3], inst[4],
@@ -25,8 +25,11 @@
 #ifndef OPULENZ_H
 #define OPULENZ_H
 
+#include <vector>
+
 #include "Instrument.h"
 #include "InstrumentView.h"
+#include "MidiEvent.h"
 #include "opl.h"
 
 #include "LcdSpinBox.h"
@@ -133,9 +136,22 @@ private:
 	int pushVoice(int v);
 
 	int Hz2fnum(float Hz);
+	// Only for what runs the emulator's shared code, see OpulenZ.cpp
 	static QMutex emulatorMutex;
+	// Guards this instance's emulator registers, voices and event queue
+	QMutex instanceMutex;
 	void setVoiceVelocity(int voice, int vel);
 
+	// MIDI events are applied in play(), at their offset in the period
+	struct QueuedEvent
+	{
+		MidiEvent event;
+		f_cnt_t offset;
+	};
+	std::vector<QueuedEvent> eventQueue;
+	void applyMidiEvent(const MidiEvent& event);
+	void renderFrames(sampleFrame *buf, fpp_t frames);
+
 	// Pitch bend range comes through RPNs.
 	int RPNcoarse, RPNfine;
 };
@@ -50,6 +50,12 @@
 #define SIDWRITEDELAY 9 // lda $xxxx,x 4 cycles, sta $d400,x 5 cycles
 #define SIDWAVEDELAY 4 // and $xxxx,x 4 cycles extra
 
+struct SidInstrument::SidVoice
+{
+	MM_OPERATORS
+	SID sid;
+} ;
+
 unsigned char sidorder[] =
   {0x15,0x16,0x18,0x17,
    0x05,0x06,0x02,0x03,0x00,0x01,0x04,
@@ -129,7 +135,18 @@ SidInstrument::SidInstrument( InstrumentTrack * _instrument_track ) :
 	// misc
 	m_voice3OffModel( false, this, tr( "Voice 3 off" ) ),
 	m_volumeModel( 15.0f, 0.0f, 15.0f, 1.0f, this, tr( "Volume" ) ),
-	m_chipModel( sidMOS8580, 0, NumChipModels-1, this, tr( "Chip model" ) )
+	m_chipModel( sidMOS8580, 0, NumChipModels-1, this, tr( "Chip model" ) ),
+	m_sids( []() { return new SidVoice; },
+		[]( SidVoice * _v, NotePlayHandle * )
+		{
+			SID * sid = &_v->sid;
+			sid->set_sampling_parameters( C64_PAL_CYCLES_PER_SEC,
+				SAMPLE_FAST,
+				Engine::audioEngine()->processingSampleRate() );
+			sid->set_chip_model( MOS8580 );
+			sid->enable_filter( true );
+			sid->reset();
+		} )
 {
 	for( int i = 0; i < 3; ++i )
 	{
@@ -305,24 +322,14 @@ static int sid_fillbuffer(unsigned char* sidreg, SID *sid, int tdelta, short *pt
 void SidInstrument::playNote( NotePlayHandle * _n,
 						sampleFrame * _working_buffer )
 {
-	const f_cnt_t tfp = _n->totalFramesPlayed();
-
 	const int clockrate = C64_PAL_CYCLES_PER_SEC;
 	const int samplerate = Engine::audioEngine()->processingSampleRate();
 
-	if ( tfp == 0 )
-	{
-		SID *sid = new SID();
-		sid->set_sampling_parameters( clockrate, SAMPLE_FAST, samplerate );
-		sid->set_chip_model( MOS8580 );
-		sid->enable_filter( true );
-		sid->reset();
-		_n->m_pluginData = sid;
-	}
+	SID *sid = &m_sids.voice( _n )->sid;
+
 	const fpp_t frames = _n->framesLeftForCurrentPeriod();
 	const f_cnt_t offset = _n->noteOffset();
 
-	SID *sid = static_cast<SID *>( _n->m_pluginData );
 	int delta_t = clockrate * frames / samplerate + 4;
 	// avoid variable length array for msvc compat
 	short* buf = reinterpret_cast<short*>(_working_buffer + offset);
@@ -448,7 +455,7 @@ void SidInstrument::playNote( NotePlayHandle * _n,
 
 void SidInstrument::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete static_cast<SID *>( _n->m_pluginData );
+	m_sids.release( _n );
 }
 
 
@@ -31,6 +31,7 @@
 #include "Instrument.h"
 #include "InstrumentView.h"
 #include "Knob.h"
+#include "VoicePool.h"
 
 
 class SidInstrumentView;
@@ -112,6 +113,9 @@ public:
 	void updateKnobToolTip();*/
 
 private:
+	// the emulated chip of a note
+	struct SidVoice;
+
 	// voices
 	voiceObject * m_voice[3];
 
@@ -126,6 +130,8 @@ private:
 
 	IntModel m_chipModel;
 
+	VoicePool<SidVoice> m_sids;
+
 	friend class SidInstrumentView;
 
 } ;
@@ -33,9 +33,12 @@
 
 #include "Xpressive.h"
 
+#include "Engine.h"
+#include "InstrumentTrack.h"
 #include "interpolation.h"
 #include "lmms_math.h"
 #include "NotePlayHandle.h"
+#include "Song.h"
 
 
 #include "exprtk.hpp"
@@ -91,6 +94,14 @@ struct IntegrateFunction : public exprtk::ifunction<T>
 		clearArray(m_counters,max_counters);
 	}
 
+	void reset()
+	{
+		m_nCounters = 0;
+		m_nCountersCalls = 0;
+		m_cc = 0;
+		clearArray(m_counters,m_max_counters);
+	}
+
 	inline T operator()(const T& x)
 	{
 		if (*m_frame == 0)
@@ -142,6 +153,12 @@ struct LastSampleFunction : public exprtk::ifunction<T>
 		clearArray(m_samples, history_size);
 	}
 
+	void reset()
+	{
+		clearArray(m_samples, m_history_size);
+		m_pivot_last = m_history_size - 1;
+	}
+
 	inline T operator()(const T& x)
 	{
 		if (!std::isnan(x) && !std::isinf(x))
@@ -338,17 +355,19 @@ struct RandomVectorFunction : public exprtk::ifunction<float>
 {
 	using exprtk::ifunction<float>::operator();
 
+	// not free of side effects, calls with constant arguments must not be
+	// folded because the seed changes when a voice plays another note
 	RandomVectorFunction(const unsigned int seed) :
 	exprtk::ifunction<float>(1),
 	m_rseed(seed)
-	{ exprtk::disable_has_side_effects(*this); }
+	{}
 
 	inline float operator()(const float& index)
 	{
 		return RandomVectorSeedFunction::randv(index,m_rseed);
 	}
 
-	const unsigned int m_rseed;
+	unsigned int m_rseed;
 };
 
 namespace SimpleRandom {
@@ -395,6 +414,7 @@ public:
 	std::vector<WaveValueFunction<float>* > m_cyclics;
 	std::vector<WaveValueFunctionInterpolate<float>* > m_cyclics_interp;
 	RandomVectorFunction m_rand_vec;
+	float m_seed;
 	IntegrateFunction<float> *m_integ_func;
 	LastSampleFunction<float> m_last_func;
 
@@ -530,7 +550,8 @@ ExprFront::ExprFront(const char * expr, int last_func_samples)
 	
 		m_data->m_symbol_table.add_constant("e", F_E);
 
-		m_data->m_symbol_table.add_constant("seed", SimpleRandom::generator() & max_float_integer_mask);
+		m_data->m_seed = SimpleRandom::generator() & max_float_integer_mask;
+		m_data->m_symbol_table.add_variable("seed", m_data->m_seed);
 	
 		m_data->m_symbol_table.add_function("sinew", sin_wave_func);
 		m_data->m_symbol_table.add_function("squarew", square_wave_func);
@@ -668,6 +689,17 @@ size_t find_occurances(const std::string& haystack, const char* const needle)
 	return count;
 }
 
+void ExprFront::reset()
+{
+	m_data->m_seed = SimpleRandom::generator() & max_float_integer_mask;
+	m_data->m_rand_vec.m_rseed = SimpleRandom::generator();
+	m_data->m_last_func.reset();
+	if (m_data->m_integ_func)
+	{
+		m_data->m_integ_func->reset();
+	}
+}
+
 void ExprFront::setIntegrate(const unsigned int* const frameCounter, const unsigned int sample_rate)
 {
 	if (m_data->m_integ_func == nullptr)
@@ -689,29 +721,88 @@ void ExprFront::setIntegrate(const unsigned int* const frameCounter, const unsig
 }
 
 ExprSynth::ExprSynth(const WaveSample *gW1, const WaveSample *gW2, const WaveSample *gW3,
-	ExprFront *exprO1, ExprFront *exprO2,
-	NotePlayHandle *nph, const sample_rate_t sample_rate,
-	const FloatModel* pan1, const FloatModel* pan2, float rel_trans):
-	m_exprO1(exprO1),
-	m_exprO2(exprO2),
+	float& A1, float& A2, float& A3,
+	const FloatModel* pan1, const FloatModel* pan2):
+	m_exprO1(nullptr),
+	m_exprO2(nullptr),
 	m_W1(gW1),
 	m_W2(gW2),
 	m_W3(gW3),
-	m_nph(nph),
-	m_sample_rate(sample_rate),
+	m_A1(A1),
+	m_A2(A2),
+	m_A3(A3),
+	m_compiledInterpolate{false, false, false},
+	m_key(0),
+	m_bnote(0),
+	m_volume(0),
+	m_tempo(0),
+	m_nph(nullptr),
+	m_sample_rate(0),
 	m_pan1(pan1),
 	m_pan2(pan2),
-	m_rel_transition(rel_trans)
+	m_rel_transition(0)
+{
+}
+
+void ExprSynth::reset(const QByteArray& exprO1, const QByteArray& exprO2, NotePlayHandle* nph,
+	const sample_rate_t sample_rate, float rel_trans)
 {
+	m_nph = nph;
+	m_key = nph->key();//the key that was pressed.
+	m_bnote = nph->instrumentTrack()->baseNote();// the base note
+	m_volume = nph->getVolume() / 255.0;//volume of the note.
+	m_tempo = Engine::getSong()->getTempo();//tempo of the song.
+
 	m_note_sample = 0;
 	m_note_rel_sample = 0;
 	m_note_rel_sec = 0;
 	m_note_sample_sec = 0;
 	m_released = 0;
 	m_frequency = m_nph->frequency();
+	m_rel_transition = rel_trans;
+
+	if (m_exprO1 == nullptr || sample_rate != m_sample_rate
+		|| exprO1 != m_compiledO1 || exprO2 != m_compiledO2
+		|| m_W1->m_interpolate != m_compiledInterpolate[0]
+		|| m_W2->m_interpolate != m_compiledInterpolate[1]
+		|| m_W3->m_interpolate != m_compiledInterpolate[2])
+	{
+		m_sample_rate = sample_rate;
+		compile(exprO1, exprO2);
+	}
+	else
+	{
+		// compiling is expensive, the previous note's expressions only
+		// need their state cleared
+		m_exprO1->reset();
+		m_exprO2->reset();
+	}
 	m_rel_inc = 1000.0 / (m_sample_rate * m_rel_transition);//rel_transition in ms. compute how much increment in each frame
+}
 
-	auto init_expression_step2 = [this](ExprFront * e) {
+void ExprSynth::compile(const QByteArray& exprO1, const QByteArray& exprO2)
+{
+	delete m_exprO1;
+	delete m_exprO2;
+	m_exprO1 = new ExprFront(exprO1.constData(), m_sample_rate);//give the "last" function a whole second
+	m_exprO2 = new ExprFront(exprO2.constData(), m_sample_rate);
+	m_compiledO1 = exprO1;
+	m_compiledO2 = exprO2;
+	m_compiledInterpolate[0] = m_W1->m_interpolate;
+	m_compiledInterpolate[1] = m_W2->m_interpolate;
+	m_compiledInterpolate[2] = m_W3->m_interpolate;
+
+	auto init_expression = [this](ExprFront * e) {
+		// the constants of the note are variables, so the expressions
+		// can be reused for the next note
+		e->add_variable("key", m_key);
+		e->add_variable("bnote", m_bnote);
+		e->add_constant("srate", m_sample_rate);// sample rate of the audio engine
+		e->add_variable("v", m_volume);
+		e->add_variable("tempo", m_tempo);
+		e->add_variable("A1", m_A1);//A1,A2,A3: general purpose input controls.
+		e->add_variable("A2", m_A2);
+		e->add_variable("A3", m_A3);
 		e->add_cyclic_vector("W1", m_W1->m_samples,m_W1->m_length, m_W1->m_interpolate);
 		e->add_cyclic_vector("W2", m_W2->m_samples,m_W2->m_length, m_W2->m_interpolate);
 		e->add_cyclic_vector("W3", m_W3->m_samples,m_W3->m_length, m_W3->m_interpolate);
@@ -722,9 +813,8 @@ ExprSynth::ExprSynth(const WaveSample *gW1, const WaveSample *gW2, const WaveSam
 		e->setIntegrate(&m_note_sample,m_sample_rate);
 		e->compile();
 	};
-	init_expression_step2(m_exprO1);
-	init_expression_step2(m_exprO2);
-
+	init_expression(m_exprO1);
+	init_expression(m_exprO2);
 }
 
 ExprSynth::~ExprSynth()
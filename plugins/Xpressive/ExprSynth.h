@@ -28,6 +28,7 @@
 #include <cmath>
 #include <cstddef>
 #include <limits>
+#include <QByteArray>
 #include "AutomatableModel.h"
 #include "Graph.h"
 #include "Instrument.h"
@@ -49,6 +50,8 @@ public:
 	bool add_constant(const char* name, float  ref);
 	bool add_cyclic_vector(const char* name, const float* data, size_t length, bool interp = false);
 	void setIntegrate(const unsigned int* frameCounter, unsigned int sample_rate);
+	// new random seeds and no history, like a newly compiled expression
+	void reset();
 	ExprFrontData* getData() { return m_data; }
 private:
 	ExprFrontData *m_data;
@@ -92,16 +95,32 @@ class ExprSynth
 {
 	MM_OPERATORS
 public:
-	ExprSynth(const WaveSample* gW1, const WaveSample* gW2, const WaveSample* gW3, ExprFront* exprO1, ExprFront* exprO2, NotePlayHandle* nph,
-			const sample_rate_t sample_rate, const FloatModel* pan1, const FloatModel* pan2, float rel_trans);
+	ExprSynth(const WaveSample* gW1, const WaveSample* gW2, const WaveSample* gW3, float& A1, float& A2, float& A3,
+			const FloatModel* pan1, const FloatModel* pan2);
 	virtual ~ExprSynth();
 
+	// prepare for playing nph, the expressions are only compiled again if
+	// they, the wave interpolation or the sample rate changed
+	void reset(const QByteArray& exprO1, const QByteArray& exprO2, NotePlayHandle* nph,
+			const sample_rate_t sample_rate, float rel_trans);
+
 	void renderOutput(fpp_t frames, sampleFrame* buf );
 
 
 private:
+	void compile(const QByteArray& exprO1, const QByteArray& exprO2);
+
 	ExprFront *m_exprO1, *m_exprO2;
 	const WaveSample *m_W1, *m_W2, *m_W3;
+	float &m_A1, &m_A2, &m_A3;
+	// what the expressions were compiled for
+	QByteArray m_compiledO1, m_compiledO2;
+	bool m_compiledInterpolate[3];
+	// constants of the note, variables of the expressions
+	float m_key;
+	float m_bnote;
+	float m_volume;
+	float m_tempo;
 	unsigned int m_note_sample;
 	unsigned int m_note_rel_sample;
 	float m_note_sample_sec;
@@ -109,7 +128,7 @@ private:
 	float m_frequency;
 	float m_released;
 	NotePlayHandle* m_nph;
-	const sample_rate_t m_sample_rate;
+	sample_rate_t m_sample_rate;
 	const FloatModel *m_pan1,*m_pan2;
 	float m_rel_transition;
 	float m_rel_inc;
@@ -103,7 +103,15 @@ Xpressive::Xpressive(InstrumentTrack* instrument_track) :
 	m_W1(GRAPH_LENGTH),
 	m_W2(GRAPH_LENGTH),
 	m_W3(GRAPH_LENGTH),
-	m_exprValid(false, this)
+	m_exprValid(false, this),
+	m_voices([this]() { return new ExprSynth(&m_W1, &m_W2, &m_W3, m_A1, m_A2, m_A3, &m_panning1, &m_panning2); },
+		[this](ExprSynth* ps, NotePlayHandle* nph) {
+			m_W1.setInterpolate(m_interpolateW1.value());//set interpolation according to the user selection.
+			m_W2.setInterpolate(m_interpolateW2.value());
+			m_W3.setInterpolate(m_interpolateW3.value());
+			ps->reset(m_outputExpression[0], m_outputExpression[1], nph,
+				Engine::audioEngine()->processingSampleRate(), m_relTransition.value());
+		})
 {
 	m_outputExpression[0]="sinew(integrate(f*(1+0.05sinew(12t))))*(2^(-(1.1+A2)*t)*(0.4+0.1(1+A3)+0.4sinew((2.5+2A1)t))^2)";
 	m_outputExpression[1]="expw(integrate(f*atan(500t)*2/pi))*0.5+0.12";
@@ -202,36 +210,7 @@ void Xpressive::playNote(NotePlayHandle* nph, sampleFrame* working_buffer) {
 	m_A2=m_parameterA2.value();
 	m_A3=m_parameterA3.value();
 
-	if (nph->totalFramesPlayed() == 0 || nph->m_pluginData == nullptr) {
-
-		ExprFront *exprO1 = new ExprFront(m_outputExpression[0].constData(),Engine::audioEngine()->processingSampleRate());//give the "last" function a whole second
-		ExprFront *exprO2 = new ExprFront(m_outputExpression[1].constData(),Engine::audioEngine()->processingSampleRate());
-
-		auto init_expression_step1 = [this, nph](ExprFront* e) { //lambda function to init exprO1 and exprO2
-			//add the constants and the variables to the expression.
-			e->add_constant("key", nph->key());//the key that was pressed.
-			e->add_constant("bnote", nph->instrumentTrack()->baseNote()); // the base note
-			e->add_constant("srate", Engine::audioEngine()->processingSampleRate());// sample rate of the audio engine
-			e->add_constant("v", nph->getVolume() / 255.0); //volume of the note.
-			e->add_constant("tempo", Engine::getSong()->getTempo());//tempo of the song.
-			e->add_variable("A1", m_A1);//A1,A2,A3: general purpose input controls.
-			e->add_variable("A2", m_A2);
-			e->add_variable("A3", m_A3);
-		};
-		init_expression_step1(exprO1);
-		init_expression_step1(exprO2);
-
-		m_W1.setInterpolate(m_interpolateW1.value());//set interpolation according to the user selection.
-		m_W2.setInterpolate(m_interpolateW2.value());
-		m_W3.setInterpolate(m_interpolateW3.value());
-		nph->m_pluginData = new ExprSynth(&m_W1, &m_W2, &m_W3, exprO1, exprO2, nph,
-				Engine::audioEngine()->processingSampleRate(), &m_panning1, &m_panning2, m_relTransition.value());
-	}
-
-
-
-
-	ExprSynth *ps = static_cast<ExprSynth*>(nph->m_pluginData);
+	ExprSynth *ps = m_voices.voice(nph);
 	const fpp_t frames = nph->framesLeftForCurrentPeriod();
 	const f_cnt_t offset = nph->noteOffset();
 
@@ -241,7 +220,7 @@ void Xpressive::playNote(NotePlayHandle* nph, sampleFrame* working_buffer) {
 }
 
 void Xpressive::deleteNotePluginData(NotePlayHandle* nph) {
-	delete static_cast<ExprSynth *>(nph->m_pluginData);
+	m_voices.release(nph);
 }
 
 PluginView * Xpressive::instantiateView(QWidget* parent) {
@@ -36,6 +36,7 @@
 #include "PixmapButton.h"
 
 #include "ExprSynth.h"
+#include "VoicePool.h"
 
 class oscillator;
 class XpressiveView;
@@ -135,6 +136,8 @@ private:
 	WaveSample m_W1, m_W2, m_W3;
 
 	BoolModel m_exprValid;
+
+	VoicePool<ExprSynth> m_voices;
 	
 } ;
 
@@ -85,7 +85,12 @@ audioFileProcessor::audioFileProcessor( InstrumentTrack * _instrument_track ) :
 	m_stutterModel( false, this, tr( "Stutter" ) ),
 	m_interpolationModel( this, tr( "Interpolation mode" ) ),
 	m_nextPlayStartPoint( 0 ),
-	m_nextPlayBackwards( false )
+	m_nextPlayBackwards( false ),
+	m_handleStates( []() { return new handleState; },
+		[this]( handleState * _state, NotePlayHandle * _n )
+		{
+			resetHandleState( _state, _n );
+		} )
 {
 	connect( &m_reverseModel, SIGNAL( dataChanged() ),
 				this, SLOT( reverseModelChanged() ), Qt::DirectConnection );
@@ -135,43 +140,12 @@ void audioFileProcessor::playNote( NotePlayHandle * _n,
 		return;
 	}
 
-	if( !_n->m_pluginData )
-	{
-		if( m_stutterModel.value() == true && m_nextPlayStartPoint >= m_sampleBuffer.endFrame() )
-		{
-			// Restart playing the note if in stutter mode, not in loop mode,
-			// and we're at the end of the sample.
-			m_nextPlayStartPoint = m_sampleBuffer.startFrame();
-			m_nextPlayBackwards = false;
-		}
-		// set interpolation mode for libsamplerate
-		int srcmode = SRC_LINEAR;
-		switch( m_interpolationModel.value() )
-		{
-			case 0:
-				srcmode = SRC_ZERO_ORDER_HOLD;
-				break;
-			case 1:
-				srcmode = SRC_LINEAR;
-				break;
-			case 2:
-				srcmode = SRC_SINC_MEDIUM_QUALITY;
-				break;
-		}
-		_n->m_pluginData = new handleState( _n->hasDetuningInfo(), srcmode );
-		((handleState *)_n->m_pluginData)->setFrameIndex( m_nextPlayStartPoint );
-		((handleState *)_n->m_pluginData)->setBackwards( m_nextPlayBackwards );
-
-// debug code
-/*		qDebug( "frames %d", m_sampleBuffer.frames() );
-		qDebug( "startframe %d", m_sampleBuffer.startFrame() );
-		qDebug( "nextPlayStartPoint %d", m_nextPlayStartPoint );*/
-	}
+	handleState * state = m_handleStates.voice( _n );
 
 	if( ! _n->isFinished() )
 	{
 		if( m_sampleBuffer.play( _working_buffer + offset,
-						(handleState *)_n->m_pluginData,
+						state,
 						frames, _n->frequency(),
 						static_cast<SampleBuffer::LoopMode>( m_loopModel.value() ) ) )
 		{
@@ -179,7 +153,7 @@ void audioFileProcessor::playNote( NotePlayHandle * _n,
 			instrumentTrack()->processAudioBuffer( _working_buffer,
 									frames + offset, _n );
 
-			emit isPlaying( ((handleState *)_n->m_pluginData)->frameIndex() );
+			emit isPlaying( state->frameIndex() );
 		}
 		else
 		{
@@ -193,9 +167,41 @@ void audioFileProcessor::playNote( NotePlayHandle * _n,
 	}
 	if( m_stutterModel.value() == true )
 	{
-		m_nextPlayStartPoint = ((handleState *)_n->m_pluginData)->frameIndex();
-		m_nextPlayBackwards = ((handleState *)_n->m_pluginData)->isBackwards();
+		m_nextPlayStartPoint = state->frameIndex();
+		m_nextPlayBackwards = state->isBackwards();
+	}
+}
+
+
+
+
+void audioFileProcessor::resetHandleState( handleState * _state,
+							NotePlayHandle * _n )
+{
+	if( m_stutterModel.value() == true && m_nextPlayStartPoint >= m_sampleBuffer.endFrame() )
+	{
+		// Restart playing the note if in stutter mode, not in loop mode,
+		// and we're at the end of the sample.
+		m_nextPlayStartPoint = m_sampleBuffer.startFrame();
+		m_nextPlayBackwards = false;
+	}
+	// set interpolation mode for libsamplerate
+	int srcmode = SRC_LINEAR;
+	switch( m_interpolationModel.value() )
+	{
+		case 0:
+			srcmode = SRC_ZERO_ORDER_HOLD;
+			break;
+		case 1:
+			srcmode = SRC_LINEAR;
+			break;
+		case 2:
+			srcmode = SRC_SINC_MEDIUM_QUALITY;
+			break;
 	}
+	_state->reset( _n->hasDetuningInfo(), srcmode );
+	_state->setFrameIndex( m_nextPlayStartPoint );
+	_state->setBackwards( m_nextPlayBackwards );
 }
 
 
@@ -203,7 +209,7 @@ void audioFileProcessor::playNote( NotePlayHandle * _n,
 
 void audioFileProcessor::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete (handleState *)_n->m_pluginData;
+	m_handleStates.release( _n );
 }
 
 
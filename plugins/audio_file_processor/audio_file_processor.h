@@ -36,6 +36,7 @@
 #include "PixmapButton.h"
 #include "AutomatableButton.h"
 #include "ComboBox.h"
+#include "VoicePool.h"
 
 
 class audioFileProcessor : public Instrument
@@ -88,6 +89,8 @@ signals:
 private:
 	typedef SampleBuffer::handleState handleState;
 
+	void resetHandleState( handleState * _state, NotePlayHandle * _n );
+
 	SampleBuffer m_sampleBuffer;
 
 	FloatModel m_ampModel;
@@ -102,6 +105,8 @@ private:
 	f_cnt_t m_nextPlayStartPoint;
 	bool m_nextPlayBackwards;
 
+	VoicePool<handleState> m_handleStates;
+
 	friend class AudioFileProcessorView;
 
 } ;
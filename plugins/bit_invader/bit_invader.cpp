@@ -67,15 +67,32 @@ Plugin::Descriptor PLUGIN_EXPORT bitinvader_plugin_descriptor =
 }
 
 
-bSynth::bSynth( float * _shape, NotePlayHandle * _nph, bool _interpolation,
-				float _factor, const sample_rate_t _sample_rate ) :
+bSynth::bSynth() :
 	sample_index( 0 ),
 	sample_realindex( 0 ),
-	nph( _nph ),
-	sample_rate( _sample_rate ),
-	interpolation( _interpolation)
+	nph( nullptr ),
+	sample_rate( 0 ),
+	interpolation( false )
 {
 	sample_shape = new float[wavetableSize];
+}
+
+
+bSynth::~bSynth()
+{
+	delete[] sample_shape;
+}
+
+
+void bSynth::reset( const float * _shape, NotePlayHandle * _nph, bool _interpolation,
+				float _factor, const sample_rate_t _sample_rate )
+{
+	sample_index = 0;
+	sample_realindex = 0;
+	nph = _nph;
+	sample_rate = _sample_rate;
+	interpolation = _interpolation;
+
 	for (int i=0; i < wavetableSize; ++i)
 	{
 		float buf = _shape[i] * _factor;
@@ -93,12 +110,6 @@ bSynth::bSynth( float * _shape, NotePlayHandle * _nph, bool _interpolation,
 }
 
 
-bSynth::~bSynth()
-{
-	delete[] sample_shape;
-}
-
-
 sample_t bSynth::nextStringSample( float sample_length )
 {
 	float sample_step = 
@@ -154,7 +165,15 @@ bitInvader::bitInvader( InstrumentTrack * _instrument_track ) :
 	m_sampleLength(wavetableSize, 4, wavetableSize, 1, this, tr("Sample length")),
 	m_graph(-1.0f, 1.0f, wavetableSize, this),
 	m_interpolation( false, this ),
-	m_normalize( false, this )
+	m_normalize( false, this ),
+	m_voices( []() { return new bSynth; },
+		[this]( bSynth * ps, NotePlayHandle * n )
+		{
+			const float factor = m_normalize.value() ?
+				m_normalizeFactor : defaultNormalizationFactor;
+			ps->reset( m_graph.samples(), n, m_interpolation.value(), factor,
+				Engine::audioEngine()->processingSampleRate() );
+		} )
 {
 	m_graph.setWaveToSine();
 	lengthChanged();
@@ -278,30 +297,10 @@ QString bitInvader::nodeName() const
 void bitInvader::playNote( NotePlayHandle * _n,
 						sampleFrame * _working_buffer )
 {
-	if ( _n->totalFramesPlayed() == 0 || _n->m_pluginData == nullptr )
-	{
-	
-		float factor;
-		if( !m_normalize.value() )
-		{
-			factor = defaultNormalizationFactor;
-		}
-		else
-		{
-			factor = m_normalizeFactor;
-		}
-
-		_n->m_pluginData = new bSynth(
-					const_cast<float*>( m_graph.samples() ),
-					_n,
-					m_interpolation.value(), factor,
-				Engine::audioEngine()->processingSampleRate() );
-	}
-
 	const fpp_t frames = _n->framesLeftForCurrentPeriod();
 	const f_cnt_t offset = _n->noteOffset();
 
-	bSynth * ps = static_cast<bSynth *>( _n->m_pluginData );
+	bSynth * ps = m_voices.voice( _n );
 	for( fpp_t frame = offset; frame < frames + offset; ++frame )
 	{
 		const sample_t cur = ps->nextStringSample( m_graph.length() );
@@ -321,7 +320,7 @@ void bitInvader::playNote( NotePlayHandle * _n,
 
 void bitInvader::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete static_cast<bSynth *>( _n->m_pluginData );
+	m_voices.release( _n );
 }
 
 
@@ -34,6 +34,7 @@
 #include "PixmapButton.h"
 #include "LedCheckbox.h"
 #include "MemoryManager.h"
+#include "VoicePool.h"
 
 class oscillator;
 class bitInvaderView;
@@ -42,10 +43,13 @@ class bSynth
 {
 	MM_OPERATORS
 public:
-	bSynth( float * sample, NotePlayHandle * _nph,
-			bool _interpolation, float factor, 
-			const sample_rate_t _sample_rate );
+	bSynth();
 	virtual ~bSynth();
+
+	// prepare for playing _nph from the start with the given wave
+	void reset( const float * sample, NotePlayHandle * _nph,
+			bool _interpolation, float factor,
+			const sample_rate_t _sample_rate );
 	
 	sample_t nextStringSample( float sample_length );
 
@@ -55,7 +59,7 @@ private:
 	float sample_realindex;
 	float* sample_shape;
 	NotePlayHandle* nph;
-	const sample_rate_t sample_rate;
+	sample_rate_t sample_rate;
 
 	bool interpolation;
 	
@@ -101,6 +105,8 @@ private:
 	BoolModel m_normalize;
 	
 	float m_normalizeFactor;
+
+	VoicePool<bSynth> m_voices;
 	
 	friend class bitInvaderView;
 } ;
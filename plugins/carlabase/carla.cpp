@@ -339,7 +339,7 @@ intptr_t CarlaInstrument::handleDispatcher(const NativeHostDispatcherOpcode opco
 
 Instrument::Flags CarlaInstrument::flags() const
 {
-    return IsSingleStreamed|IsMidiBased|IsNotBendable;
+    return IsSingleStreamed|IsMidiBased|IsNotBendable|NeverSleeps;
 }
 
 QString CarlaInstrument::nodeName() const
@@ -90,15 +90,15 @@ public:
 
 private:
 	float m_phase;
-	const float m_startFreq;
-	const float m_endFreq;
-	const float m_noise;
-	const float m_slope;
-	const float m_env;
-	const float m_distStart;
-	const float m_distEnd;
-	const bool m_hasDistEnv;
-	const float m_length;
+	float m_startFreq;
+	float m_endFreq;
+	float m_noise;
+	float m_slope;
+	float m_env;
+	float m_distStart;
+	float m_distEnd;
+	bool m_hasDistEnv;
+	float m_length;
 	FX m_FX;
 
 	unsigned long m_counter;
@@ -72,7 +72,25 @@ kickerInstrument::kickerInstrument( InstrumentTrack * _instrument_track ) :
 	m_slopeModel( 0.06f, 0.001f, 1.0f, 0.001f, this, tr( "Frequency slope" ) ),
 	m_startNoteModel( true, this, tr( "Start from note" ) ),
 	m_endNoteModel( false, this, tr( "End to note" ) ),
-	m_versionModel( KICKER_PRESET_VERSION, 0, KICKER_PRESET_VERSION, this, "" )
+	m_versionModel( KICKER_PRESET_VERSION, 0, KICKER_PRESET_VERSION, this, "" ),
+	m_voices( []() { return new SweepOsc( DistFX( 0, 0 ), 0, 0, 0, 0, 0, 0, 0, 0, 0 ); },
+		[this]( SweepOsc * so, NotePlayHandle * n )
+		{
+			const float decfr = m_decayModel.value() *
+				Engine::audioEngine()->processingSampleRate() / 1000.0f;
+			*so = SweepOsc(
+					DistFX( m_distModel.value(),
+							m_gainModel.value() ),
+					m_startNoteModel.value() ? n->frequency() : m_startFreqModel.value(),
+					m_endNoteModel.value() ? n->frequency() : m_endFreqModel.value(),
+					m_noiseModel.value() * m_noiseModel.value(),
+					m_clickModel.value() * 0.25f,
+					m_slopeModel.value(),
+					m_envModel.value(),
+					m_distModel.value(),
+					m_distEndModel.value(),
+					decfr );
+		} )
 {
 }
 
@@ -157,10 +175,6 @@ QString kickerInstrument::nodeName() const
 
 
 
-typedef DspEffectLibrary::Distortion DistFX;
-typedef KickerOsc<DspEffectLibrary::MonoToStereoAdaptor<DistFX> > SweepOsc;
-
-
 void kickerInstrument::playNote( NotePlayHandle * _n,
 						sampleFrame * _working_buffer )
 {
@@ -169,27 +183,12 @@ void kickerInstrument::playNote( NotePlayHandle * _n,
 	const float decfr = m_decayModel.value() * Engine::audioEngine()->processingSampleRate() / 1000.0f;
 	const f_cnt_t tfp = _n->totalFramesPlayed();
 
-	if ( tfp == 0 )
-	{
-		_n->m_pluginData = new SweepOsc(
-					DistFX( m_distModel.value(),
-							m_gainModel.value() ),
-					m_startNoteModel.value() ? _n->frequency() : m_startFreqModel.value(),
-					m_endNoteModel.value() ? _n->frequency() : m_endFreqModel.value(),
-					m_noiseModel.value() * m_noiseModel.value(),
-					m_clickModel.value() * 0.25f,
-					m_slopeModel.value(),
-					m_envModel.value(),
-					m_distModel.value(),
-					m_distEndModel.value(),
-					decfr );
-	}
-	else if( tfp > decfr && !_n->isReleased() )
+	SweepOsc * so = m_voices.voice( _n );
+	if( tfp > decfr && !_n->isReleased() )
 	{
 		_n->noteOff();
 	}
 
-	SweepOsc * so = static_cast<SweepOsc *>( _n->m_pluginData );
 	so->update( _working_buffer + offset, frames, Engine::audioEngine()->processingSampleRate() );
 
 	if( _n->isReleased() )
@@ -212,7 +211,7 @@ void kickerInstrument::playNote( NotePlayHandle * _n,
 
 void kickerInstrument::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete static_cast<SweepOsc *>( _n->m_pluginData );
+	m_voices.release( _n );
 }
 
 
@@ -28,11 +28,14 @@
 #define KICKER_H
 
 #include <QObject>
+#include "DspEffectLibrary.h"
 #include "Instrument.h"
 #include "InstrumentView.h"
+#include "KickerOsc.h"
 #include "Knob.h"
 #include "LedCheckbox.h"
 #include "TempoSyncKnob.h"
+#include "VoicePool.h"
 
 
 #define KICKER_PRESET_VERSION 1
@@ -42,6 +45,10 @@ class kickerInstrumentView;
 class NotePlayHandle;
 
 
+typedef DspEffectLibrary::Distortion DistFX;
+typedef KickerOsc<DspEffectLibrary::MonoToStereoAdaptor<DistFX> > SweepOsc;
+
+
 class kickerInstrument : public Instrument
 {
 	Q_OBJECT
@@ -88,6 +95,8 @@ private:
 
 	IntModel m_versionModel;
 
+	VoicePool<SweepOsc> m_voices;
+
 	friend class kickerInstrumentView;
 
 } ;
@@ -35,6 +35,7 @@
 #include "lb302.h"
 #include "AutomatableButton.h"
 #include "Engine.h"
+#include "FastMath.h"
 #include "InstrumentPlayHandle.h"
 #include "InstrumentTrack.h"
 #include "Knob.h"
@@ -172,9 +173,9 @@ void lb302FilterIIR2::envRecalc()
 	lb302Filter::envRecalc();
 
 	w = vcf_e0 + vcf_c0;          // e0 is adjusted for Hz and doesn't need ENVINC
-	k = exp(-w/vcf_rescoeff);     // Does this mean c0 is inheritantly?
+	k = fastExpf(-w/vcf_rescoeff); // Does this mean c0 is inheritantly?
 
-	vcf_a = 2.0*cos(2.0*w) * k;
+	vcf_a = 2.0*fastCosf(2.0f*w) * k;
 	vcf_b = -k*k;
 	vcf_c = 1.0 - vcf_a - vcf_b;
 }
@@ -247,7 +248,7 @@ void lb302Filter3Pole::envRecalc()
 	kp1  = kp+1.0;
 	kp1h = 0.5*kp1;
 #ifdef LB_24_RES_TRICK
-	k = exp(-w/vcf_rescoeff);
+	k = fastExpf(-w/vcf_rescoeff);
 	kres = (((k))) * (((-2.7079*kp1 + 10.963)*kp1 - 14.934)*kp1 + 8.4974);
 #else
 	kres = (((fs->reso))) * (((-2.7079*kp1 + 10.963)*kp1 - 14.934)*kp1 + 8.4974);
@@ -261,12 +262,12 @@ float lb302Filter3Pole::process(const float& samp)
 	float ax1  = lastin;
 	float ay11 = ay1;
 	float ay31 = ay2;
-	lastin  = (samp) - tanh(kres*aout);
+	lastin  = (samp) - fastTanhf(kres*aout);
 	ay1     = kp1h * (lastin+ax1) - kp*ay1;
 	ay2     = kp1h * (ay1 + ay11) - kp*ay2;
 	aout    = kp1h * (ay2 + ay31) - kp*aout;
 
-	return tanh(aout*value)*LB_24_VOL_ADJUST/(1.0+fs->dist);
+	return fastTanhf(aout*value)*LB_24_VOL_ADJUST/(1.0+fs->dist);
 }
 
 
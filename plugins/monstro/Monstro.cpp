@@ -31,6 +31,7 @@
 #include "gui_templates.h"
 #include "ToolTip.h"
 #include "Song.h"
+#include "FastMath.h"
 #include "lmms_math.h"
 #include "interpolation.h"
 
@@ -60,10 +61,26 @@ Plugin::Descriptor PLUGIN_EXPORT monstro_plugin_descriptor =
 
 
 
-MonstroSynth::MonstroSynth( MonstroInstrument * _i, NotePlayHandle * _nph ) :
+MonstroSynth::MonstroSynth( MonstroInstrument * _i ) :
 					m_parent( _i ),
-					m_nph( _nph )
+					m_nph( nullptr )
 {
+	m_lfo[0].resize( m_parent->m_fpp );
+	m_lfo[1].resize( m_parent->m_fpp );
+	m_env[0].resize( m_parent->m_fpp );
+	m_env[1].resize( m_parent->m_fpp );
+}
+
+
+MonstroSynth::~MonstroSynth()
+{
+}
+
+
+void MonstroSynth::reset( NotePlayHandle * _nph )
+{
+	m_nph = _nph;
+
 	m_osc1l_phase = 0.0f;
 	m_osc1r_phase = 0.0f;
 	m_osc2l_phase = 0.0f;
@@ -99,16 +116,6 @@ MonstroSynth::MonstroSynth( MonstroInstrument * _i, NotePlayHandle * _nph ) :
 	m_counter2r = 0;
 	m_counter3l = 0;
 	m_counter3r = 0;
-
-	m_lfo[0].resize( m_parent->m_fpp );
-	m_lfo[1].resize( m_parent->m_fpp );
-	m_env[0].resize( m_parent->m_fpp );
-	m_env[1].resize( m_parent->m_fpp );
-}
-
-
-MonstroSynth::~MonstroSynth()
-{
 }
 
 
@@ -122,7 +129,7 @@ void MonstroSynth::renderOutput( fpp_t _frames, sampleFrame * _buf  )
 		if( mod##_e2 != 0.0f ) modtmp += m_env[1][f] * mod##_e2; \
 		if( mod##_l1 != 0.0f ) modtmp += m_lfo[0][f] * mod##_l1; \
 		if( mod##_l2 != 0.0f ) modtmp += m_lfo[1][f] * mod##_l2; \
-		car = qBound( MIN_FREQ, car * powf( 2.0f, modtmp ), MAX_FREQ );
+		car = qBound( MIN_FREQ, car * fastExp2f( modtmp ), MAX_FREQ );
 
 #define modulateabs( car, mod ) \
 		if( mod##_e1 != 0.0f ) car += m_env[0][f] * mod##_e1; \
@@ -942,7 +949,10 @@ MonstroInstrument::MonstroInstrument( InstrumentTrack * _instrument_track ) :
 		m_sub3env1( 0.0f, -1.0f, 1.0f, 0.001f, this, tr( "Osc 3 - Sub env 1" ) ),
 		m_sub3env2( 0.0f, -1.0f, 1.0f, 0.001f, this, tr( "Osc 3 - Sub env 2" ) ),
 		m_sub3lfo1( 0.0f, -1.0f, 1.0f, 0.001f, this, tr( "Osc 3 - Sub LFO 1" ) ),
-		m_sub3lfo2( 0.0f, -1.0f, 1.0f, 0.001f, this, tr( "Osc 3 - Sub LFO 2" ) )
+		m_sub3lfo2( 0.0f, -1.0f, 1.0f, 0.001f, this, tr( "Osc 3 - Sub LFO 2" ) ),
+		m_voices( [this]() { return new MonstroSynth( this ); },
+			[]( MonstroSynth * ms, NotePlayHandle * n ) { ms->reset( n ); },
+			0 )
 
 {
 
@@ -1009,6 +1019,8 @@ MonstroInstrument::MonstroInstrument( InstrumentTrack * _instrument_track ) :
 	connect( Engine::audioEngine(), SIGNAL( sampleRateChanged() ), this, SLOT( updateSamplerate() ) );
 
 	m_fpp = Engine::audioEngine()->framesPerPeriod();
+	// the voices are sized for the period
+	m_voices.reserve( DefaultPolyphony );
 
 	updateSamplerate();
 	updateVolume1();
@@ -1036,12 +1048,7 @@ void MonstroInstrument::playNote( NotePlayHandle * _n,
 	const fpp_t frames = _n->framesLeftForCurrentPeriod();
 	const f_cnt_t offset = _n->noteOffset();
 
-	if ( _n->totalFramesPlayed() == 0 || _n->m_pluginData == nullptr )
-	{
-		_n->m_pluginData = new MonstroSynth( this, _n );
-	}
-
-	MonstroSynth * ms = static_cast<MonstroSynth *>( _n->m_pluginData );
+	MonstroSynth * ms = m_voices.voice( _n );
 
 	ms->renderOutput( frames, _working_buffer + offset );
 
@@ -1052,7 +1059,7 @@ void MonstroInstrument::playNote( NotePlayHandle * _n,
 
 void MonstroInstrument::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete static_cast<MonstroSynth *>( _n->m_pluginData );
+	m_voices.release( _n );
 }
 
 
@@ -39,6 +39,7 @@
 #include "Oscillator.h"
 #include "lmms_math.h"
 #include "BandLimitedWave.h"
+#include "VoicePool.h"
 
 //
 //	UI Macros
@@ -161,9 +162,12 @@ class MonstroSynth
 {
 	MM_OPERATORS
 public:
-	MonstroSynth( MonstroInstrument * _i, NotePlayHandle * _nph );
+	MonstroSynth( MonstroInstrument * _i );
 	virtual ~MonstroSynth();
 
+	// prepare for playing _nph from the start
+	void reset( NotePlayHandle * _nph );
+
 	void renderOutput( fpp_t _frames, sampleFrame * _buf );
 
 private:
@@ -563,6 +567,8 @@ private:
 	FloatModel	m_sub3lfo1;
 	FloatModel	m_sub3lfo2;
 
+	VoicePool<MonstroSynth> m_voices;
+
 	friend class MonstroSynth;
 	friend class MonstroView;
 
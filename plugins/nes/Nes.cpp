@@ -57,11 +57,24 @@ Plugin::Descriptor PLUGIN_EXPORT nes_plugin_descriptor =
 }
 
 
-NesObject::NesObject( NesInstrument * nes, const sample_rate_t samplerate, NotePlayHandle * nph ) :
+NesObject::NesObject( NesInstrument * nes ) :
 	m_parent( nes ),
-	m_samplerate( samplerate ),
-	m_nph( nph )
+	m_samplerate( 0 ),
+	m_nph( nullptr )
 {
+}
+
+
+NesObject::~NesObject()
+{
+}
+
+
+void NesObject::reset( const sample_rate_t samplerate, NotePlayHandle * nph )
+{
+	m_samplerate = samplerate;
+	m_nph = nph;
+
 	m_pitchUpdateCounter = 0;
 	m_pitchUpdateFreq = wavelength( 60.0f );	
 	
@@ -100,11 +113,6 @@ NesObject::NesObject( NesInstrument * nes, const sample_rate_t samplerate, NoteP
 }
 
 
-NesObject::~NesObject()
-{
-}
-
-
 void NesObject::renderOutput( sampleFrame * buf, fpp_t frames )
 {
 	////////////////////////////////
@@ -535,7 +543,12 @@ NesInstrument::NesInstrument( InstrumentTrack * instrumentTrack ) :
 	
 	//master
 	m_masterVol( 1.0f, 0.0f, 2.0f, 0.01f, this, tr( "Master volume" ) ),
-	m_vibrato( 0.0f, 0.0f, 15.0f, 1.0f, this, tr( "Vibrato" ) )
+	m_vibrato( 0.0f, 0.0f, 15.0f, 1.0f, this, tr( "Vibrato" ) ),
+	m_voices( [this]() { return new NesObject( this ); },
+		[]( NesObject * nes, NotePlayHandle * n )
+		{
+			nes->reset( Engine::audioEngine()->processingSampleRate(), n );
+		} )
 {
 	connect( &m_ch1Crs, SIGNAL( dataChanged() ), this, SLOT( updateFreq1() ), Qt::DirectConnection );
 	connect( &m_ch2Crs, SIGNAL( dataChanged() ), this, SLOT( updateFreq2() ), Qt::DirectConnection );
@@ -558,13 +571,7 @@ void NesInstrument::playNote( NotePlayHandle * n, sampleFrame * workingBuffer )
 	const fpp_t frames = n->framesLeftForCurrentPeriod();
 	const f_cnt_t offset = n->noteOffset();
 	
-	if ( n->totalFramesPlayed() == 0 || n->m_pluginData == nullptr )
-	{	
-		NesObject * nes = new NesObject( this, Engine::audioEngine()->processingSampleRate(), n );
-		n->m_pluginData = nes;
-	}
-	
-	NesObject * nes = static_cast<NesObject *>( n->m_pluginData );
+	NesObject * nes = m_voices.voice( n );
 	
 	nes->renderOutput( workingBuffer + offset, frames );
 	
@@ -576,7 +583,7 @@ void NesInstrument::playNote( NotePlayHandle * n, sampleFrame * workingBuffer )
 
 void NesInstrument::deleteNotePluginData( NotePlayHandle * n )
 {
-	delete static_cast<NesObject *>( n->m_pluginData );
+	m_voices.release( n );
 }
 
 
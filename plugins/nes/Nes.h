@@ -35,6 +35,7 @@
 #include "NotePlayHandle.h"
 #include "PixmapButton.h"
 #include "MemoryManager.h"
+#include "VoicePool.h"
 
 
 #define makeknob( name, x, y, hint, unit, oname ) 		\
@@ -85,8 +86,11 @@ class NesObject
 {
 	MM_OPERATORS
 public:
-	NesObject( NesInstrument * nes, const sample_rate_t samplerate, NotePlayHandle * nph );
+	NesObject( NesInstrument * nes );
 	virtual ~NesObject();
+
+	// prepare for playing nph from the start
+	void reset( const sample_rate_t samplerate, NotePlayHandle * nph );
 	
 	void renderOutput( sampleFrame * buf, fpp_t frames );
 	void updateVibrato( float * freq );
@@ -151,7 +155,7 @@ public:
 	
 private:
 	NesInstrument * m_parent;
-	const sample_rate_t m_samplerate;
+	sample_rate_t m_samplerate;
 	NotePlayHandle * m_nph;
 	
 	int m_pitchUpdateCounter;
@@ -288,6 +292,7 @@ private:
 	FloatModel	m_masterVol;
 	FloatModel	m_vibrato;
 	
+	VoicePool<NesObject> m_voices;
 	
 	friend class NesObject;
 	friend class NesInstrumentView;
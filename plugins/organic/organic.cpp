@@ -79,7 +79,10 @@ organicInstrument::organicInstrument( InstrumentTrack * _instrument_track ) :
 	Instrument( _instrument_track, &organic_plugin_descriptor ),
 	m_modulationAlgo( Oscillator::SignalMix, Oscillator::SignalMix, Oscillator::SignalMix),
 	m_fx1Model( 0.0f, 0.0f, 0.99f, 0.01f , this, tr( "Distortion" ) ),
-	m_volModel( 100.0f, 0.0f, 200.0f, 1.0f, this, tr( "Volume" ) )
+	m_volModel( 100.0f, 0.0f, 200.0f, 1.0f, this, tr( "Volume" ) ),
+	m_voices( [this]() { return createVoice(); },
+		[this]( Voice * _v, NotePlayHandle * ) { resetVoice( _v ); },
+		0 )
 {
 	m_numOscillators = NUM_OSCILLATORS;
 
@@ -105,6 +108,9 @@ organicInstrument::organicInstrument( InstrumentTrack * _instrument_track ) :
 
 	}
 
+	// the voices refer to the oscillator objects
+	m_voices.reserve( DefaultPolyphony );
+
 /*	m_osc[0]->m_harmonic = log2f( 0.5f );	// one octave below
 	m_osc[1]->m_harmonic = log2f( 0.75f );	// a fifth below
 	m_osc[2]->m_harmonic = log2f( 1.0f );	// base freq
@@ -224,78 +230,67 @@ QString organicInstrument::nodeName() const
 
 
 
-void organicInstrument::playNote( NotePlayHandle * _n,
-						sampleFrame * _working_buffer )
+organicInstrument::Voice * organicInstrument::createVoice()
 {
-	const fpp_t frames = _n->framesLeftForCurrentPeriod();
-	const f_cnt_t offset = _n->noteOffset();
-	
-	if( _n->totalFramesPlayed() == 0 || _n->m_pluginData == nullptr )
+	Voice * v = new Voice;
+	v->frequency = 0.0f;
+	v->oscLeft = nullptr;
+	v->oscRight = nullptr;
+
+	// the last oscs need no sub-oscs, so start with them
+	for( int i = m_numOscillators - 1; i >= 0; --i )
 	{
-		Oscillator * oscs_l[NUM_OSCILLATORS];
-		Oscillator * oscs_r[NUM_OSCILLATORS];
+		v->phaseOffsetLeft[i] = 0.0f;
+		v->phaseOffsetRight[i] = 0.0f;
+		v->oscLeft = new Oscillator(
+				&m_osc[i]->m_waveShape,
+				&m_modulationAlgo,
+				v->frequency,
+				m_osc[i]->m_detuningLeft,
+				v->phaseOffsetLeft[i],
+				m_osc[i]->m_volumeLeft,
+				v->oscLeft );
+		v->oscRight = new Oscillator(
+				&m_osc[i]->m_waveShape,
+				&m_modulationAlgo,
+				v->frequency,
+				m_osc[i]->m_detuningRight,
+				v->phaseOffsetRight[i],
+				m_osc[i]->m_volumeRight,
+				v->oscRight );
+	}
+	return v;
+}
+
 
-		_n->m_pluginData = new oscPtr;
 
-		for( int i = m_numOscillators - 1; i >= 0; --i )
-		{
-			static_cast<oscPtr *>( _n->m_pluginData )->phaseOffsetLeft[i] 
-				= rand() / ( RAND_MAX + 1.0f );
-			static_cast<oscPtr *>( _n->m_pluginData )->phaseOffsetRight[i] 
-				= rand() / ( RAND_MAX + 1.0f );
-			
-			// initialise ocillators
-			
-			if( i == m_numOscillators - 1 )
-			{
-				// create left oscillator
-				oscs_l[i] = new Oscillator(
-						&m_osc[i]->m_waveShape,
-						&m_modulationAlgo,
-						_n->frequency(),
-						m_osc[i]->m_detuningLeft,
-						static_cast<oscPtr *>( _n->m_pluginData )->phaseOffsetLeft[i],
-						m_osc[i]->m_volumeLeft );
-				// create right oscillator
-				oscs_r[i] = new Oscillator(
-						&m_osc[i]->m_waveShape,
-						&m_modulationAlgo,
-						_n->frequency(),
-						m_osc[i]->m_detuningRight,
-						static_cast<oscPtr *>( _n->m_pluginData )->phaseOffsetRight[i],
-						m_osc[i]->m_volumeRight );
-			}
-			else
-			{
-				// create left oscillator
-				oscs_l[i] = new Oscillator(
-						&m_osc[i]->m_waveShape,
-						&m_modulationAlgo,
-						_n->frequency(),
-						m_osc[i]->m_detuningLeft,
-						static_cast<oscPtr *>( _n->m_pluginData )->phaseOffsetLeft[i],
-						m_osc[i]->m_volumeLeft,
-						oscs_l[i + 1] );
-				// create right oscillator
-				oscs_r[i] = new Oscillator(
-						&m_osc[i]->m_waveShape,
-						&m_modulationAlgo,
-						_n->frequency(),
-						m_osc[i]->m_detuningRight,
-						static_cast<oscPtr *>( _n->m_pluginData )->phaseOffsetRight[i],
-						m_osc[i]->m_volumeRight,
-						oscs_r[i + 1] );
-			}
-			
-				
-		}
 
-		static_cast<oscPtr *>( _n->m_pluginData )->oscLeft = oscs_l[0];
-		static_cast<oscPtr *>( _n->m_pluginData )->oscRight = oscs_r[0];
+void organicInstrument::resetVoice( Voice * _v )
+{
+	// every note starts at other random phases
+	for( int i = 0; i < m_numOscillators; ++i )
+	{
+		_v->phaseOffsetLeft[i] = rand() / ( RAND_MAX + 1.0f );
+		_v->phaseOffsetRight[i] = rand() / ( RAND_MAX + 1.0f );
 	}
+	_v->oscLeft->reset();
+	_v->oscRight->reset();
+}
 
-	Oscillator * osc_l = static_cast<oscPtr *>( _n->m_pluginData )->oscLeft;
-	Oscillator * osc_r = static_cast<oscPtr *>( _n->m_pluginData)->oscRight;
+
+
+
+void organicInstrument::playNote( NotePlayHandle * _n,
+						sampleFrame * _working_buffer )
+{
+	const fpp_t frames = _n->framesLeftForCurrentPeriod();
+	const f_cnt_t offset = _n->noteOffset();
+
+	Voice * v = m_voices.voice( _n );
+	v->frequency = _n->frequency();
+
+	Oscillator * osc_l = v->oscLeft;
+	Oscillator * osc_r = v->oscRight;
 
 	osc_l->update( _working_buffer + offset, frames, 0 );
 	osc_r->update( _working_buffer + offset, frames, 1 );
@@ -324,12 +319,7 @@ void organicInstrument::playNote( NotePlayHandle * _n,
 
 void organicInstrument::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete static_cast<Oscillator *>( static_cast<oscPtr *>(
-						_n->m_pluginData )->oscLeft );
-	delete static_cast<Oscillator *>( static_cast<oscPtr *>(
-						_n->m_pluginData )->oscRight );
-	
-	delete static_cast<oscPtr *>( _n->m_pluginData );
+	m_voices.release( _n );
 }
 
 /*float inline organicInstrument::foldback(float in, float threshold)
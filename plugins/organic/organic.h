@@ -32,6 +32,7 @@
 #include "InstrumentView.h"
 #include "Oscillator.h"
 #include "AutomatableModel.h"
+#include "VoicePool.h"
 
 class QPixmap;
 
@@ -149,20 +150,35 @@ private:
 
 	OscillatorObject ** m_osc;
 
-	struct oscPtr
+	// the oscillators of a note, each of them owning the one it is
+	// modulated by
+	struct Voice
 	{
 		MM_OPERATORS
+		~Voice()
+		{
+			delete oscLeft;
+			delete oscRight;
+		}
+
+		// copied from the note every period, the oscillators refer to it
+		float frequency;
 		Oscillator * oscLeft;
 		Oscillator * oscRight;
 		float phaseOffsetLeft[NUM_OSCILLATORS];
-		float phaseOffsetRight[NUM_OSCILLATORS];		
+		float phaseOffsetRight[NUM_OSCILLATORS];
 	} ;
 
+	Voice * createVoice();
+	void resetVoice( Voice * _v );
+
 	const IntModel m_modulationAlgo;
 
 	FloatModel  m_fx1Model;
 	FloatModel  m_volModel;
 
+	VoicePool<Voice> m_voices;
+
 	virtual PluginView * instantiateView( QWidget * _parent );
 
 
@@ -95,6 +95,27 @@ SfxrSynth::~SfxrSynth()
 
 
 
+void SfxrSynth::reset()
+{
+	playing_sample = true;
+	resetSample( false );
+}
+
+
+
+
+sampleFrame * SfxrSynth::pitchedBuffer( int32_t frameNum )
+{
+	if( static_cast<size_t>( frameNum ) > pitched_buffer.size() )
+	{
+		pitched_buffer.resize( frameNum );
+	}
+	return pitched_buffer.data();
+}
+
+
+
+
 void SfxrSynth::resetSample( bool restart )
 {
 	if(!restart)
@@ -354,7 +375,9 @@ sfxrInstrument::sfxrInstrument( InstrumentTrack * _instrument_track ) :
 	m_lpFilResoModel(0.0f, this, "LP Filter Resonance"),
 	m_hpFilCutModel(0.0f, this, "HP Filter Cutoff"),
 	m_hpFilCutSweepModel(0.0f, this, "HP Filter Cutoff Sweep"),
-	m_waveFormModel( SQR_WAVE, 0, WAVES_NUM-1, this, tr( "Wave" ) )
+	m_waveFormModel( SQR_WAVE, 0, WAVES_NUM-1, this, tr( "Wave" ) ),
+	m_voices( [this]() { return new SfxrSynth( this ); },
+		[]( SfxrSynth * synth, NotePlayHandle * ) { synth->reset(); } )
 {
 }
 
@@ -459,11 +482,9 @@ void sfxrInstrument::playNote( NotePlayHandle * _n, sampleFrame * _working_buffe
 
     fpp_t frameNum = _n->framesLeftForCurrentPeriod();
     const f_cnt_t offset = _n->noteOffset();
-	if ( _n->totalFramesPlayed() == 0 || _n->m_pluginData == nullptr )
-	{
-		_n->m_pluginData = new SfxrSynth( this );
-	}
-	else if( static_cast<SfxrSynth*>(_n->m_pluginData)->isPlaying() == false )
+	const bool starting = _n->m_pluginData == nullptr;
+	SfxrSynth * synth = m_voices.voice( _n );
+	if( !starting && synth->isPlaying() == false )
 	{
 		memset(_working_buffer + offset, 0, sizeof(sampleFrame) * frameNum);
 		_n->noteOff();
@@ -478,8 +499,8 @@ void sfxrInstrument::playNote( NotePlayHandle * _n, sampleFrame * _working_buffe
 // debug code
 //	qDebug( "pFN %d", pitchedFrameNum );
 
-	sampleFrame * pitchedBuffer = new sampleFrame[pitchedFrameNum];
-	static_cast<SfxrSynth*>(_n->m_pluginData)->update( pitchedBuffer, pitchedFrameNum );
+	sampleFrame * pitchedBuffer = synth->pitchedBuffer( pitchedFrameNum );
+	synth->update( pitchedBuffer, pitchedFrameNum );
 	for( fpp_t i=0; i<frameNum; i++ )
 	{
 		for( ch_cnt_t j=0; j<DEFAULT_CHANNELS; j++ )
@@ -488,8 +509,6 @@ void sfxrInstrument::playNote( NotePlayHandle * _n, sampleFrame * _working_buffe
 		}
 	}
 
-	delete[] pitchedBuffer;
-
 	applyRelease( _working_buffer, _n );
 
 	instrumentTrack()->processAudioBuffer( _working_buffer, frameNum + offset, _n );
@@ -501,7 +520,7 @@ void sfxrInstrument::playNote( NotePlayHandle * _n, sampleFrame * _working_buffe
 
 void sfxrInstrument::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete static_cast<SfxrSynth *>( _n->m_pluginData );
+	m_voices.release( _n );
 }
 
 
@@ -28,6 +28,8 @@
 #ifndef SFXR_H
 #define SFXR_H
 
+#include <vector>
+
 #include "Instrument.h"
 #include "InstrumentView.h"
 #include "Knob.h"
@@ -35,6 +37,7 @@
 #include "PixmapButton.h"
 #include "LedCheckbox.h"
 #include "MemoryManager.h"
+#include "VoicePool.h"
 
 
 enum SfxrWaves
@@ -80,6 +83,12 @@ public:
 
 	bool isPlaying() const;
 
+	// start over for another note
+	void reset();
+
+	// buffer for rendering at the note's pitch, grown when a note needs more
+	sampleFrame * pitchedBuffer( int32_t frameNum );
+
 private:
 	const sfxrInstrument * s;
 	bool playing_sample;
@@ -118,6 +127,8 @@ private:
 	int arp_limit;
 	double arp_mod;
 
+	std::vector<sampleFrame> pitched_buffer;
+
 } ;
 
 
@@ -217,6 +228,8 @@ private:
 
 	IntModel m_waveFormModel;
 
+	VoicePool<SfxrSynth> m_voices;
+
 	friend class sfxrInstrumentView;
 	friend class SfxrSynth;
 };
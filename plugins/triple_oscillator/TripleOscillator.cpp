@@ -220,7 +220,10 @@ void OscillatorObject::updateUseWaveTable()
  
 
 TripleOscillator::TripleOscillator( InstrumentTrack * _instrument_track ) :
-	Instrument( _instrument_track, &tripleoscillator_plugin_descriptor )
+	Instrument( _instrument_track, &tripleoscillator_plugin_descriptor ),
+	m_voices( [this]() { return createVoice(); },
+		[this]( Voice * _v, NotePlayHandle * _n ) { resetVoice( _v, _n ); },
+		0 )
 {
 	for( int i = 0; i < NUM_OF_OSCILLATORS; ++i )
 	{
@@ -228,6 +231,9 @@ TripleOscillator::TripleOscillator( InstrumentTrack * _instrument_track ) :
 
 	}
 
+	// the voices refer to the oscillator objects
+	m_voices.reserve( DefaultPolyphony );
+
 	connect( Engine::audioEngine(), SIGNAL( sampleRateChanged() ),
 			this, SLOT( updateAllDetuning() ) );
 }
@@ -309,72 +315,70 @@ QString TripleOscillator::nodeName() const
 
 
 
-void TripleOscillator::playNote( NotePlayHandle * _n,
-						sampleFrame * _working_buffer )
+TripleOscillator::Voice * TripleOscillator::createVoice()
+{
+	Voice * v = new Voice;
+	v->frequency = 0.0f;
+	v->oscLeft = nullptr;
+	v->oscRight = nullptr;
+
+	// the last oscs need no sub-oscs, so start with them
+	for( int i = NUM_OF_OSCILLATORS - 1; i >= 0; --i )
+	{
+		v->oscLeft = new Oscillator(
+				&m_osc[i]->m_waveShapeModel,
+				&m_osc[i]->m_modulationAlgoModel,
+				v->frequency,
+				m_osc[i]->m_detuningLeft,
+				m_osc[i]->m_phaseOffsetLeft,
+				m_osc[i]->m_volumeLeft,
+				v->oscLeft );
+		v->oscRight = new Oscillator(
+				&m_osc[i]->m_waveShapeModel,
+				&m_osc[i]->m_modulationAlgoModel,
+				v->frequency,
+				m_osc[i]->m_detuningRight,
+				m_osc[i]->m_phaseOffsetRight,
+				m_osc[i]->m_volumeRight,
+				v->oscRight );
+	}
+	return v;
+}
+
+
+
+
+void TripleOscillator::resetVoice( Voice * _v, NotePlayHandle * )
 {
-	if( _n->totalFramesPlayed() == 0 || _n->m_pluginData == nullptr )
+	_v->oscLeft->reset();
+	_v->oscRight->reset();
+
+	// the wave table setting and the user wave may have changed since
+	// the voice played its last note
+	Oscillator * osc_l = _v->oscLeft;
+	Oscillator * osc_r = _v->oscRight;
+	for( int i = 0; i < NUM_OF_OSCILLATORS; ++i )
 	{
-		Oscillator * oscs_l[NUM_OF_OSCILLATORS];
-		Oscillator * oscs_r[NUM_OF_OSCILLATORS];
-
-		for( int i = NUM_OF_OSCILLATORS - 1; i >= 0; --i )
-		{
-
-			// the last oscs needs no sub-oscs...
-			if( i == NUM_OF_OSCILLATORS - 1 )
-			{
-				oscs_l[i] = new Oscillator(
-						&m_osc[i]->m_waveShapeModel,
-						&m_osc[i]->m_modulationAlgoModel,
-						_n->frequency(),
-						m_osc[i]->m_detuningLeft,
-						m_osc[i]->m_phaseOffsetLeft,
-						m_osc[i]->m_volumeLeft );
-				oscs_l[i]->setUseWaveTable(m_osc[i]->m_useWaveTable);
-				oscs_r[i] = new Oscillator(
-						&m_osc[i]->m_waveShapeModel,
-						&m_osc[i]->m_modulationAlgoModel,
-						_n->frequency(),
-						m_osc[i]->m_detuningRight,
-						m_osc[i]->m_phaseOffsetRight,
-						m_osc[i]->m_volumeRight );
-				oscs_r[i]->setUseWaveTable(m_osc[i]->m_useWaveTable);
-			}
-			else
-			{
-				oscs_l[i] = new Oscillator(
-						&m_osc[i]->m_waveShapeModel,
-						&m_osc[i]->m_modulationAlgoModel,
-						_n->frequency(),
-						m_osc[i]->m_detuningLeft,
-						m_osc[i]->m_phaseOffsetLeft,
-						m_osc[i]->m_volumeLeft,
-						oscs_l[i + 1] );
-				oscs_l[i]->setUseWaveTable(m_osc[i]->m_useWaveTable);
-				oscs_r[i] = new Oscillator(
-						&m_osc[i]->m_waveShapeModel,
-						&m_osc[i]->m_modulationAlgoModel,
-						_n->frequency(),
-						m_osc[i]->m_detuningRight,
-						m_osc[i]->m_phaseOffsetRight,
-						m_osc[i]->m_volumeRight,
-						oscs_r[i + 1] );
-				oscs_r[i]->setUseWaveTable(m_osc[i]->m_useWaveTable);
-			}
-
-			oscs_l[i]->setUserWave( m_osc[i]->m_sampleBuffer );
-			oscs_r[i]->setUserWave( m_osc[i]->m_sampleBuffer );
-
-		}
-
-		_n->m_pluginData = new oscPtr;
-		static_cast<oscPtr *>( _n->m_pluginData )->oscLeft = oscs_l[0];
-		static_cast< oscPtr *>( _n->m_pluginData )->oscRight =
-								oscs_r[0];
+		osc_l->setUseWaveTable( m_osc[i]->m_useWaveTable );
+		osc_r->setUseWaveTable( m_osc[i]->m_useWaveTable );
+		osc_l->setUserWave( m_osc[i]->m_sampleBuffer );
+		osc_r->setUserWave( m_osc[i]->m_sampleBuffer );
+		osc_l = osc_l->subOsc();
+		osc_r = osc_r->subOsc();
 	}
+}
+
+
+
+
+void TripleOscillator::playNote( NotePlayHandle * _n,
+						sampleFrame * _working_buffer )
+{
+	Voice * v = m_voices.voice( _n );
+	v->frequency = _n->frequency();
 
-	Oscillator * osc_l = static_cast<oscPtr *>( _n->m_pluginData )->oscLeft;
-	Oscillator * osc_r = static_cast<oscPtr *>( _n->m_pluginData )->oscRight;
+	Oscillator * osc_l = v->oscLeft;
+	Oscillator * osc_r = v->oscRight;
 
 	const fpp_t frames = _n->framesLeftForCurrentPeriod();
 	const f_cnt_t offset = _n->noteOffset();
@@ -393,11 +397,7 @@ void TripleOscillator::playNote( NotePlayHandle * _n,
 
 void TripleOscillator::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete static_cast<Oscillator *>( static_cast<oscPtr *>(
-						_n->m_pluginData )->oscLeft );
-	delete static_cast<Oscillator *>( static_cast<oscPtr *>(
-						_n->m_pluginData )->oscRight );
-	delete static_cast<oscPtr *>( _n->m_pluginData );
+	m_voices.release( _n );
 }
 
 
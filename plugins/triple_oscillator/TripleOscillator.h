@@ -30,6 +30,7 @@
 #include "InstrumentView.h"
 #include "Oscillator.h"
 #include "AutomatableModel.h"
+#include "VoicePool.h"
 
 
 class automatableButtonGroup;
@@ -125,13 +126,28 @@ protected slots:
 private:
 	OscillatorObject * m_osc[NUM_OF_OSCILLATORS];
 
-	struct oscPtr
+	// the oscillators of a note, each of them owning the one it is
+	// modulated by
+	struct Voice
 	{
 		MM_OPERATORS
+		~Voice()
+		{
+			delete oscLeft;
+			delete oscRight;
+		}
+
+		// copied from the note every period, the oscillators refer to it
+		float frequency;
 		Oscillator * oscLeft;
 		Oscillator * oscRight;
 	} ;
 
+	Voice * createVoice();
+	void resetVoice( Voice * _v, NotePlayHandle * _n );
+
+	VoicePool<Voice> m_voices;
+
 
 	friend class TripleOscillatorView;
 
@@ -374,6 +374,11 @@ void vestigeInstrument::loadFile( const QString & _file )
 		m_plugin->showUI();
 	}
 
+	// let the plugin render the next period while the engine goes on,
+	// the other tracks are delayed to match
+	m_plugin->setPipelined( RemotePlugin::pipeliningEnabled() );
+	instrumentTrack()->audioPort()->setLatency( m_plugin->latency() );
+
 	if( set_ch_name )
 	{
 		instrumentTrack()->setName( m_plugin->name() );
@@ -469,6 +474,7 @@ void vestigeInstrument::closePlugin( void )
 	m_pluginMutex.lock();
 	delete m_plugin;
 	m_plugin = nullptr;
+	instrumentTrack()->audioPort()->setLatency( 0 );
 	m_pluginMutex.unlock();
 }
 
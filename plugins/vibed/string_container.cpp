@@ -25,16 +25,15 @@
 #include "string_container.h"
 
 
-stringContainer::stringContainer(const float _pitch, 
-				const sample_rate_t _sample_rate,
-				const int _buffer_length,
-				const int _strings ) :
-	m_pitch( _pitch ),
-	m_sampleRate( _sample_rate ),
-	m_bufferLength( _buffer_length )
+stringContainer::stringContainer( const int _strings, const int _capacity ) :
+	m_count( 0 ),
+	m_pitch( 0 ),
+	m_sampleRate( 0 ),
+	m_bufferLength( 0 )
 {
 	for( int i = 0; i < _strings; i++ )
 	{
+		m_strings.append( new vibratingString( _capacity ) );
 		m_exists.append( false );
 	}
 }
@@ -42,6 +41,20 @@ stringContainer::stringContainer(const float _pitch,
 
 
 
+void stringContainer::reset( const float _pitch,
+				const sample_rate_t _sample_rate,
+				const int _buffer_length )
+{
+	m_pitch = _pitch;
+	m_sampleRate = _sample_rate;
+	m_bufferLength = _buffer_length;
+	m_count = 0;
+	m_exists.fill( false );
+}
+
+
+
+
 void stringContainer::addString(int _harm,
 				const float _pick,
 				const float _pickup,
@@ -87,16 +100,16 @@ void stringContainer::addString(int _harm,
 			harm = 1.0f;
 	}
 
-	m_strings.append( new vibratingString(	m_pitch * harm,
+	m_strings[m_count++]->reset(	m_pitch * harm,
 						_pick, 
 						_pickup,
-						const_cast<float*>(_impulse),
+						_impulse,
 						m_bufferLength,
 						m_sampleRate,
 						_oversample,
 						_randomize,
 						_string_loss,
 						_detune,
-						_state ) );
+						_state );
 	m_exists[_id] = true;
 }
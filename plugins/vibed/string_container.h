@@ -34,10 +34,12 @@ class stringContainer
 {
 	MM_OPERATORS
 public:
-	stringContainer(const float _pitch, 
+	stringContainer( const int _strings, const int _capacity );
+
+	// remove the strings of the previous note
+	void reset( const float _pitch,
 			const sample_rate_t _sample_rate,
-			const int _buffer_length,
-			const int _strings = 9 );
+			const int _buffer_length );
 	
 	void addString(	int _harm,
 			const float _pick,
@@ -57,10 +59,9 @@ public:
 	
 	~stringContainer()
 	{
-		int strings = m_strings.count();
-		for( int i = 0; i < strings; i++ )
+		for( vibratingString * string : m_strings )
 		{
-			delete m_strings[i];
+			delete string;
 		}
 	}
 	
@@ -70,10 +71,12 @@ public:
 	}
 	
 private:
+	// created once, the first m_count of them are plucked
 	QVector<vibratingString *> m_strings;
-	const float m_pitch;
-	const sample_rate_t m_sampleRate;
-	const int m_bufferLength;
+	int m_count;
+	float m_pitch;
+	sample_rate_t m_sampleRate;
+	int m_bufferLength;
 	QVector<bool> m_exists;
 } ;
 
@@ -62,7 +62,16 @@ Plugin::Descriptor PLUGIN_EXPORT vibedstrings_plugin_descriptor =
 
 
 vibed::vibed( InstrumentTrack * _instrumentTrack ) :
-	Instrument( _instrumentTrack, &vibedstrings_plugin_descriptor )
+	Instrument( _instrumentTrack, &vibedstrings_plugin_descriptor ),
+	m_voices( []()
+		{
+			// oversampled twice at the shortest string length, 10% detuned
+			const int capacity = static_cast<int>( 2.2f *
+					Engine::audioEngine()->baseSampleRate() /
+					LowestPreallocatedPitch ) + 1;
+			return new stringContainer( 9, capacity );
+		},
+		[this]( stringContainer * ps, NotePlayHandle * n ) { resetVoice( ps, n ); } )
 {
 
 	FloatModel * knob;
@@ -271,20 +280,17 @@ QString vibed::nodeName() const
 
 
 
-void vibed::playNote( NotePlayHandle * _n, sampleFrame * _working_buffer )
+void vibed::resetVoice( stringContainer * _ps, NotePlayHandle * _n )
 {
-	if ( _n->totalFramesPlayed() == 0 || _n->m_pluginData == nullptr )
+	_ps->reset( _n->frequency(),
+			Engine::audioEngine()->processingSampleRate(),
+			__sampleLength );
+
+	for( int i = 0; i < 9; ++i )
 	{
-		_n->m_pluginData = new stringContainer( _n->frequency(),
-				Engine::audioEngine()->processingSampleRate(),
-						__sampleLength );
-		
-		for( int i = 0; i < 9; ++i )
+		if( m_powerButtons[i]->value() )
 		{
-			if( m_powerButtons[i]->value() )
-			{
-				static_cast<stringContainer*>(
-					_n->m_pluginData )->addString(
+			_ps->addString(
 				m_harmonics[i]->value(),
 				m_pickKnobs[i]->value(),
 				m_pickupKnobs[i]->value(),
@@ -296,14 +302,18 @@ void vibed::playNote( NotePlayHandle * _n, sampleFrame * _working_buffer )
 					m_lengthKnobs[i]->value() ),
 				m_impulses[i]->value(),
 				i );
-			}
 		}
 	}
+}
+
+
 
+
+void vibed::playNote( NotePlayHandle * _n, sampleFrame * _working_buffer )
+{
 	const fpp_t frames = _n->framesLeftForCurrentPeriod();
 	const f_cnt_t offset = _n->noteOffset();
-	stringContainer * ps = static_cast<stringContainer *>(
-							_n->m_pluginData );
+	stringContainer * ps = m_voices.voice( _n );
 
 	for( fpp_t i = offset; i < frames + offset; ++i )
 	{
@@ -332,7 +342,7 @@ void vibed::playNote( NotePlayHandle * _n, sampleFrame * _working_buffer )
 
 void vibed::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete static_cast<stringContainer *>( _n->m_pluginData );
+	m_voices.release( _n );
 }
 
 
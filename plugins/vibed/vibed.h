@@ -31,6 +31,8 @@
 #include "PixmapButton.h"
 #include "LedCheckbox.h"
 #include "nine_button_selector.h"
+#include "string_container.h"
+#include "VoicePool.h"
 
 class vibedView;
 class NotePlayHandle;
@@ -62,6 +64,9 @@ public:
 
 
 private:
+	// pluck the strings which are turned on for another note
+	void resetVoice( stringContainer * _ps, NotePlayHandle * _n );
+
 	QList<FloatModel*> m_pickKnobs;
 	QList<FloatModel*> m_pickupKnobs;
 	QList<FloatModel*> m_stiffnessKnobs;
@@ -76,6 +81,11 @@ private:
 	QList<nineButtonSelectorModel*> m_harmonics;
 
 	static const int __sampleLength = 128;
+	// strings are preallocated for notes down to this frequency at the
+	// shortest string length, only lower ones make a voice grow them
+	static constexpr float LowestPreallocatedPitch = 27.5f;
+
+	VoicePool<stringContainer> m_voices;
 
 	friend class vibedView;
 } ;
@@ -29,24 +29,49 @@
 #include "Engine.h"
 
 
-vibratingString::vibratingString(	float _pitch, 
+vibratingString::vibratingString( int _capacity ) :
+	m_fromBridge{ new sample_t[_capacity], _capacity, 0, nullptr, nullptr },
+	m_toBridge{ new sample_t[_capacity], _capacity, 0, nullptr, nullptr },
+	m_pickupLoc( 0 ),
+	m_oversample( 0 ),
+	m_randomize( 0 ),
+	m_stringLoss( 1.0f ),
+	m_impulse( new float[_capacity] ),
+	m_impulseSize( _capacity ),
+	m_choice( 0 ),
+	m_state( 0.1f ),
+	m_outsamp( new sample_t[MaxOversample] ),
+	m_outsampSize( MaxOversample )
+{
+}
+
+
+
+
+void vibratingString::reset(	float _pitch,
 					float _pick,
 					float _pickup,
-					float * _impulse, 
+					const float * _impulse,
 					int _len,
 					sample_rate_t _sample_rate,
 					int _oversample,
 					float _randomize,
 					float _string_loss,
 					float _detune,
-					bool _state ) :
-	m_oversample( 2 * _oversample / (int)( _sample_rate /
-				Engine::audioEngine()->baseSampleRate() ) ),
-	m_randomize( _randomize ),
-	m_stringLoss( 1.0f - _string_loss ),
-	m_state( 0.1f )
+					bool _state )
 {
-	m_outsamp = new sample_t[m_oversample];
+	m_oversample = 2 * _oversample / (int)( _sample_rate /
+				Engine::audioEngine()->baseSampleRate() );
+	m_randomize = _randomize;
+	m_stringLoss = 1.0f - _string_loss;
+	m_state = 0.1f;
+
+	if( m_oversample > m_outsampSize )
+	{
+		delete[] m_outsamp;
+		m_outsamp = new sample_t[m_oversample];
+		m_outsampSize = m_oversample;
+	}
 	int string_length;
 	
 	string_length = static_cast<int>( m_oversample * _sample_rate /
@@ -55,28 +80,33 @@ vibratingString::vibratingString(	float _pitch,
 
 	int pick = static_cast<int>( ceil( string_length * _pick ) );
 	
+	const int impulse_length = _state ? _len : string_length;
+	if( impulse_length > m_impulseSize )
+	{
+		delete[] m_impulse;
+		m_impulse = new float[impulse_length];
+		m_impulseSize = impulse_length;
+	}
 	if( ! _state )
 	{
-		m_impulse = new float[string_length];
 		resample( _impulse, _len, string_length );
 	}
 	else
  	{
-		m_impulse = new float[_len];
 		for( int i = 0; i < _len; i++ )
 		{
 			m_impulse[i] = _impulse[i];
 		}
 	}
 	
-	m_toBridge = vibratingString::initDelayLine( string_length, pick );
-	m_fromBridge = vibratingString::initDelayLine( string_length, pick );
+	initDelayLine( &m_toBridge, string_length );
+	initDelayLine( &m_fromBridge, string_length );
 
 	
-	vibratingString::setDelayLine( m_toBridge, pick, 
+	vibratingString::setDelayLine( &m_toBridge, pick, 
 						m_impulse, _len, 0.5f, 
 						_state );
-	vibratingString::setDelayLine( m_fromBridge, pick, 
+	vibratingString::setDelayLine( &m_fromBridge, pick, 
 						m_impulse, _len, 0.5f,
 						_state);
 	
@@ -89,52 +119,37 @@ vibratingString::vibratingString(	float _pitch,
 
 
 
-vibratingString::delayLine * vibratingString::initDelayLine( int _len,
-								int _pick )
+void vibratingString::initDelayLine( delayLine * _dl, int _len )
 {
-	delayLine * dl = new vibratingString::delayLine[_len];
-	dl->length = _len;
+	_dl->length = _len;
 	if( _len > 0 )
 	{
-		dl->data = new sample_t[_len];
+		if( _len > _dl->capacity )
+		{
+			delete[] _dl->data;
+			_dl->data = new sample_t[_len];
+			_dl->capacity = _len;
+		}
 		float r;
 		float offset = 0.0f;
-		for( int i = 0; i < dl->length; i++ )
+		for( int i = 0; i < _dl->length; i++ )
 		{
 			r = static_cast<float>( rand() ) /
 					RAND_MAX;
 			offset =  ( m_randomize / 2.0f -
 					m_randomize ) * r;
-			dl->data[i] = offset;
+			_dl->data[i] = offset;
 		}
 	}
-	else
-	{
-		dl->data = nullptr;
-	}
-
-	dl->pointer = dl->data;
-	dl->end = dl->data + _len - 1;
-
-	return( dl );
-}
 
-
-
-
-void vibratingString::freeDelayLine( delayLine * _dl )
-{
-	if( _dl )
-	{
-		delete[] _dl->data;
-		delete[] _dl;
-	}
+	_dl->pointer = _dl->data;
+	_dl->end = _dl->data + _len - 1;
 }
 
 
 
 
-void vibratingString::resample( float *_src, f_cnt_t _src_frames,
+void vibratingString::resample( const float *_src, f_cnt_t _src_frames,
 							 f_cnt_t _dst_frames )
 {
 	for( f_cnt_t frame = 0; frame < _dst_frames; ++frame )
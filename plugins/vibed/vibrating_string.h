@@ -33,10 +33,23 @@ class vibratingString
 {
 
 public:
-	vibratingString(	float _pitch, 
-				float _pick, 
+	// the buffers are allocated for strings of up to @p _capacity samples
+	vibratingString( int _capacity );
+
+	inline ~vibratingString()
+	{
+		delete[] m_outsamp;
+		delete[] m_impulse;
+		delete[] m_fromBridge.data;
+		delete[] m_toBridge.data;
+	}
+
+	// pluck the string for another note, the buffers are only reallocated
+	// if they are too short for it
+	void reset(	float _pitch,
+				float _pick,
 				float _pickup,
-				float * impluse,
+				const float * _impulse,
 				int _len,
 				sample_rate_t _sample_rate,
 				int _oversample,
@@ -44,14 +57,6 @@ public:
 				float _string_loss,
 				float _detune,
 				bool _state );
-	
-	inline ~vibratingString()
-	{
-		delete[] m_outsamp;
-		delete[] m_impulse;
-		vibratingString::freeDelayLine( m_fromBridge );
-		vibratingString::freeDelayLine( m_toBridge );
-	}
 
 	inline sample_t nextSample()
 	{	
@@ -60,24 +65,24 @@ public:
 		for( int i = 0; i < m_oversample; i++)
 		{
 			// Output at pickup position
-			m_outsamp[i] = fromBridgeAccess( m_fromBridge, 
+			m_outsamp[i] = fromBridgeAccess( &m_fromBridge, 
 								m_pickupLoc );
-			m_outsamp[i] += toBridgeAccess( m_toBridge, 
+			m_outsamp[i] += toBridgeAccess( &m_toBridge, 
 								m_pickupLoc );
 		
 			// Sample traveling into "bridge"
-			ym0 = toBridgeAccess( m_toBridge, 1 );
+			ym0 = toBridgeAccess( &m_toBridge, 1 );
 			// Sample to "nut"
-			ypM = fromBridgeAccess( m_fromBridge,
-						m_fromBridge->length - 2 );
+			ypM = fromBridgeAccess( &m_fromBridge,
+						m_fromBridge.length - 2 );
 
 			// String state update
 
 			// Decrement pointer and then update
-			fromBridgeUpdate( m_fromBridge, 
+			fromBridgeUpdate( &m_fromBridge, 
 						-bridgeReflection( ym0 ) );
 			// Update and then increment pointer
-			toBridgeUpdate( m_toBridge, -ypM );
+			toBridgeUpdate( &m_toBridge, -ypM );
 		}
 		return( m_outsamp[m_choice] );
 	}
@@ -86,27 +91,31 @@ private:
 	struct delayLine
 	{
 		sample_t * data;
+		int capacity;
 		int length;
 		sample_t * pointer;
 		sample_t * end;
 	} ;
 
-	delayLine * m_fromBridge;
-	delayLine * m_toBridge;
+	delayLine m_fromBridge;
+	delayLine m_toBridge;
 	int m_pickupLoc;
 	int m_oversample;
 	float m_randomize;
 	float m_stringLoss;
 	
 	float * m_impulse;
+	int m_impulseSize;
 	int m_choice;
 	float m_state;
 	
+	// for the longest string length
+	static constexpr int MaxOversample = 32;
 	sample_t * m_outsamp;
+	int m_outsampSize;
 
-	delayLine * initDelayLine( int _len, int _pick );
-	static void freeDelayLine( delayLine * _dl );
-	void resample( float *_src, f_cnt_t _src_frames, f_cnt_t _dst_frames );
+	void initDelayLine( delayLine * _dl, int _len );
+	void resample( const float *_src, f_cnt_t _src_frames, f_cnt_t _dst_frames );
 	
 	/* setDelayLine initializes the string with an impulse at the pick
 	 * position unless the impulse is longer than the string, in which
@@ -59,19 +59,36 @@ Plugin::Descriptor PLUGIN_EXPORT watsyn_plugin_descriptor =
 
 
 
-WatsynObject::WatsynObject( float * _A1wave, float * _A2wave,
-					float * _B1wave, float * _B2wave,
-					int _amod, int _bmod, const sample_rate_t _samplerate, NotePlayHandle * _nph, fpp_t _frames,
-					WatsynInstrument * _w ) :
-				m_amod( _amod ),
-				m_bmod( _bmod ),
-				m_samplerate( _samplerate ),
-				m_nph( _nph ),
-				m_fpp( _frames ),
-				m_parent( _w )
+WatsynObject::WatsynObject( WatsynInstrument * _w ) :
+				m_amod( 0 ),
+				m_bmod( 0 ),
+				m_samplerate( 0 ),
+				m_nph( nullptr ),
+				m_fpp( Engine::audioEngine()->framesPerPeriod() ),
+				m_parent( _w ),
+				m_abuf( new sampleFrame[m_fpp] ),
+				m_bbuf( new sampleFrame[m_fpp] )
 {
-	m_abuf = new sampleFrame[_frames];
-	m_bbuf = new sampleFrame[_frames];
+}
+
+
+
+WatsynObject::~WatsynObject()
+{
+	delete[] m_abuf;
+	delete[] m_bbuf;
+}
+
+
+
+void WatsynObject::reset( const float * _A1wave, const float * _A2wave,
+					const float * _B1wave, const float * _B2wave,
+					int _amod, int _bmod, const sample_rate_t _samplerate, NotePlayHandle * _nph )
+{
+	m_amod = _amod;
+	m_bmod = _bmod;
+	m_samplerate = _samplerate;
+	m_nph = _nph;
 
 	m_lphase[A1_OSC] = 0.0f;
 	m_lphase[A2_OSC] = 0.0f;
@@ -92,21 +109,8 @@ WatsynObject::WatsynObject( float * _A1wave, float * _A2wave,
 }
 
 
-
-WatsynObject::~WatsynObject()
-{
-	delete[] m_abuf;
-	delete[] m_bbuf;
-}
-
-
 void WatsynObject::renderOutput( fpp_t _frames )
 {
-	if( m_abuf == nullptr )
-		m_abuf = new sampleFrame[m_fpp];
-	if( m_bbuf == nullptr )
-		m_bbuf = new sampleFrame[m_fpp];
-
 	for( fpp_t frame = 0; frame < _frames; frame++ )
 	{
 		// put phases of 1-series oscs into variables because phase modulation might happen
@@ -273,7 +277,15 @@ WatsynInstrument::WatsynInstrument( InstrumentTrack * _instrument_track ) :
 		m_amod( 0, 0, 3, this, tr( "A2-A1 modulation" ) ),
 		m_bmod( 0, 0, 3, this, tr( "B2-B1 modulation" ) ),
 
-		m_selectedGraph( 0, 0, 3, this, tr( "Selected graph" ) )
+		m_selectedGraph( 0, 0, 3, this, tr( "Selected graph" ) ),
+
+		m_voices( [this]() { return new WatsynObject( this ); },
+			[this]( WatsynObject * w, NotePlayHandle * n )
+			{
+				w->reset( &A1_wave[0], &A2_wave[0], &B1_wave[0], &B2_wave[0],
+					m_amod.value(), m_bmod.value(),
+					Engine::audioEngine()->processingSampleRate(), n );
+			} )
 {
 	connect( &a1_vol, SIGNAL( dataChanged() ), this, SLOT( updateVolumes() ) );
 	connect( &a2_vol, SIGNAL( dataChanged() ), this, SLOT( updateVolumes() ) );
@@ -330,25 +342,11 @@ WatsynInstrument::~WatsynInstrument()
 void WatsynInstrument::playNote( NotePlayHandle * _n,
 						sampleFrame * _working_buffer )
 {
-	if ( _n->totalFramesPlayed() == 0 || _n->m_pluginData == nullptr )
-	{
-		WatsynObject * w = new WatsynObject(
-				&A1_wave[0],
-				&A2_wave[0],
-				&B1_wave[0],
-				&B2_wave[0],
-				m_amod.value(), m_bmod.value(),
-				Engine::audioEngine()->processingSampleRate(), _n,
-				Engine::audioEngine()->framesPerPeriod(), this );
-
-		_n->m_pluginData = w;
-	}
-
 	const fpp_t frames = _n->framesLeftForCurrentPeriod();
 	const f_cnt_t offset = _n->noteOffset();
 	sampleFrame * buffer = _working_buffer + offset;
 
-	WatsynObject * w = static_cast<WatsynObject *>( _n->m_pluginData );
+	WatsynObject * w = m_voices.voice( _n );
 
 	sampleFrame * abuf = w->abuf();
 	sampleFrame * bbuf = w->bbuf();
@@ -459,7 +457,7 @@ void WatsynInstrument::playNote( NotePlayHandle * _n,
 
 void WatsynInstrument::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete static_cast<WatsynObject *>( _n->m_pluginData );
+	m_voices.release( _n );
 }
 
 
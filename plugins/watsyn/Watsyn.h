@@ -36,6 +36,7 @@
 #include "PixmapButton.h"
 #include <samplerate.h>
 #include "MemoryManager.h"
+#include "VoicePool.h"
 
 
 #define makeknob( name, x, y, hint, unit, oname ) 		\
@@ -83,12 +84,14 @@ class WatsynObject
 {
 	MM_OPERATORS
 public:
-	WatsynObject( 	float * _A1wave, float * _A2wave,
-					float * _B1wave, float * _B2wave,
-					int _amod, int _bmod, const sample_rate_t _samplerate, NotePlayHandle * _nph, fpp_t _frames,
-					WatsynInstrument * _w );
+	WatsynObject( WatsynInstrument * _w );
 	virtual ~WatsynObject();
 
+	// prepare for playing _nph from the start
+	void reset( 	const float * _A1wave, const float * _A2wave,
+					const float * _B1wave, const float * _B2wave,
+					int _amod, int _bmod, const sample_rate_t _samplerate, NotePlayHandle * _nph );
+
 	void renderOutput( fpp_t _frames );
 
 	inline sampleFrame * abuf() const
@@ -108,7 +111,7 @@ private:
 	int m_amod;
 	int m_bmod;
 
-	const sample_rate_t m_samplerate;
+	sample_rate_t m_samplerate;
 	NotePlayHandle * m_nph;
 
 	fpp_t m_fpp;
@@ -288,6 +291,8 @@ private:
 	float B1_wave [WAVELEN];
 	float B2_wave [WAVELEN];
 
+	VoicePool<WatsynObject> m_voices;
+
 	friend class WatsynObject;
 	friend class WatsynView;
 };
@@ -97,13 +97,18 @@ bool waveShaperEffect::processAudioBuffer( sampleFrame * _buf,
 	const float *inputPtr = inputBuffer ? &( inputBuffer->values()[ 0 ] ) : &input;
 	const float *outputPtr = outputBufer ? &( outputBufer->values()[ 0 ] ) : &output;
 
+	// value buffers hold one value per frame at the engine's rate
+	const int oversampling = oversamplingFactor();
+
 	for( fpp_t f = 0; f < _frames; ++f )
 	{
 		float s[2] = { _buf[f][0], _buf[f][1] };
+		const float inputGain = inputPtr[ ( f / oversampling ) * inputInc ];
+		const float outputGain = outputPtr[ ( f / oversampling ) * outputInc ];
 
 // apply input gain
-		s[0] *= *inputPtr;
-		s[1] *= *inputPtr;
+		s[0] *= inputGain;
+		s[1] *= inputGain;
 
 // clip if clip enabled
 		if( clip )
@@ -137,16 +142,13 @@ bool waveShaperEffect::processAudioBuffer( sampleFrame * _buf,
 		}
 
 // apply output gain
-		s[0] *= *outputPtr;
-		s[1] *= *outputPtr;
+		s[0] *= outputGain;
+		s[1] *= outputGain;
 
 // mix wet/dry signals
 		_buf[f][0] = d * _buf[f][0] + w * s[0];
 		_buf[f][1] = d * _buf[f][1] + w * s[1];
 		out_sum += _buf[f][0] * _buf[f][0] + _buf[f][1] * _buf[f][1];
-
-		outputPtr += outputInc;
-		inputPtr += inputInc;
 	}
 
 	checkGate( out_sum / _frames );
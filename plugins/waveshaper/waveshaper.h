@@ -41,6 +41,12 @@ public:
 	virtual bool processAudioBuffer( sampleFrame * _buf,
 							const fpp_t _frames );
 
+	// memoryless, so it runs at any rate, but aliases a lot
+	virtual bool supportsOversampling() const
+	{
+		return true;
+	}
+
 	virtual EffectControls * controls()
 	{
 		return( &m_wsControls );
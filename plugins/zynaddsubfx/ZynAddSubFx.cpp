@@ -465,12 +465,18 @@ void ZynAddSubFxInstrument::initPlugin()
 
 		m_remotePlugin->showUI();
 		m_remotePlugin->unlock();
+
+		// let the remote process render the next period while the engine
+		// goes on, the other tracks are delayed to match
+		m_remotePlugin->setPipelined( RemotePlugin::pipeliningEnabled() );
+		instrumentTrack()->audioPort()->setLatency( m_remotePlugin->latency() );
 	}
 	else
 	{
 		m_plugin = new LocalZynAddSubFx;
 		m_plugin->setSampleRate( Engine::audioEngine()->processingSampleRate() );
 		m_plugin->setBufferSize( Engine::audioEngine()->framesPerPeriod() );
+		instrumentTrack()->audioPort()->setLatency( 0 );
 	}
 
 	m_pluginMutex.unlock();
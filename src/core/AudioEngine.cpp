@@ -39,6 +39,7 @@
 #include "EnvelopeAndLfoParameters.h"
 #include "NotePlayHandle.h"
 #include "ConfigManager.h"
+#include "LocklessRingBuffer.h"
 #include "SamplePlayHandle.h"
 #include "MemoryHelper.h"
 
@@ -62,6 +63,7 @@
 #include "MidiWinMM.h"
 #include "MidiApple.h"
 #include "MidiDummy.h"
+#include "MidiPort.h"
 
 #include "BufferManager.h"
 
@@ -75,9 +77,15 @@ static thread_local bool s_renderingThread;
 
 AudioEngine::AudioEngine( bool renderOnly ) :
 	m_renderOnly( renderOnly ),
+	m_maxLatency( 0 ),
+	m_lastPeriodStart( MidiClock::now() ),
 	m_framesPerPeriod( DEFAULT_BUFFER_SIZE ),
-	m_inputBufferRead( 0 ),
-	m_inputBufferWrite( 1 ),
+	m_framesPerPeriodFixed( false ),
+	m_inputBuffer( nullptr ),
+	m_recordBuffer( nullptr ),
+	m_inputBufferFrames( 0 ),
+	m_inputBlockFrames( 0 ),
+	m_inputOverruns( 0 ),
 	m_outputBufferRead(nullptr),
 	m_outputBufferWrite(nullptr),
 	m_workers(),
@@ -91,6 +99,7 @@ AudioEngine::AudioEngine( bool renderOnly ) :
 	m_oldAudioDev( nullptr ),
 	m_audioDevStartFailed( false ),
 	m_profiler(),
+	m_voiceLimiter(),
 	m_metronomeActive(false),
 	m_clearSignal( false ),
 	m_changesSignal( false ),
@@ -98,17 +107,6 @@ AudioEngine::AudioEngine( bool renderOnly ) :
 	m_doChangesMutex( QMutex::Recursive ),
 	m_waitingForWrite( false )
 {
-	for( int i = 0; i < 2; ++i )
-	{
-		m_inputBufferFrames[i] = 0;
-		m_inputBufferSize[i] = DEFAULT_BUFFER_SIZE;
-		m_inputBuffer[i] = new sampleFrame[ DEFAULT_BUFFER_SIZE];
-		BufferManager::clear( m_inputBuffer[i], m_inputBufferSize[i] );
-	}
-
-	inputFrameBuffer = new sampleFrame[ DEFAULT_BUFFER_SIZE];
-	BufferManager::clear( inputFrameBuffer, DEFAULT_BUFFER_SIZE );
-
 	// determine FIFO size and number of frames per period
 	int fifoSize = 1;
 
@@ -143,6 +141,15 @@ AudioEngine::AudioEngine( bool renderOnly ) :
 	// now that framesPerPeriod is fixed initialize global BufferManager
 	BufferManager::init( m_framesPerPeriod );
 
+	// enough for the largest device buffers plus the periods the FIFO
+	// renders ahead
+	m_inputRing.reset( new LocklessRingBuffer<sampleFrame>( 16384 ) );
+	m_inputReader.reset( new LocklessRingBufferReader<sampleFrame>( *m_inputRing ) );
+	m_recordReader.reset( new LocklessRingBufferReader<sampleFrame>( *m_inputRing ) );
+	m_inputBuffer = new sampleFrame[m_framesPerPeriod];
+	BufferManager::clear( m_inputBuffer, m_framesPerPeriod );
+	m_recordBuffer = new sampleFrame[m_framesPerPeriod];
+
 	int outputBufferSize = m_framesPerPeriod * sizeof(surroundSampleFrame);
 	m_outputBufferRead = static_cast<surroundSampleFrame *>(MemoryHelper::alignedMalloc(outputBufferSize));
 	m_outputBufferWrite = static_cast<surroundSampleFrame *>(MemoryHelper::alignedMalloc(outputBufferSize));
@@ -192,10 +199,8 @@ AudioEngine::~AudioEngine()
 	MemoryHelper::alignedFree(m_outputBufferRead);
 	MemoryHelper::alignedFree(m_outputBufferWrite);
 
-	for( int i = 0; i < 2; ++i )
-	{
-		delete[] m_inputBuffer[i];
-	}
+	delete[] m_inputBuffer;
+	delete[] m_recordBuffer;
 }
 
 
@@ -213,6 +218,7 @@ void AudioEngine::initDevices()
 		m_audioDev = tryAudioDevices();
 		m_midiClient = tryMidiClients();
 	}
+	m_framesPerPeriodFixed = true;
 	// Loading audio device may have changed the sample rate
 	emit sampleRateChanged();
 }
@@ -220,6 +226,19 @@ void AudioEngine::initDevices()
 
 
 
+void AudioEngine::requestFramesPerPeriod( fpp_t frames )
+{
+	// the buffers are allocated for the configured size, so periods can
+	// only get shorter
+	if( !m_framesPerPeriodFixed )
+	{
+		m_framesPerPeriod = qBound( MINIMUM_BUFFER_SIZE, frames, m_framesPerPeriod );
+	}
+}
+
+
+
+
 void AudioEngine::startProcessing(bool needsFifo)
 {
 	if (needsFifo)
@@ -308,41 +327,67 @@ bool AudioEngine::criticalXRuns() const
 
 
 
-void AudioEngine::pushInputFrames( sampleFrame * _ab, const f_cnt_t _frames )
+void AudioEngine::pushInputFrames( const sampleFrame * _ab, const f_cnt_t _frames )
 {
-	requestChangeInModel();
+	m_inputRing->write( _ab, _frames );
 
-	f_cnt_t frames = m_inputBufferFrames[ m_inputBufferWrite ];
-	int size = m_inputBufferSize[ m_inputBufferWrite ];
-	sampleFrame * buf = m_inputBuffer[ m_inputBufferWrite ];
-
-	if( frames + _frames > size )
+	// only the capturing thread writes it
+	if( _frames > m_inputBlockFrames )
 	{
-		size = qMax( size * 2, frames + _frames );
-		sampleFrame * ab = new sampleFrame[ frames + size ];
-		memcpy( ab, buf, frames * sizeof( sampleFrame ) );
-		delete [] buf;
-
-		m_inputBufferSize[ m_inputBufferWrite ] = size;
-		m_inputBuffer[ m_inputBufferWrite ] = ab;
-		buf = ab;
+		m_inputBlockFrames = _frames;
 	}
+}
 
-	memcpy( &buf[ frames ], _ab, _frames * sizeof( sampleFrame ) );
-	m_inputBufferFrames[ m_inputBufferWrite ] += _frames;
 
-	doneChangeInModel();
-}
 
-void AudioEngine::addInputFrames(sampleFrame* _data, const f_cnt_t _frames)
+
+void AudioEngine::readInput()
 {
-	//requestChangeInModel();
-	for( PlayHandle * e : m_recordHandles )
+	// recording gets every frame captured, in the block sizes of the device
+	while( !m_recordReader->empty() )
+	{
+		auto frames = m_recordReader->read_max( m_framesPerPeriod );
+		const f_cnt_t count = frames.size();
+		for( f_cnt_t f = 0; f < count; ++f )
+		{
+			m_recordBuffer[f][0] = frames[f][0];
+			m_recordBuffer[f][1] = frames[f][1];
+		}
+		for( PlayHandle * e : m_recordHandles )
+		{
+			static_cast<SampleRecordHandle*>( e )->play( m_recordBuffer, count );
+		}
+	}
+
+	// monitoring takes whole periods only, so it has no gaps while the
+	// device delivers in other block sizes
+	m_inputBufferFrames = 0;
+	// right after the device delivered a block, the ring holds up to that
+	// block plus what's left of the last one, and output devices may
+	// render several periods at once. More than that is left after a
+	// stall or with the clocks of capture and playback drifting apart, so
+	// skip to the newest period instead of monitoring late forever.
+	const size_t backlog = m_inputReader->read_space();
+	const size_t steadyState = m_inputBlockFrames + 2u * m_framesPerPeriod;
+	if( backlog > steadyState )
+	{
+		m_inputReader->read_max( backlog - m_framesPerPeriod );
+		++m_inputOverruns;
+	}
+	if( m_inputReader->read_space() >= m_framesPerPeriod )
+	{
+		auto frames = m_inputReader->read_max( m_framesPerPeriod );
+		for( f_cnt_t f = 0; f < m_framesPerPeriod; ++f )
+		{
+			m_inputBuffer[f][0] = frames[f][0];
+			m_inputBuffer[f][1] = frames[f][1];
+		}
+		m_inputBufferFrames = m_framesPerPeriod;
+	}
+	else
 	{
-		static_cast<SampleRecordHandle*>(e)->play(_data, _frames);
-		
+		BufferManager::clear( m_inputBuffer, m_framesPerPeriod );
 	}
-	//doneChangeInModel();
 }
 
 
@@ -404,6 +449,14 @@ const surroundSampleFrame * AudioEngine::renderNextBuffer()
 
 	handleMetronome();
 
+	// process MIDI input that arrived during the last period
+	const MidiClock::time_point periodStart = MidiClock::now();
+	for( MidiPort * port : m_midiPorts )
+	{
+		port->processQueuedInEvents( m_lastPeriodStart, periodStart, m_framesPerPeriod );
+	}
+	m_lastPeriodStart = periodStart;
+
 	// create play-handles for new notes, samples etc.
 	Engine::getSong()->processNextBuffer();
 
@@ -424,6 +477,12 @@ const surroundSampleFrame * AudioEngine::renderNextBuffer()
 		e = next;
 	}
 
+	readInput();
+
+	// keep the number of voices within the limits before rendering them
+	m_voiceLimiter.process( m_playHandles, m_profiler.periodLoad(),
+			1000000000LL * m_framesPerPeriod / processingSampleRate() );
+
 	// STAGE 1: run and render all play handles
 	AudioEngineWorkerThread::fillJobQueue<PlayHandleList>( m_playHandles );
 	AudioEngineWorkerThread::startAndWaitForJobs();
@@ -475,11 +534,14 @@ const surroundSampleFrame * AudioEngine::renderNextBuffer()
 	}
 
 	// STAGE 2: process effects of all instrument- and sampletracks
+	m_maxLatency = 0;
+	for( const AudioPort * port : m_audioPorts )
+	{
+		m_maxLatency = qMax( m_maxLatency, port->latency() );
+	}
 	AudioEngineWorkerThread::fillJobQueue<QVector<AudioPort *> >( m_audioPorts );
 	AudioEngineWorkerThread::startAndWaitForJobs();
 
-	//inputBufferFramesTemp=0;
-
 	// STAGE 3: do master mix in mixer
 	mixer->masterMix(m_outputBufferWrite);
 
@@ -505,11 +567,6 @@ const surroundSampleFrame * AudioEngine::renderNextBuffer()
 
 void AudioEngine::swapBuffers()
 {
-	m_inputBufferWrite = (m_inputBufferWrite + 1) % 2;
-	m_inputBufferRead = (m_inputBufferRead + 1) % 2;
-	m_inputBufferFrames[m_inputBufferWrite] = 0;
-	
-
 	std::swap(m_outputBufferRead, m_outputBufferWrite);
 	BufferManager::clear(m_outputBufferWrite, m_framesPerPeriod);
 }
@@ -730,6 +787,21 @@ void AudioEngine::removeAudioPort(AudioPort * port)
 }
 
 
+void AudioEngine::removeMidiPort(MidiPort * port)
+{
+	requestChangeInModel();
+
+	QVector<MidiPort *>::Iterator it = std::find(m_midiPorts.begin(), m_midiPorts.end(), port);
+	if (it != m_midiPorts.end())
+	{
+		m_midiPorts.erase(it);
+	}
+	doneChangeInModel();
+}
+
+
+
+
 bool AudioEngine::addPlayHandle( PlayHandle* handle )
 {
 	if( criticalXRuns() == false )
@@ -30,6 +30,7 @@
 
 #include "denormals.h"
 #include "AudioEngine.h"
+#include "BufferManager.h"
 #include "ThreadableJob.h"
 
 #if __SSE__
@@ -40,6 +41,8 @@ AudioEngineWorkerThread::JobQueue AudioEngineWorkerThread::globalJobQueue;
 QWaitCondition * AudioEngineWorkerThread::queueReadyWaitCond = nullptr;
 QList<AudioEngineWorkerThread *> AudioEngineWorkerThread::workerThreads;
 
+static thread_local int s_workerSlot = -1;
+
 // implementation of internal JobQueue
 void AudioEngineWorkerThread::JobQueue::reset( OperationMode _opMode )
 {
@@ -112,7 +115,8 @@ void AudioEngineWorkerThread::JobQueue::wait()
 
 AudioEngineWorkerThread::AudioEngineWorkerThread( AudioEngine* audioEngine ) :
 	QThread( audioEngine ),
-	m_quit( false )
+	m_quit( false ),
+	m_scratchBuffer( BufferManager::acquire() )
 {
 	// initialize global static data
 	if( queueReadyWaitCond == nullptr )
@@ -134,6 +138,7 @@ AudioEngineWorkerThread::AudioEngineWorkerThread( AudioEngine* audioEngine ) :
 AudioEngineWorkerThread::~AudioEngineWorkerThread()
 {
 	workerThreads.removeAll( this );
+	BufferManager::release( m_scratchBuffer );
 }
 
 
@@ -161,11 +166,29 @@ void AudioEngineWorkerThread::startAndWaitForJobs()
 
 
 
+int AudioEngineWorkerThread::currentSlot()
+{
+	return s_workerSlot >= 0 ? s_workerSlot : slotCount() - 1;
+}
+
+
+
+
+sampleFrame * AudioEngineWorkerThread::scratchBuffer()
+{
+	return workerThreads[currentSlot()]->m_scratchBuffer;
+}
+
+
+
+
 void AudioEngineWorkerThread::run()
 {
 	MemoryManager::ThreadGuard mmThreadGuard; Q_UNUSED(mmThreadGuard);
 	disable_denormals();
 
+	s_workerSlot = workerThreads.indexOf( this );
+
 	QMutex m;
 	while( m_quit == false )
 	{
@@ -0,0 +1,350 @@
+/*
+ * BatchRenderer.cpp - renders a list of projects with a single engine
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "BatchRenderer.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QTimer>
+
+#include "Engine.h"
+#include "lmmsconfig.h"
+#include "RenderManager.h"
+#include "Song.h"
+
+#if !defined(LMMS_BUILD_LINUX) && !defined(LMMS_BUILD_WIN32)
+#include <sys/resource.h>
+#endif
+
+
+BatchRenderer::BatchRenderer(
+		const AudioEngine::qualitySettings & qualitySettings,
+		const OutputSettings & outputSettings,
+		ProjectRenderer::ExportFileFormats fmt,
+		bool loop ) :
+	m_qualitySettings( qualitySettings ),
+	m_outputSettings( outputSettings ),
+	m_format( fmt ),
+	m_loop( loop ),
+	m_nextJob( 0 ),
+	m_failed( 0 ),
+	m_runningWorkers( 0 )
+{
+}
+
+
+
+
+BatchRenderer::~BatchRenderer()
+{
+	for( QProcess * worker : m_workers )
+	{
+		worker->kill();
+		worker->waitForFinished();
+		delete worker;
+	}
+}
+
+
+
+
+bool BatchRenderer::loadJobList( const QString & jobList )
+{
+	QFile file( jobList );
+	if( !file.open( QIODevice::ReadOnly | QIODevice::Text ) )
+	{
+		return false;
+	}
+
+	const QString extension =
+		ProjectRenderer::getFileExtensionFromFormat( m_format );
+
+	QTextStream stream( &file );
+	while( !stream.atEnd() )
+	{
+		const QString line = stream.readLine().trimmed();
+		if( line.isEmpty() || line.startsWith( '#' ) )
+		{
+			continue;
+		}
+
+		Job job;
+		const int tab = line.indexOf( '\t' );
+		if( tab < 0 )
+		{
+			job.project = line;
+		}
+		else
+		{
+			job.project = line.left( tab ).trimmed();
+			job.output = line.mid( tab + 1 ).trimmed();
+		}
+
+		if( job.output.isEmpty() )
+		{
+			// same as for the "render" command
+			const QFileInfo info( job.project );
+			job.output = info.absolutePath() + "/" +
+					info.completeBaseName() + extension;
+		}
+		m_jobs.push_back( job );
+	}
+
+	return true;
+}
+
+
+
+
+void BatchRenderer::start()
+{
+	m_nextJob = 0;
+	m_failed = 0;
+	QTimer::singleShot( 0, this, SLOT( renderNextJob() ) );
+}
+
+
+
+
+void BatchRenderer::startWorkers( int workers, const QStringList & arguments,
+					int jobListArgument )
+{
+	workers = qBound( 1, workers, qMax( 1, m_jobs.size() ) );
+
+	m_workerDir.reset( new QTemporaryDir );
+	if( !m_workerDir->isValid() )
+	{
+		fprintf( stderr, "Could not create a directory for the job lists\n" );
+		m_failed = m_jobs.size();
+		QTimer::singleShot( 0, this, SIGNAL( finished() ) );
+		return;
+	}
+
+	for( int w = 0; w < workers; ++w )
+	{
+		// round-robin, so long and short jobs from adjacent lines spread
+		const QString jobList = m_workerDir->path() +
+					QString( "/jobs%1.txt" ).arg( w );
+		QFile file( jobList );
+		if( !file.open( QIODevice::WriteOnly | QIODevice::Text ) )
+		{
+			continue;
+		}
+		QTextStream stream( &file );
+		for( int j = w; j < m_jobs.size(); j += workers )
+		{
+			stream << m_jobs[j].project << '\t' << m_jobs[j].output << '\n';
+		}
+		stream.flush();
+		file.close();
+
+		QStringList workerArguments;
+		for( int a = 1; a < arguments.size(); ++a )
+		{
+			if( arguments[a] == "--jobs" || arguments[a] == "-j" )
+			{
+				++a;
+			}
+			else
+			{
+				workerArguments << ( a == jobListArgument
+							? jobList : arguments[a] );
+			}
+		}
+
+		QProcess * worker = new QProcess;
+		worker->setProcessChannelMode( QProcess::ForwardedChannels );
+		connect( worker, SIGNAL( finished( int, QProcess::ExitStatus ) ),
+				this, SLOT( workerFinished( int, QProcess::ExitStatus ) ) );
+		m_workers.push_back( worker );
+		worker->start( arguments[0], workerArguments );
+		if( worker->waitForStarted() )
+		{
+			++m_runningWorkers;
+		}
+		else
+		{
+			fprintf( stderr, "Could not start a worker process\n" );
+			++m_failed;
+		}
+	}
+
+	if( m_runningWorkers == 0 )
+	{
+		m_failed = m_jobs.size();
+		QTimer::singleShot( 0, this, SIGNAL( finished() ) );
+	}
+}
+
+
+
+
+void BatchRenderer::renderNextJob()
+{
+	if( m_nextJob >= m_jobs.size() )
+	{
+		printf( "Rendered %d of %d projects\n",
+				m_jobs.size() - m_failed, m_jobs.size() );
+		emit finished();
+		return;
+	}
+
+	const Job & job = m_jobs[m_nextJob];
+	printf( "[%d/%d] %s\n", m_nextJob + 1, m_jobs.size(),
+					job.project.toUtf8().constData() );
+	fflush( stdout );
+
+	resetPeakMemory();
+	m_jobTimer.start();
+
+	// loading a project clears the song and the mixer first, unless it
+	// can't be loaded at all
+	Song * song = Engine::getSong();
+	const QString project = QFileInfo( job.project ).canonicalFilePath();
+	if( !project.isEmpty() && QFileInfo( project ).isFile() )
+	{
+		song->loadProject( job.project );
+	}
+	if( project.isEmpty() || song->isEmpty() ||
+		QFileInfo( song->projectFileName() ).canonicalFilePath() != project )
+	{
+		printf( "[%d/%d] failed: could not load the project or it is empty\n",
+					m_nextJob + 1, m_jobs.size() );
+		++m_failed;
+		++m_nextJob;
+		QTimer::singleShot( 0, this, SLOT( renderNextJob() ) );
+		return;
+	}
+	song->setExportLoop( m_loop );
+
+	m_renderManager.reset( new RenderManager( m_qualitySettings,
+				m_outputSettings, m_format, job.output ) );
+	connect( m_renderManager.get(), SIGNAL( finished() ),
+				this, SLOT( jobFinished() ), Qt::QueuedConnection );
+	m_renderManager->renderProject();
+}
+
+
+
+
+void BatchRenderer::jobFinished()
+{
+	const Job & job = m_jobs[m_nextJob];
+	const double seconds = m_jobTimer.elapsed() / 1000.0;
+	const double speed = m_renderManager->realTimeFactor();
+	// restores the audio device of the engine
+	m_renderManager.reset();
+
+	if( QFileInfo( job.output ).isFile() )
+	{
+		const long memory = peakMemory();
+		printf( "[%d/%d] %s: %.2f s, %.1fx real time, peak memory %s\n",
+			m_nextJob + 1, m_jobs.size(),
+			job.output.toUtf8().constData(), seconds, speed,
+			memory < 0 ? "unknown" :
+				QString( "%1 MiB" ).arg( memory / 1024 ).toUtf8().constData() );
+	}
+	else
+	{
+		printf( "[%d/%d] failed: could not write %s\n",
+			m_nextJob + 1, m_jobs.size(), job.output.toUtf8().constData() );
+		++m_failed;
+	}
+	fflush( stdout );
+
+	++m_nextJob;
+	renderNextJob();
+}
+
+
+
+
+void BatchRenderer::workerFinished( int exitCode, QProcess::ExitStatus exitStatus )
+{
+	// the exit code of a crashed worker is meaningless
+	if( exitStatus == QProcess::CrashExit || exitCode != EXIT_SUCCESS )
+	{
+		// the worker can't tell how many of its jobs failed
+		++m_failed;
+	}
+
+	if( --m_runningWorkers == 0 )
+	{
+		emit finished();
+	}
+}
+
+
+
+
+long BatchRenderer::peakMemory()
+{
+#if defined(LMMS_BUILD_LINUX)
+	// VmHWM can be reset per job, unlike the peak of getrusage()
+	QFile status( "/proc/self/status" );
+	if( status.open( QIODevice::ReadOnly | QIODevice::Text ) )
+	{
+		for( QByteArray line = status.readLine(); !line.isEmpty();
+						line = status.readLine() )
+		{
+			if( line.startsWith( "VmHWM:" ) )
+			{
+				return line.mid( 6 ).trimmed().split( ' ' ).front().toLong();
+			}
+		}
+	}
+	return -1;
+#elif !defined(LMMS_BUILD_WIN32)
+	struct rusage usage;
+	if( getrusage( RUSAGE_SELF, &usage ) != 0 )
+	{
+		return -1;
+	}
+#ifdef LMMS_BUILD_APPLE
+	return usage.ru_maxrss / 1024;
+#else
+	return usage.ru_maxrss;
+#endif
+#else
+	return -1;
+#endif
+}
+
+
+
+
+void BatchRenderer::resetPeakMemory()
+{
+#if defined(LMMS_BUILD_LINUX)
+	// writing 5 resets VmHWM to the current resident size
+	QFile clearRefs( "/proc/self/clear_refs" );
+	if( clearRefs.open( QIODevice::WriteOnly ) )
+	{
+		clearRefs.write( "5" );
+	}
+#endif
+}
@@ -42,6 +42,18 @@ sampleFrame * BufferManager::acquire()
 	return MM_ALLOC<sampleFrame>( ::framesPerPeriod );
 }
 
+PlanarBuffer BufferManager::acquirePlanar()
+{
+	// the channels follow each other in a single allocation
+	sample_t * data = MM_ALLOC<sample_t>( DEFAULT_CHANNELS * ::framesPerPeriod );
+	PlanarBuffer buf;
+	for( ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch )
+	{
+		buf.channels[ch] = data + ch * ::framesPerPeriod;
+	}
+	return buf;
+}
+
 void BufferManager::clear( sampleFrame *ab, const f_cnt_t frames, const f_cnt_t offset )
 {
 	memset( ab + offset, 0, sizeof( *ab ) * frames );
@@ -61,3 +73,8 @@ void BufferManager::release( sampleFrame * buf )
 	MM_FREE( buf );
 }
 
+void BufferManager::release( const PlanarBuffer & buf )
+{
+	MM_FREE( buf.channels[0] );
+}
+
@@ -318,8 +318,6 @@ bool DataFile::writeFile(const QString& filename, bool withResources)
 	const QString fullName = withResources
 		? nameWithExtension(bundleDir + "/" + fInfo.fileName())
 		: nameWithExtension(filename);
-	const QString fullNameTemp = fullName + ".new";
-	const QString fullNameBak = fullName + ".bak";
 
 	// If we are saving with resources, setup the bundle folder first
 	if (withResources)
@@ -362,9 +360,8 @@ bool DataFile::writeFile(const QString& filename, bool withResources)
 		}
 	}
 
-	QFile outfile (fullNameTemp);
-
-	if (!outfile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	if (!writeAtomically(fullName,
+		!ConfigManager::inst()->value("app", "disablebackup").toInt()))
 	{
 		showError(SongEditor::tr("Could not write file"),
 			SongEditor::tr("Could not open %1 for writing. You probably are not permitted to"
@@ -374,6 +371,24 @@ bool DataFile::writeFile(const QString& filename, bool withResources)
 		return false;
 	}
 
+	return true;
+}
+
+
+
+
+bool DataFile::writeAtomically(const QString& fullName, bool keepBackup)
+{
+	const QString fullNameTemp = fullName + ".new";
+	const QString fullNameBak = fullName + ".bak";
+
+	QFile outfile (fullNameTemp);
+
+	if (!outfile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		return false;
+	}
+
 	const QString extension = fullName.section('.', -1);
 	if (extension == "mmpz" || extension == "xptz")
 	{
@@ -393,18 +408,18 @@ bool DataFile::writeFile(const QString& filename, bool withResources)
 	// make sure the file has been written correctly
 	if( QFileInfo( outfile.fileName() ).size() > 0 )
 	{
-		if( ConfigManager::inst()->value( "app", "disablebackup" ).toInt() )
-		{
-			// remove current file
-			QFile::remove( fullName );
-		}
-		else
+		if( keepBackup )
 		{
 			// remove old backup file
 			QFile::remove( fullNameBak );
 			// move current file to backup file
 			QFile::rename( fullName, fullNameBak );
 		}
+		else
+		{
+			// remove current file
+			QFile::remove( fullName );
+		}
 		// move temporary file to current file
 		QFile::rename( fullNameTemp, fullName );
 
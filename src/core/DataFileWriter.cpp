@@ -0,0 +1,81 @@
+/*
+ * DataFileWriter.cpp - writes DataFiles to disk in a background thread
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "DataFileWriter.h"
+
+#include <QDebug>
+
+#include "ConfigManager.h"
+
+
+DataFileWriter::DataFileWriter(QObject * parent) :
+	QThread(parent),
+	m_keepBackup(true),
+	m_success(false)
+{
+}
+
+
+
+
+DataFileWriter::~DataFileWriter()
+{
+	// never leave a half-written file behind
+	wait();
+}
+
+
+
+
+bool DataFileWriter::write(std::unique_ptr<DataFile> dataFile, const QString & fileName)
+{
+	if (isRunning())
+	{
+		return false;
+	}
+
+	m_dataFile = std::move(dataFile);
+	m_fileName = m_dataFile->nameWithExtension(fileName);
+	// read the config here, it must not be accessed from the writer thread
+	m_keepBackup = !ConfigManager::inst()->value("app", "disablebackup").toInt();
+	m_success = false;
+
+	start(QThread::LowPriority);
+	return true;
+}
+
+
+
+
+void DataFileWriter::run()
+{
+	m_success = m_dataFile->writeAtomically(m_fileName, m_keepBackup);
+	if (!m_success)
+	{
+		qWarning() << "DataFileWriter: could not write" << m_fileName;
+	}
+
+	// free the DOM here instead of in the GUI thread
+	m_dataFile.reset();
+}
@@ -31,6 +31,7 @@
 #include "EffectView.h"
 
 #include "ConfigManager.h"
+#include "Oversampler.h"
 
 
 Effect::Effect( const Plugin::Descriptor * _desc,
@@ -47,7 +48,10 @@ Effect::Effect( const Plugin::Descriptor * _desc,
 	m_wetDryModel( 1.0f, -1.0f, 1.0f, 0.01f, this, tr( "Wet/Dry mix" ) ),
 	m_gateModel( 0.0f, 0.0f, 1.0f, 0.01f, this, tr( "Gate" ) ),
 	m_autoQuitModel( 1.0f, 1.0f, 8000.0f, 100.0f, 1.0f, this, tr( "Decay" ) ),
-	m_autoQuitDisabled( false )
+	m_oversamplingModel( 0, 0, Oversampler::MaxStages, this, tr( "Oversampling" ) ),
+	m_autoQuitDisabled( false ),
+	m_oversamplingFactor( 1 ),
+	m_dryDelayPosition( 0 )
 {
 	m_srcState[0] = m_srcState[1] = nullptr;
 	reinitSRC();
@@ -56,6 +60,9 @@ Effect::Effect( const Plugin::Descriptor * _desc,
 	{
 		m_autoQuitDisabled = true;
 	}
+
+	connect( &m_oversamplingModel, SIGNAL( dataChanged() ),
+			this, SLOT( updateOversampling() ), Qt::DirectConnection );
 }
 
 
@@ -81,6 +88,7 @@ void Effect::saveSettings( QDomDocument & _doc, QDomElement & _this )
 	m_wetDryModel.saveSettings( _doc, _this, "wet" );
 	m_autoQuitModel.saveSettings( _doc, _this, "autoquit" );
 	m_gateModel.saveSettings( _doc, _this, "gate" );
+	m_oversamplingModel.saveSettings( _doc, _this, "oversampling" );
 	controls()->saveState( _doc, _this );
 }
 
@@ -93,6 +101,7 @@ void Effect::loadSettings( const QDomElement & _this )
 	m_wetDryModel.loadSettings( _this, "wet" );
 	m_autoQuitModel.loadSettings( _this, "autoquit" );
 	m_gateModel.loadSettings( _this, "gate" );
+	m_oversamplingModel.loadSettings( _this, "oversampling" );
 
 	QDomNode node = _this.firstChild();
 	while( !node.isNull() )
@@ -112,6 +121,46 @@ void Effect::loadSettings( const QDomElement & _this )
 
 
 
+bool Effect::processOversampled( sampleFrame * _buf, const fpp_t _frames )
+{
+	if( !m_oversampler )
+	{
+		return processAudioBuffer( _buf, _frames );
+	}
+
+	sampleFrame * buf = m_oversampler->buffer();
+	const bool bypassed = !isEnabled() || !isRunning();
+	if( !bypassed )
+	{
+		m_oversampler->upsample( _buf, buf, _frames );
+	}
+
+	// the dry signal always goes through a delay line as long as the
+	// oversampler's, so the latency doesn't change when bypassing the
+	// effect and the output continues seamlessly
+	const f_cnt_t delay = latency();
+	for( fpp_t f = 0; f < _frames; ++f )
+	{
+		std::swap( _buf[f], m_dryDelay[m_dryDelayPosition] );
+		if( ++m_dryDelayPosition == delay )
+		{
+			m_dryDelayPosition = 0;
+		}
+	}
+
+	if( bypassed )
+	{
+		return processAudioBuffer( _buf, _frames );
+	}
+
+	const bool running = processAudioBuffer( buf, _frames * m_oversamplingFactor );
+	m_oversampler->downsample( buf, _buf, _frames );
+	return running;
+}
+
+
+
+
 Effect * Effect::instantiate( const QString& pluginName,
 				Model * _parent,
 				Descriptor::SubPluginFeatures::Key * _key )
@@ -170,6 +219,37 @@ PluginView * Effect::instantiateView( QWidget * _parent )
 	
 
 
+void Effect::updateOversampling()
+{
+	const int stages = supportsOversampling() ? m_oversamplingModel.value() : 0;
+	if( stages == ( m_oversampler ? m_oversampler->stages() : 0 ) )
+	{
+		return;
+	}
+
+	Engine::audioEngine()->requestChangeInModel();
+	if( stages == 0 )
+	{
+		m_oversampler.reset();
+	}
+	else
+	{
+		if( !m_oversampler )
+		{
+			m_oversampler.reset( new Oversampler(
+				Engine::audioEngine()->framesPerPeriod() ) );
+		}
+		m_oversampler->setStages( stages );
+	}
+	m_oversamplingFactor = 1 << stages;
+	m_dryDelay.assign( m_oversampler ? m_oversampler->latency() : 0, sampleFrame{} );
+	m_dryDelayPosition = 0;
+	Engine::audioEngine()->doneChangeInModel();
+}
+
+
+
+
 void Effect::reinitSRC()
 {
 	for( int i = 0; i < 2; ++i )
@@ -36,7 +36,8 @@
 EffectChain::EffectChain( Model * _parent ) :
 	Model( _parent ),
 	SerializingObject(),
-	m_enabledModel( false, nullptr, tr( "Effects enabled" ) )
+	m_enabledModel( false, nullptr, tr( "Effects enabled" ) ),
+	m_planarBuffer( BufferManager::acquirePlanar() )
 {
 }
 
@@ -46,6 +47,7 @@ EffectChain::EffectChain( Model * _parent ) :
 EffectChain::~EffectChain()
 {
 	clear();
+	BufferManager::release( m_planarBuffer );
 }
 
 
@@ -192,15 +194,47 @@ bool EffectChain::processAudioBuffer( sampleFrame * _buf, const fpp_t _frames, b
 	MixHelpers::sanitize( _buf, _frames );
 
 	bool moreEffects = false;
+	// whether the signal is in m_planarBuffer, it's only interleaved again
+	// for an effect which doesn't process planar audio or at the end
+	bool planar = false;
 	for( EffectList::Iterator it = m_effects.begin(); it != m_effects.end(); ++it )
 	{
 		if( hasInputNoise || ( *it )->isRunning() )
 		{
-			moreEffects |= ( *it )->processAudioBuffer( _buf, _frames );
-			MixHelpers::sanitize( _buf, _frames );
+			if( ( *it )->processesPlanar() )
+			{
+				if( !planar )
+				{
+					MixHelpers::deinterleave( m_planarBuffer.channels[0],
+						m_planarBuffer.channels[1], _buf, _frames );
+					planar = true;
+				}
+				moreEffects |= ( *it )->processPlanarBuffer( m_planarBuffer, _frames );
+				for( sample_t * channel : m_planarBuffer.channels )
+				{
+					MixHelpers::sanitize( channel, _frames );
+				}
+			}
+			else
+			{
+				if( planar )
+				{
+					MixHelpers::interleave( _buf, m_planarBuffer.channels[0],
+						m_planarBuffer.channels[1], _frames );
+					planar = false;
+				}
+				moreEffects |= ( *it )->processOversampled( _buf, _frames );
+				MixHelpers::sanitize( _buf, _frames );
+			}
 		}
 	}
 
+	if( planar )
+	{
+		MixHelpers::interleave( _buf, m_planarBuffer.channels[0],
+					m_planarBuffer.channels[1], _frames );
+	}
+
 	return moreEffects;
 }
 
@@ -224,6 +258,44 @@ void EffectChain::startRunning()
 
 
 
+bool EffectChain::isRunning() const
+{
+	if( m_enabledModel.value() == false )
+	{
+		return false;
+	}
+
+	for( const Effect * effect : m_effects )
+	{
+		if( effect->isRunning() )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+
+
+f_cnt_t EffectChain::latency() const
+{
+	if( m_enabledModel.value() == false )
+	{
+		return 0;
+	}
+
+	f_cnt_t frames = 0;
+	for( const Effect * effect : m_effects )
+	{
+		frames += effect->latency();
+	}
+	return frames;
+}
+
+
+
+
 void EffectChain::clear()
 {
 	emit aboutToClear();
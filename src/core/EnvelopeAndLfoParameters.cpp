@@ -301,36 +301,48 @@ void EnvelopeAndLfoParameters::fillLevel( float * _buf, f_cnt_t _frame,
 
 	fillLfoLevel( _buf, _frame, _frames );
 
-	for( fpp_t offset = 0; offset < _frames; ++offset, ++_buf, ++_frame )
+	const bool controlAmount = m_controlEnvAmountModel.value();
+	const float releaseLevel = _release_begin < m_pahdFrames
+					? m_pahdEnv[_release_begin] : m_sustainLevel;
+
+	// the envelope is made of segments (attack/decay, sustain, release and
+	// silence), each of them being filled by a loop without branches,
+	// which the compiler can vectorize
+	fpp_t offset = 0;
+	const auto segmentEnd = [&]( f_cnt_t endFrame )
+	{
+		return static_cast<fpp_t>( qBound<f_cnt_t>( offset,
+						endFrame - _frame, _frames ) );
+	};
+	const auto fill = [&]( fpp_t end, auto envLevel )
 	{
-		float env_level;
-		if( _frame < _release_begin )
+		if( controlAmount )
 		{
-			if( _frame < m_pahdFrames )
+			for( ; offset < end; ++offset )
 			{
-				env_level = m_pahdEnv[_frame];
+				// at this point, _buf holds the LFO level
+				_buf[offset] = envLevel( _frame + offset ) * ( 0.5f + _buf[offset] );
 			}
-			else
-			{
-				env_level = m_sustainLevel;
-			}
-		}
-		else if( ( _frame - _release_begin ) < m_rFrames )
-		{
-			env_level = m_rEnv[_frame - _release_begin] *
-				( ( _release_begin < m_pahdFrames ) ?
-				m_pahdEnv[_release_begin] : m_sustainLevel );
 		}
 		else
 		{
-			env_level = 0.0f;
+			for( ; offset < end; ++offset )
+			{
+				_buf[offset] = envLevel( _frame + offset ) + _buf[offset];
+			}
 		}
-
-		// at this point, *_buf is LFO level
-		*_buf = m_controlEnvAmountModel.value() ?
-			env_level * ( 0.5f + *_buf ) :
-			env_level + *_buf;
-	}
+	};
+
+	fill( segmentEnd( qMin( _release_begin, m_pahdFrames ) ),
+		[this]( f_cnt_t f ) { return m_pahdEnv[f]; } );
+	fill( segmentEnd( _release_begin ),
+		[this]( f_cnt_t ) { return m_sustainLevel; } );
+	fill( segmentEnd( _release_begin + m_rFrames ),
+		[this, _release_begin, releaseLevel]( f_cnt_t f )
+		{
+			return m_rEnv[f - _release_begin] * releaseLevel;
+		} );
+	fill( _frames, []( f_cnt_t ) { return 0.0f; } );
 }
 
 
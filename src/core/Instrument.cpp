@@ -35,7 +35,10 @@ Instrument::Instrument(InstrumentTrack * _instrument_track,
 			const Descriptor * _descriptor,
 			const Descriptor::SubPluginFeatures::Key *key) :
 	Plugin(_descriptor, nullptr/* _instrument_track*/, key),
-	m_instrumentTrack( _instrument_track )
+	m_instrumentTrack( _instrument_track ),
+	m_wakeUp( false ),
+	m_sleeping( false ),
+	m_silentFrames( 0 )
 {
 }
 
@@ -82,6 +85,36 @@ bool Instrument::isFromTrack( const Track * _track ) const
 	return( m_instrumentTrack == _track );
 }
 
+
+
+
+void Instrument::checkSilence( const sampleFrame * buf, bool hasNotes )
+{
+	if( m_wakeUp.exchange( false ) || hasNotes || flags().testFlag( NeverSleeps ) )
+	{
+		m_sleeping = false;
+		m_silentFrames = 0;
+		return;
+	}
+
+	const fpp_t frames = Engine::audioEngine()->framesPerPeriod();
+	for( fpp_t f = 0; f < frames; ++f )
+	{
+		if( fabsf( buf[f][0] ) >= SleepThreshold || fabsf( buf[f][1] ) >= SleepThreshold )
+		{
+			m_silentFrames = 0;
+			return;
+		}
+	}
+
+	m_silentFrames += frames;
+	if( m_silentFrames >= static_cast<f_cnt_t>(
+		Engine::audioEngine()->processingSampleRate() ) * SleepTimeout / 1000 )
+	{
+		m_sleeping = true;
+	}
+}
+
 // helper function for Instrument::applyFadeIn
 static int countZeroCrossings(sampleFrame *buf, fpp_t start, fpp_t frames)
 {
@@ -142,12 +142,6 @@ void InstrumentSoundShaping::processAudioBuffer( sampleFrame* buffer,
 		envReleaseBegin += frames;
 	}
 
-	// because of optimizations, there's special code for several cases:
-	// 	- cut- and res-lfo/envelope active
-	// 	- cut-lfo/envelope active
-	// 	- res-lfo/envelope active
-	//	- no lfo/envelope active but filter is used
-
 	// only use filter, if it is really needed
 
 	if( m_filterEnabledModel.value() )
@@ -175,72 +169,47 @@ void InstrumentSoundShaping::processAudioBuffer( sampleFrame* buffer,
 
 		const float fcv = m_filterCutModel.value();
 		const float frv = m_filterResModel.value();
+		const bool cutUsed = m_envLfoParameters[Cut]->isUsed();
+		const bool resUsed = m_envLfoParameters[Resonance]->isUsed();
 
-		if( m_envLfoParameters[Cut]->isUsed() &&
-			m_envLfoParameters[Resonance]->isUsed() )
+		if( !cutUsed && !resUsed )
 		{
-			for( fpp_t frame = 0; frame < frames; ++frame )
-			{
-				const float new_cut_val = EnvelopeAndLfoParameters::expKnobVal( cutBuffer[frame] ) *
-								CUT_FREQ_MULTIPLIER + fcv;
-
-				const float new_res_val = frv + RES_MULTIPLIER * resBuffer[frame];
-
-				if( static_cast<int>( new_cut_val ) != old_filter_cut ||
-					static_cast<int>( new_res_val*RES_PRECISION ) != old_filter_res )
-				{
-					n->m_filter->calcFilterCoeffs( new_cut_val, new_res_val );
-					old_filter_cut = static_cast<int>( new_cut_val );
-					old_filter_res = static_cast<int>( new_res_val*RES_PRECISION );
-				}
-
-				buffer[frame][0] = n->m_filter->update( buffer[frame][0], 0 );
-				buffer[frame][1] = n->m_filter->update( buffer[frame][1], 1 );
-			}
+			n->m_filter->calcFilterCoeffs( fcv, frv );
 		}
-		else if( m_envLfoParameters[Cut]->isUsed() )
-		{
-			for( fpp_t frame = 0; frame < frames; ++frame )
-			{
-				float new_cut_val = EnvelopeAndLfoParameters::expKnobVal( cutBuffer[frame] ) *
-								CUT_FREQ_MULTIPLIER + fcv;
 
-				if( static_cast<int>( new_cut_val ) != old_filter_cut )
-				{
-					n->m_filter->calcFilterCoeffs( new_cut_val, frv );
-					old_filter_cut = static_cast<int>( new_cut_val );
-				}
+		BasicFilters<> & filter = *n->m_filter;
 
-				buffer[frame][0] = n->m_filter->update( buffer[frame][0], 0 );
-				buffer[frame][1] = n->m_filter->update( buffer[frame][1], 1 );
-			}
-		}
-		else if( m_envLfoParameters[Resonance]->isUsed() )
+		// the filter type is dispatched once per period, so the compiler
+		// can inline the filter into the loop below
+		filter.dispatch( [&]( auto type )
 		{
+			constexpr auto Type = decltype( type )::value;
+
 			for( fpp_t frame = 0; frame < frames; ++frame )
 			{
-				float new_res_val = frv + RES_MULTIPLIER * resBuffer[frame];
-
-				if( static_cast<int>( new_res_val*RES_PRECISION ) != old_filter_res )
+				if( cutUsed || resUsed )
 				{
-					n->m_filter->calcFilterCoeffs( fcv, new_res_val );
-					old_filter_res = static_cast<int>( new_res_val*RES_PRECISION );
+					const float new_cut_val = cutUsed
+						? EnvelopeAndLfoParameters::expKnobVal( cutBuffer[frame] ) *
+								CUT_FREQ_MULTIPLIER + fcv
+						: fcv;
+					const float new_res_val = resUsed
+						? frv + RES_MULTIPLIER * resBuffer[frame]
+						: frv;
+
+					if( static_cast<int>( new_cut_val ) != old_filter_cut ||
+						static_cast<int>( new_res_val*RES_PRECISION ) != old_filter_res )
+					{
+						filter.calcFilterCoeffs( new_cut_val, new_res_val );
+						old_filter_cut = static_cast<int>( new_cut_val );
+						old_filter_res = static_cast<int>( new_res_val*RES_PRECISION );
+					}
 				}
 
-				buffer[frame][0] = n->m_filter->update( buffer[frame][0], 0 );
-				buffer[frame][1] = n->m_filter->update( buffer[frame][1], 1 );
+				buffer[frame][0] = filter.updateAs<Type>( buffer[frame][0], 0 );
+				buffer[frame][1] = filter.updateAs<Type>( buffer[frame][1], 1 );
 			}
-		}
-		else
-		{
-			n->m_filter->calcFilterCoeffs( fcv, frv );
-
-			for( fpp_t frame = 0; frame < frames; ++frame )
-			{
-				buffer[frame][0] = n->m_filter->update( buffer[frame][0], 0 );
-				buffer[frame][1] = n->m_filter->update( buffer[frame][1], 1 );
-			}
-		}
+		} );
 	}
 
 	if( m_envLfoParameters[Volume]->isUsed() )
@@ -27,12 +27,14 @@
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
+#include <QJsonArray>
 #include <QLibrary>
 
 #include <math.h>
 
 #include "ConfigManager.h"
 #include "LadspaManager.h"
+#include "PluginCache.h"
 #include "PluginFactory.h"
 
 
@@ -56,6 +58,10 @@ LadspaManager::LadspaManager()
 	ladspaDirectories.push_back( "/Library/Audio/Plug-Ins/LADSPA" );
 #endif
 
+	// libraries are only loaded if they are not in the cache, or when a
+	// plug-in is actually used
+	PluginCache cache( "ladspa" );
+
 	for( QStringList::iterator it = ladspaDirectories.begin(); 
 			 		   it != ladspaDirectories.end(); ++it )
 	{
@@ -79,22 +85,33 @@ LadspaManager::LadspaManager()
 				continue;
 			}
 
-			QLibrary plugin_lib( f.absoluteFilePath() );
-
-			if( plugin_lib.load() == true )
+			LADSPA_Descriptor_Function descriptorFunction = nullptr;
+			QJsonObject plugins = cache.entry( f );
+			if( plugins.isEmpty() )
 			{
-				LADSPA_Descriptor_Function descriptorFunction =
-			( LADSPA_Descriptor_Function ) plugin_lib.resolve(
-							"ladspa_descriptor" );
-				if( descriptorFunction != nullptr )
+				QLibrary plugin_lib( f.absoluteFilePath() );
+
+				if( plugin_lib.load() == true )
+				{
+					descriptorFunction =
+				( LADSPA_Descriptor_Function ) plugin_lib.resolve(
+								"ladspa_descriptor" );
+					// also cache libraries which are no plug-ins
+					plugins = describePlugins( descriptorFunction );
+					cache.setEntry( f, plugins );
+				}
+				else
 				{
-					addPlugins( descriptorFunction,
-							f.fileName() );
+					// not cached, maybe it's missing a dependency
+					qWarning() << plugin_lib.errorString();
+					continue;
 				}
 			}
-			else
+
+			for( const QJsonValue & plugin :
+					plugins.value( "plugins" ).toArray() )
 			{
-				qWarning() << plugin_lib.errorString();
+				addPlugin( f, plugin.toObject(), descriptorFunction );
 			}
 		}
 	}
@@ -139,50 +156,72 @@ ladspaManagerDescription * LadspaManager::getDescription(
 
 
 
-void LadspaManager::addPlugins(
-		LADSPA_Descriptor_Function _descriptor_func,
-						const QString & _file )
+QJsonObject LadspaManager::describePlugins(
+		LADSPA_Descriptor_Function _descriptor_func )
 {
+	QJsonArray plugins;
 	const LADSPA_Descriptor * descriptor;
 
-	for( long pluginIndex = 0;
+	for( long pluginIndex = 0; _descriptor_func != nullptr &&
 		( descriptor = _descriptor_func( pluginIndex ) ) != nullptr;
 								++pluginIndex )
 	{
-		ladspa_key_t key( _file, QString( descriptor->Label ) );
-		if( m_ladspaManagerMap.contains( key ) )
-		{
-			continue;
-		}
+		QJsonObject plugin;
+		plugin.insert( "label", QString( descriptor->Label ) );
+		plugin.insert( "name", QString( descriptor->Name ) );
+		plugin.insert( "index", static_cast<int>( pluginIndex ) );
+		plugin.insert( "inputs", getPluginInputs( descriptor ) );
+		plugin.insert( "outputs", getPluginOutputs( descriptor ) );
+		plugins.append( plugin );
+	}
 
-		ladspaManagerDescription * plugIn = 
-				new ladspaManagerDescription;
-		plugIn->descriptorFunction = _descriptor_func;
-		plugIn->index = pluginIndex;
-		plugIn->inputChannels = getPluginInputs( descriptor );
-		plugIn->outputChannels = getPluginOutputs( descriptor );
+	QJsonObject data;
+	data.insert( "plugins", plugins );
+	return data;
+}
 
-		if( plugIn->inputChannels == 0 && plugIn->outputChannels > 0 )
-		{
-			plugIn->type = SOURCE;
-		}
-		else if( plugIn->inputChannels > 0 &&
-				       plugIn->outputChannels > 0 )
-		{
-			plugIn->type = TRANSFER;
-		}
-		else if( plugIn->inputChannels > 0 &&
-				       plugIn->outputChannels == 0 )
-		{
-			plugIn->type = SINK;
-		}
-		else
-		{
-			plugIn->type = OTHER;
-		}
 
-		m_ladspaManagerMap[key] = plugIn;
+
+
+void LadspaManager::addPlugin( const QFileInfo & _file,
+				const QJsonObject & _plugin,
+				LADSPA_Descriptor_Function _descriptor_func )
+{
+	ladspa_key_t key( _file.fileName(), _plugin.value( "label" ).toString() );
+	if( m_ladspaManagerMap.contains( key ) )
+	{
+		return;
+	}
+
+	ladspaManagerDescription * plugIn = 
+			new ladspaManagerDescription;
+	plugIn->descriptorFunction = _descriptor_func;
+	plugIn->file = _file.absoluteFilePath();
+	plugIn->name = _plugin.value( "name" ).toString();
+	plugIn->index = _plugin.value( "index" ).toInt();
+	plugIn->inputChannels = _plugin.value( "inputs" ).toInt();
+	plugIn->outputChannels = _plugin.value( "outputs" ).toInt();
+
+	if( plugIn->inputChannels == 0 && plugIn->outputChannels > 0 )
+	{
+		plugIn->type = SOURCE;
 	}
+	else if( plugIn->inputChannels > 0 &&
+			       plugIn->outputChannels > 0 )
+	{
+		plugIn->type = TRANSFER;
+	}
+	else if( plugIn->inputChannels > 0 &&
+			       plugIn->outputChannels == 0 )
+	{
+		plugIn->type = SINK;
+	}
+	else
+	{
+		plugIn->type = OTHER;
+	}
+
+	m_ladspaManagerMap[key] = plugIn;
 }
 
 
@@ -311,8 +350,9 @@ bool LadspaManager::isRealTimeCapable(
 
 QString LadspaManager::getName( const ladspa_key_t & _plugin )
 {
-	const LADSPA_Descriptor * descriptor = getDescriptor( _plugin );
-	return( descriptor ? descriptor->Name : "" );
+	// known without loading the library
+	const ladspaManagerDescription * description = getDescription( _plugin );
+	return( description ? description->name : "" );
 }
 
 
@@ -528,14 +568,9 @@ bool LadspaManager::isInteger( const ladspa_key_t & _plugin,
 
 bool LadspaManager::isEnum( const ladspa_key_t & _plugin, uint32_t _port )
 {
-	if( m_ladspaManagerMap.contains( _plugin )
-		   && _port < getPortCount( _plugin ) )
+	const LADSPA_Descriptor * descriptor = getDescriptor( _plugin );
+	if( descriptor && _port < getPortCount( _plugin ) )
 	{
-		LADSPA_Descriptor_Function descriptorFunction =
-			m_ladspaManagerMap[_plugin]->descriptorFunction;
-		const LADSPA_Descriptor * descriptor =
-				descriptorFunction(
-					m_ladspaManagerMap[_plugin]->index );
 		LADSPA_PortRangeHintDescriptor hintDescriptor =
 			descriptor->PortRangeHints[_port].HintDescriptor;
 		// This is an LMMS extension to ladspa
@@ -574,19 +609,44 @@ const void * LadspaManager::getImplementationData(
 const LADSPA_Descriptor * LadspaManager::getDescriptor(
 						const ladspa_key_t & _plugin )
 {
-	if( m_ladspaManagerMap.contains( _plugin ) )
+	ladspaManagerDescription * description = getDescription( _plugin );
+	if( description == nullptr ||
+		( description->descriptorFunction == nullptr &&
+			!loadLibrary( description ) ) )
 	{
-		LADSPA_Descriptor_Function descriptorFunction =
-			m_ladspaManagerMap[_plugin]->descriptorFunction;
-		const LADSPA_Descriptor * descriptor =
-				descriptorFunction(
-					m_ladspaManagerMap[_plugin]->index );
-		return( descriptor );
+		return( nullptr );
 	}
-	else
+	return( description->descriptorFunction( description->index ) );
+}
+
+
+
+
+bool LadspaManager::loadLibrary( ladspaManagerDescription * _description )
+{
+	QLibrary plugin_lib( _description->file );
+	if( !plugin_lib.load() )
 	{
-		return( nullptr );
+		qWarning() << plugin_lib.errorString();
+		return( false );
+	}
+
+	LADSPA_Descriptor_Function descriptorFunction =
+		( LADSPA_Descriptor_Function ) plugin_lib.resolve(
+						"ladspa_descriptor" );
+	if( descriptorFunction == nullptr )
+	{
+		return( false );
+	}
+
+	for( ladspaManagerDescription * description : m_ladspaManagerMap )
+	{
+		if( description->file == _description->file )
+		{
+			description->descriptorFunction = descriptorFunction;
+		}
 	}
+	return( true );
 }
 
 
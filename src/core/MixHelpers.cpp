@@ -24,6 +24,7 @@
 
 #include "MixHelpers.h"
 
+#include <algorithm>
 #include <cstdio>
 
 #include "lmms_math.h"
@@ -125,6 +126,30 @@ bool sanitize( sampleFrame * src, int frames )
 }
 
 
+bool sanitize( sample_t * src, int frames )
+{
+	if( !useNaNHandler() )
+	{
+		return false;
+	}
+
+	for( int f = 0; f < frames; ++f )
+	{
+		if( std::isinf( src[f] ) || std::isnan( src[f] ) )
+		{
+			#ifdef LMMS_DEBUG
+				printf("Bad data, clearing buffer. frame: ");
+				printf("%d: value %f\n", f, src[f]);
+			#endif
+			std::fill( src, src + frames, 0.0f );
+			return true;
+		}
+		src[f] = qBound( -1000.0f, src[f], 1000.0f );
+	}
+	return false;
+}
+
+
 struct AddOp
 {
 	void operator()( sampleFrame& dst, const sampleFrame& src ) const
@@ -324,5 +349,58 @@ void multiplyAndAddMultipliedJoined( sampleFrame* dst,
 	run<>( dst, srcLeft, srcRight, frames, MultiplyAndAddMultipliedOp(coeffDst, coeffSrc) );
 }
 
+
+
+void multiplyAndAddMultipliedChannel( sampleFrame* dst, const sample_t* src, int channel,
+										float coeffDst, float coeffSrc, int frames )
+{
+	for( int i = 0; i < frames; ++i )
+	{
+		dst[i][channel] = dst[i][channel]*coeffDst + src[i]*coeffSrc;
+	}
+}
+
+
+
+void deinterleave( sample_t* dst, const sampleFrame* src, int channel, int frames )
+{
+	for( int i = 0; i < frames; ++i )
+	{
+		dst[i] = src[i][channel];
+	}
+}
+
+
+
+void deinterleave( sample_t* dstLeft, sample_t* dstRight, const sampleFrame* src, int frames )
+{
+	for( int i = 0; i < frames; ++i )
+	{
+		dstLeft[i] = src[i][0];
+		dstRight[i] = src[i][1];
+	}
+}
+
+
+
+void interleave( sampleFrame* dst, const sample_t* src, int channel, int frames )
+{
+	for( int i = 0; i < frames; ++i )
+	{
+		dst[i][channel] = src[i];
+	}
+}
+
+
+
+void interleave( sampleFrame* dst, const sample_t* srcLeft, const sample_t* srcRight, int frames )
+{
+	for( int i = 0; i < frames; ++i )
+	{
+		dst[i][0] = srcLeft[i];
+		dst[i][1] = srcRight[i];
+	}
+}
+
 }
 
@@ -24,6 +24,7 @@
 
 #include <QDomElement>
 
+#include "AudioDevice.h"
 #include "AudioEngine.h"
 #include "AudioEngineWorkerThread.h"
 #include "BufferManager.h"
@@ -63,6 +64,7 @@ MixerChannel::MixerChannel( int idx, Model * _parent ) :
 	m_fxChain( nullptr ),
 	m_hasInput( false ),
 	m_stillRunning( false ),
+	m_sleeping( false ),
 	m_peakLeft( 0.0f ),
 	m_peakRight( 0.0f ),
 	m_buffer( new sampleFrame[Engine::audioEngine()->framesPerPeriod()] ),
@@ -163,19 +165,29 @@ void MixerChannel::doProcessing()
 		}
 
 
-		const float v = m_volumeModel.value();
-
-		if( m_hasInput )
+		// without input and running effects, the buffer stays silent, and
+		// the receivers skip this channel as well
+		m_sleeping = !m_hasInput && !m_fxChain.isRunning();
+		if( m_sleeping )
 		{
-			// only start fxchain when we have input...
-			m_fxChain.startRunning();
+			m_stillRunning = false;
 		}
+		else
+		{
+			const float v = m_volumeModel.value();
+
+			if( m_hasInput )
+			{
+				// only start fxchain when we have input...
+				m_fxChain.startRunning();
+			}
 
-		m_stillRunning = m_fxChain.processAudioBuffer( m_buffer, fpp, m_hasInput );
+			m_stillRunning = m_fxChain.processAudioBuffer( m_buffer, fpp, m_hasInput );
 
-		AudioEngine::StereoSample peakSamples = Engine::audioEngine()->getPeakValues(m_buffer, fpp);
-		m_peakLeft = qMax( m_peakLeft, peakSamples.left * v );
-		m_peakRight = qMax( m_peakRight, peakSamples.right * v );
+			AudioEngine::StereoSample peakSamples = Engine::audioEngine()->getPeakValues(m_buffer, fpp);
+			m_peakLeft = qMax( m_peakLeft, peakSamples.left * v );
+			m_peakRight = qMax( m_peakRight, peakSamples.right * v );
+		}
 	}
 	else
 	{
@@ -225,6 +237,8 @@ int Mixer::createChannel()
 	// reset channel state
 	clearChannel( index );
 
+	emit channelsChanged();
+
 	return index;
 }
 
@@ -366,6 +380,8 @@ void Mixer::deleteChannel( int index )
 	}
 
 	Engine::audioEngine()->doneChangeInModel();
+
+	emit channelsChanged();
 }
 
 
@@ -429,6 +445,8 @@ void Mixer::moveChannelLeft( int index )
 	// Update m_channelIndex of both channels
 	m_mixerChannels[index]->m_channelIndex = index;
 	m_mixerChannels[index - 1]->m_channelIndex = index -1;
+
+	emit channelsChanged();
 }
 
 
@@ -665,12 +683,18 @@ void Mixer::masterMix( sampleFrame * _buf )
 		: m_mixerChannels[0]->m_volumeModel.value();
 	MixHelpers::addSanitizedMultiplied( _buf, m_mixerChannels[0]->m_buffer, v, fpp );
 
+	Engine::audioEngine()->audioDev()->processMixerChannels( this );
+
 	// clear all channel buffers and
 	// reset channel process state
 	for( int i = 0; i < numChannels(); ++i)
 	{
-		BufferManager::clear( m_mixerChannels[i]->m_buffer,
-				Engine::audioEngine()->framesPerPeriod() );
+		// buffers of sleeping channels weren't touched
+		if( m_mixerChannels[i]->m_hasInput || !m_mixerChannels[i]->m_sleeping )
+		{
+			BufferManager::clear( m_mixerChannels[i]->m_buffer,
+					Engine::audioEngine()->framesPerPeriod() );
+		}
 		m_mixerChannels[i]->reset();
 		m_mixerChannels[i]->m_queued = false;
 		// also reset hasInput
@@ -816,6 +840,7 @@ void Mixer::loadSettings( const QDomElement & _this )
 		node = node.nextSibling();
 	}
 
+	emit channelsChanged();
 	emit dataChanged();
 }
 
@@ -827,3 +852,10 @@ void Mixer::validateChannelName( int index, int oldIndex )
 		m_mixerChannels[index]->m_name = tr( "Channel %1" ).arg( index );
 	}
 }
+
+
+void Mixer::renameChannel( int index, const QString & name )
+{
+	m_mixerChannels[index]->m_name = name;
+	emit channelsChanged();
+}
@@ -25,6 +25,8 @@
 
 #include "NotePlayHandle.h"
 
+#include <chrono>
+
 #include "lmms_constants.h"
 #include "AudioEngine.h"
 #include "BasicFilters.h"
@@ -77,7 +79,11 @@ NotePlayHandle::NotePlayHandle( InstrumentTrack* instrumentTrack,
 	m_songGlobalParentOffset( 0 ),
 	m_midiChannel( midiEventChannel >= 0 ? midiEventChannel : instrumentTrack->midiPort()->realOutputChannel() ),
 	m_origin( origin ),
-	m_frequencyNeedsUpdate( false )
+	m_frequencyNeedsUpdate( false ),
+	m_stolen( false ),
+	m_stealFramesLeft( 0 ),
+	m_level( n.getVolume() / static_cast<float>( DefaultVolume ) ),
+	m_renderTime( 0 )
 {
 	lock();
 	if( hasParent() == false )
@@ -110,6 +116,7 @@ NotePlayHandle::NotePlayHandle( InstrumentTrack* instrumentTrack,
 	if(m_instrumentTrack->instrument() && m_instrumentTrack->instrument()->flags() & Instrument::IsSingleStreamed )
 	{
 		setUsesBuffer( false );
+		m_instrumentTrack->instrument()->wakeUp();
 	}
 
 	setAudioPort( instrumentTrack->audioPort() );
@@ -258,7 +265,15 @@ void NotePlayHandle::play( sampleFrame * _working_buffer )
 	if( framesLeft() > 0 )
 	{
 		// play note!
+		const auto start = std::chrono::steady_clock::now();
 		m_instrumentTrack->playNote( this, _working_buffer );
+		m_renderTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start ).count();
+	}
+
+	if( m_stolen )
+	{
+		m_stealFramesLeft = qMax<f_cnt_t>( 0, m_stealFramesLeft - framesThisPeriod );
 	}
 
 	if( m_released && (!instrumentTrack()->isSustainPedalPressed() ||
@@ -326,7 +341,12 @@ void NotePlayHandle::play( sampleFrame * _working_buffer )
 
 f_cnt_t NotePlayHandle::framesLeft() const
 {
-	if( instrumentTrack()->isSustainPedalPressed() )
+	// a stolen note with sub-notes waits for them like after a normal release
+	if( m_stolen && m_subNotes.isEmpty() )
+	{
+		return m_stealFramesLeft;
+	}
+	else if( instrumentTrack()->isSustainPedalPressed() )
 	{
 		return 4 * Engine::audioEngine()->framesPerPeriod();
 	}
@@ -409,6 +429,26 @@ void NotePlayHandle::noteOff( const f_cnt_t _s )
 
 
 
+void NotePlayHandle::steal()
+{
+	lock();
+	if( !m_stolen )
+	{
+		m_stolen = true;
+		m_stealFramesLeft = m_totalFramesPlayed > 0
+				? Engine::audioEngine()->framesPerPeriod() : 0;
+		noteOff( 0 );
+		for( NotePlayHandle * n : m_subNotes )
+		{
+			n->steal();
+		}
+	}
+	unlock();
+}
+
+
+
+
 f_cnt_t NotePlayHandle::actualReleaseFramesToDo() const
 {
 	return m_instrumentTrack->m_soundShaping.releaseFrames();
@@ -0,0 +1,225 @@
+/*
+ * Oversampler.cpp - polyphase half-band up- and downsampling
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "Oversampler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <QtGlobal>
+
+#include "lmms_constants.h"
+
+
+namespace
+{
+
+// the half-band filter has 4 * M - 1 taps, every second one being zero
+// except for the center tap, which is 0.5
+constexpr int M = 12;
+constexpr int BranchTaps = 2 * M;
+constexpr int FilterLength = 4 * M - 1;
+constexpr int UpHistory = BranchTaps - 1;
+// two more frames for the padding of the inner stages
+constexpr int DownHistory = 4 * M;
+// delay of the up- and downsampling of a stage at its lower rate, the inner
+// stages are padded by one frame to keep the total an integer in the end
+constexpr int StageDelay = 2 * M - 1;
+static_assert( M % 2 == 0, "the padded stage delays must be divisible by 4" );
+
+//! the non-zero, non-center taps of the half-band filter
+const std::array<float, BranchTaps> & branchCoeffs()
+{
+	static const std::array<float, BranchTaps> coeffs = []
+	{
+		std::array<float, BranchTaps> c;
+		const int center = ( FilterLength - 1 ) / 2;
+		double sum = 0.0;
+		for( int j = 0; j < BranchTaps; ++j )
+		{
+			// windowed sinc with cutoff at a quarter of the sample rate
+			const int k = 2 * j;
+			const double x = 0.5 * ( k - center );
+			const double sinc = std::sin( LD_PI * x ) / ( LD_PI * x );
+			const double window = 0.42
+				- 0.5 * std::cos( 2.0 * LD_PI * k / ( FilterLength - 1 ) )
+				+ 0.08 * std::cos( 4.0 * LD_PI * k / ( FilterLength - 1 ) );
+			c[j] = static_cast<float>( 0.5 * sinc * window );
+			sum += c[j];
+		}
+		// unity gain at DC: the branch must sum up to 0.5, like the center
+		for( float & v : c )
+		{
+			v = static_cast<float>( v * 0.5 / sum );
+		}
+		return c;
+	}();
+	return coeffs;
+}
+
+}
+
+
+
+
+Oversampler::Oversampler( fpp_t maxFrames ) :
+	m_stages( 0 )
+{
+	for( int s = 0; s < MaxStages; ++s )
+	{
+		m_stage[s].up.resize( UpHistory + ( maxFrames << s ) );
+		m_stage[s].down.resize( DownHistory + ( maxFrames << ( s + 1 ) ) );
+	}
+	m_scratch[0].resize( maxFrames << MaxStages );
+	m_scratch[1].resize( maxFrames << MaxStages );
+	m_buffer.resize( maxFrames << MaxStages );
+}
+
+
+
+
+void Oversampler::setStages( int stages )
+{
+	m_stages = qBound( 0, stages, MaxStages );
+	for( Stage & stage : m_stage )
+	{
+		std::fill( stage.up.begin(), stage.up.end(), sampleFrame() );
+		std::fill( stage.down.begin(), stage.down.end(), sampleFrame() );
+	}
+}
+
+
+
+
+void Oversampler::upsample( const sampleFrame * in, sampleFrame * out, fpp_t frames )
+{
+	if( m_stages == 0 )
+	{
+		std::copy( in, in + frames, out );
+		return;
+	}
+
+	const sampleFrame * src = in;
+	for( int s = 0; s < m_stages; ++s )
+	{
+		sampleFrame * dst = s == m_stages - 1
+					? out : m_scratch[s % 2].data();
+		upsampleStage( m_stage[s].up, src, dst, frames << s );
+		src = dst;
+	}
+}
+
+
+
+
+void Oversampler::downsample( const sampleFrame * in, sampleFrame * out, fpp_t frames )
+{
+	if( m_stages == 0 )
+	{
+		std::copy( in, in + frames, out );
+		return;
+	}
+
+	const sampleFrame * src = in;
+	for( int s = m_stages - 1; s >= 0; --s )
+	{
+		sampleFrame * dst = s == 0 ? out : m_scratch[s % 2].data();
+		downsampleStage( m_stage[s].down, src, dst, frames << s, s > 0 );
+		src = dst;
+	}
+}
+
+
+
+
+f_cnt_t Oversampler::latency() const
+{
+	if( m_stages == 0 )
+	{
+		return 0;
+	}
+	f_cnt_t frames = StageDelay;
+	for( int s = 1; s < m_stages; ++s )
+	{
+		frames += ( StageDelay + 1 ) >> s;
+	}
+	return frames;
+}
+
+
+
+
+void Oversampler::upsampleStage( std::vector<sampleFrame> & work,
+			const sampleFrame * in, sampleFrame * out, fpp_t frames )
+{
+	const std::array<float, BranchTaps> & c = branchCoeffs();
+	sampleFrame * x = work.data();
+	std::copy( in, in + frames, x + UpHistory );
+
+	for( fpp_t i = 0; i < frames; ++i )
+	{
+		const int p = UpHistory + i;
+		float l = 0.0f;
+		float r = 0.0f;
+		for( int j = 0; j < BranchTaps; ++j )
+		{
+			l += c[j] * x[p - j][0];
+			r += c[j] * x[p - j][1];
+		}
+		// zero stuffing halves the level, so the branch is doubled,
+		// while the center tap (0.5 * 2) just delays the input
+		out[2 * i] = { 2.0f * l, 2.0f * r };
+		out[2 * i + 1] = x[p - ( M - 1 )];
+	}
+
+	std::copy( x + frames, x + frames + UpHistory, x );
+}
+
+
+
+
+void Oversampler::downsampleStage( std::vector<sampleFrame> & work,
+			const sampleFrame * in, sampleFrame * out, fpp_t frames,
+			bool pad )
+{
+	const std::array<float, BranchTaps> & c = branchCoeffs();
+	sampleFrame * v = work.data();
+	std::copy( in, in + 2 * frames, v + DownHistory );
+
+	for( fpp_t n = 0; n < frames; ++n )
+	{
+		// filtering and decimating on even samples keeps the delay of a
+		// stage an integer number of frames at its lower rate, padding
+		// makes it divisible by the rate of the stage
+		const int p = DownHistory + 2 * n - ( pad ? 2 : 0 );
+		float l = 0.5f * v[p - ( 2 * M - 1 )][0];
+		float r = 0.5f * v[p - ( 2 * M - 1 )][1];
+		for( int j = 0; j < BranchTaps; ++j )
+		{
+			l += c[j] * v[p - 2 * j][0];
+			r += c[j] * v[p - 2 * j][1];
+		}
+		out[n] = { l, r };
+	}
+
+	std::copy( v + 2 * frames, v + 2 * frames + DownHistory, v );
+}
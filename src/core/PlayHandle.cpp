@@ -24,6 +24,8 @@
  
 #include "PlayHandle.h"
 #include "AudioEngine.h"
+#include "AudioEngineWorkerThread.h"
+#include "AudioPort.h"
 #include "BufferManager.h"
 #include "Engine.h"
 
@@ -36,7 +38,7 @@ PlayHandle::PlayHandle(const Type type, f_cnt_t offset) :
 		m_type(type),
 		m_offset(offset),
 		m_affinity(QThread::currentThread()),
-		m_playHandleBuffer(BufferManager::acquire()),
+		m_playHandleBuffer(accumulates() ? nullptr : BufferManager::acquire()),
 		m_bufferReleased(true),
 		m_usesBuffer(true)
 {
@@ -45,13 +47,25 @@ PlayHandle::PlayHandle(const Type type, f_cnt_t offset) :
 
 PlayHandle::~PlayHandle()
 {
-	BufferManager::release(m_playHandleBuffer);
+	if (m_playHandleBuffer)
+	{
+		BufferManager::release(m_playHandleBuffer);
+	}
 }
 
 
 void PlayHandle::doProcessing()
 {
-	if( m_usesBuffer )
+	if( m_usesBuffer && accumulates() )
+	{
+		// render into a buffer of the worker thread, which is still in cache
+		// for the next voice, and mix it into the track right away
+		sampleFrame* scratch = AudioEngineWorkerThread::scratchBuffer();
+		BufferManager::clear(scratch, Engine::audioEngine()->framesPerPeriod());
+		play( scratch );
+		m_audioPort->accumulate(scratch);
+	}
+	else if( m_usesBuffer )
 	{
 		m_bufferReleased = false;
 		BufferManager::clear(m_playHandleBuffer, Engine::audioEngine()->framesPerPeriod());
@@ -217,7 +217,7 @@ Plugin * Plugin::instantiate(const QString& pluginName, Model * parent,
 	const PluginFactory::PluginInfo& pi = getPluginFactory()->pluginInfo(pluginName.toUtf8());
 
 	Plugin* inst;
-	if( pi.isNull() )
+	if( pi.isNull() || !getPluginFactory()->load( pi ) )
 	{
 		if( getGUI() != nullptr )
 		{
@@ -0,0 +1,158 @@
+/*
+ * PluginCache.cpp - persistent cache for plugin metadata
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "PluginCache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include "lmmsversion.h"
+
+
+PluginCache::PluginCache( const QString & name ) :
+	m_fileName( QStandardPaths::writableLocation( QStandardPaths::CacheLocation )
+					+ "/" + name + ".json" ),
+	m_modified( false )
+{
+	QFile file( m_fileName );
+	if( !file.open( QIODevice::ReadOnly ) )
+	{
+		return;
+	}
+
+	const QJsonObject root = QJsonDocument::fromJson( file.readAll() ).object();
+	// plugins might be rejected differently by other versions
+	if( root.value( "version" ).toString() == LMMS_VERSION )
+	{
+		m_entries = root.value( "entries" ).toObject();
+	}
+}
+
+
+
+
+PluginCache::~PluginCache()
+{
+	save();
+}
+
+
+
+
+QPair<qint64, qint64> PluginCache::stamp( const QFileInfo & file )
+{
+	if( !file.isDir() )
+	{
+		return qMakePair( file.lastModified().toMSecsSinceEpoch(), file.size() );
+	}
+
+	// several plugins can share a directory, so it's only walked once
+	const QString path = file.absoluteFilePath();
+	if( !m_directoryStamps.contains( path ) )
+	{
+		qint64 mtime = file.lastModified().toMSecsSinceEpoch();
+		qint64 size = 0;
+		QDirIterator it( path, QDir::AllEntries | QDir::Hidden |
+				QDir::System | QDir::NoDotAndDotDot, QDirIterator::Subdirectories );
+		while( it.hasNext() )
+		{
+			it.next();
+			const QFileInfo & entry = it.fileInfo();
+			mtime = qMax( mtime, entry.lastModified().toMSecsSinceEpoch() );
+			if( !entry.isDir() ) { size += entry.size(); }
+		}
+		m_directoryStamps.insert( path, qMakePair( mtime, size ) );
+	}
+	return m_directoryStamps.value( path );
+}
+
+
+
+
+QJsonObject PluginCache::entry( const QFileInfo & file )
+{
+	const QString path = file.absoluteFilePath();
+	const QJsonObject cached = m_entries.value( path ).toObject();
+	if( cached.isEmpty() )
+	{
+		return QJsonObject();
+	}
+	const QPair<qint64, qint64> fileStamp = stamp( file );
+	if( cached.value( "mtime" ).toString() != QString::number( fileStamp.first )
+		|| cached.value( "size" ).toString() != QString::number( fileStamp.second ) )
+	{
+		return QJsonObject();
+	}
+
+	m_usedEntries.insert( path, cached );
+	return cached.value( "data" ).toObject();
+}
+
+
+
+
+void PluginCache::setEntry( const QFileInfo & file, const QJsonObject & data )
+{
+	const QPair<qint64, qint64> fileStamp = stamp( file );
+	QJsonObject cached;
+	cached.insert( "mtime", QString::number( fileStamp.first ) );
+	cached.insert( "size", QString::number( fileStamp.second ) );
+	cached.insert( "data", data );
+
+	const QString path = file.absoluteFilePath();
+	m_entries.insert( path, cached );
+	m_usedEntries.insert( path, cached );
+	m_modified = true;
+}
+
+
+
+
+void PluginCache::save()
+{
+	// also drop the entries of files which have been removed
+	if( !m_modified && m_usedEntries.size() == m_entries.size() )
+	{
+		return;
+	}
+
+	QDir().mkpath( QFileInfo( m_fileName ).absolutePath() );
+
+	QJsonObject root;
+	root.insert( "version", QString( LMMS_VERSION ) );
+	root.insert( "entries", m_usedEntries );
+
+	QSaveFile file( m_fileName );
+	if( file.open( QIODevice::WriteOnly ) )
+	{
+		file.write( QJsonDocument( root ).toJson( QJsonDocument::Compact ) );
+		file.commit();
+	}
+
+	m_entries = m_usedEntries;
+	m_modified = false;
+}
@@ -27,12 +27,14 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
+#include <QtCore/QJsonObject>
 #include <QtCore/QLibrary>
 #include <memory>
 #include "lmmsconfig.h"
 
 #include "ConfigManager.h"
 #include "Plugin.h"
+#include "PluginCache.h"
 #include "embed.h"
 
 #ifdef LMMS_BUILD_WIN32
@@ -48,6 +50,88 @@ qint64 qHash(const QFileInfo& fi)
 
 std::unique_ptr<PluginFactory> PluginFactory::s_instance;
 
+
+static Plugin::Descriptor* resolveDescriptor(QLibrary& library, const QFileInfo& file)
+{
+	QString descriptorName = file.baseName() + "_plugin_descriptor";
+	if( descriptorName.left(3) == "lib" )
+	{
+		descriptorName = descriptorName.mid(3);
+	}
+
+	Plugin::Descriptor* descriptor = reinterpret_cast<Plugin::Descriptor*>(library.resolve(descriptorName.toUtf8().constData()));
+	if(descriptor == nullptr)
+	{
+		qWarning() << qApp->translate("PluginFactory", "LMMS plugin %1 does not have a plugin descriptor named %2!").
+					  arg(file.absoluteFilePath()).arg(descriptorName);
+	}
+	return descriptor;
+}
+
+
+//! The logo of a plugin which is not loaded yet, loads it when it is shown
+class LibraryPixmapLoader : public PixmapLoader
+{
+public:
+	LibraryPixmapLoader(const QString& name, const PluginFactory::PluginInfo& info) :
+		PixmapLoader(name),
+		m_info(info)
+	{
+	}
+
+	QPixmap pixmap() const override
+	{
+		if (PluginFactory::instance()->load(m_info))
+		{
+			const Plugin::Descriptor* descriptor =
+				resolveDescriptor(*m_info.library, m_info.file);
+			if (descriptor && descriptor->logo)
+			{
+				return descriptor->logo->pixmap();
+			}
+		}
+		return QPixmap();
+	}
+
+private:
+	PluginFactory::PluginInfo m_info;
+} ;
+
+
+//! A descriptor read from the cache, with the strings it points to
+struct PluginFactory::CachedPlugin
+{
+	QByteArray name;
+	QByteArray displayName;
+	QByteArray description;
+	QByteArray author;
+	QByteArray supportedFileTypes;
+	std::unique_ptr<LibraryPixmapLoader> logo;
+	Plugin::Descriptor descriptor = {};
+};
+
+
+//! The data of @p descriptor needed to use it without loading its library
+static QJsonObject describePlugin(const Plugin::Descriptor* descriptor)
+{
+	QJsonObject entry;
+	entry["plugin"] = true;
+	// listing sub plugins needs the library, so these are always loaded
+	entry["subPlugins"] = descriptor->subPluginFeatures != nullptr;
+	entry["name"] = QString::fromUtf8(descriptor->name);
+	entry["displayName"] = QString::fromUtf8(descriptor->displayName);
+	entry["description"] = QString::fromUtf8(descriptor->description);
+	entry["author"] = QString::fromUtf8(descriptor->author);
+	entry["version"] = descriptor->version;
+	entry["type"] = static_cast<int>(descriptor->type);
+	if (descriptor->logo) { entry["logo"] = descriptor->logo->pixmapName(); }
+	if (descriptor->supportedFileTypes)
+	{
+		entry["supportedFileTypes"] = QString::fromUtf8(descriptor->supportedFileTypes);
+	}
+	return entry;
+}
+
 PluginFactory::PluginFactory()
 {
 	setupSearchPaths();
@@ -141,11 +225,35 @@ QString PluginFactory::errorString(QString pluginName) const
 	return m_errors.value(pluginName, notfound);
 }
 
+bool PluginFactory::load(const PluginInfo& info)
+{
+	if (info.isNull()) { return false; }
+	if (info.library->isLoaded()) { return true; }
+
+	if (!info.library->load())
+	{
+		// it may depend on a library which has not been loaded this time
+		for (const QFileInfo& file : m_dependencies)
+		{
+			QLibrary(file.absoluteFilePath()).load();
+		}
+		if (!info.library->load())
+		{
+			m_errors[info.descriptor ? info.name() : info.file.baseName()] =
+				info.library->errorString();
+			qWarning("%s", info.library->errorString().toLocal8Bit().data());
+			return false;
+		}
+	}
+	return true;
+}
+
 void PluginFactory::discoverPlugins()
 {
 	DescriptorMap descriptors;
 	PluginInfoList pluginInfos;
 	m_pluginByExt.clear();
+	m_dependencies.clear();
 
 	QSet<QFileInfo> files;
 	for (const QString& searchPath : QDir::searchPaths("plugins"))
@@ -158,45 +266,77 @@ void PluginFactory::discoverPlugins()
 #endif
 	}
 
-	// Cheap dependency handling: zynaddsubfx needs ZynAddSubFxCore. By loading
-	// all libraries twice we ensure that libZynAddSubFxCore is found.
+	// libraries are only loaded if they are not in the cache, have sub
+	// plugins, or when a plugin is actually used
+	PluginCache cache("plugins");
+	QHash<QString, QJsonObject> entries;
+	QList<QFileInfo> uncached;
 	for (const QFileInfo& file : files)
 	{
-		QLibrary(file.absoluteFilePath()).load();
+		const QJsonObject entry = cache.entry(file);
+		if (entry.isEmpty()) { uncached << file; }
+		else if (!entry.value("plugin").toBool()) { m_dependencies << file; }
+		entries[file.absoluteFilePath()] = entry;
 	}
 
-	for (const QFileInfo& file : files)
+	// Cheap dependency handling: zynaddsubfx needs ZynAddSubFxCore. By loading
+	// all new libraries twice we ensure that libZynAddSubFxCore is found.
+	if (!uncached.isEmpty())
 	{
-		auto library = std::make_shared<QLibrary>(file.absoluteFilePath());
-		if (! library->load()) {
-			m_errors[file.baseName()] = library->errorString();
-			qWarning("%s", library->errorString().toLocal8Bit().data());
-			continue;
+		for (const QFileInfo& file : m_dependencies + uncached)
+		{
+			QLibrary(file.absoluteFilePath()).load();
 		}
+	}
+
+	for (const QFileInfo& file : files)
+	{
+		const QJsonObject entry = entries.value(file.absoluteFilePath());
+		if (!entry.isEmpty() && !entry.value("plugin").toBool()) { continue; }
+
+		PluginInfo info;
+		info.file = file;
+		info.library = std::make_shared<QLibrary>(file.absoluteFilePath());
 
 		Plugin::Descriptor* pluginDescriptor = nullptr;
-		if (library->resolve("lmms_plugin_main"))
+		if (!entry.isEmpty() && !entry.value("subPlugins").toBool())
 		{
-			QString descriptorName = file.baseName() + "_plugin_descriptor";
-			if( descriptorName.left(3) == "lib" )
-			{
-				descriptorName = descriptorName.mid(3);
+			pluginDescriptor = cachedDescriptor(entry, info);
+		}
+		else if (!entry.isEmpty())
+		{
+			if (!load(info)) { continue; }
+			pluginDescriptor = resolveDescriptor(*info.library, file);
+		}
+		else
+		{
+			auto library = info.library;
+			if (! library->load()) {
+				m_errors[file.baseName()] = library->errorString();
+				qWarning("%s", library->errorString().toLocal8Bit().data());
+				continue;
 			}
 
-			pluginDescriptor = reinterpret_cast<Plugin::Descriptor*>(library->resolve(descriptorName.toUtf8().constData()));
-			if(pluginDescriptor == nullptr)
+			if (library->resolve("lmms_plugin_main"))
 			{
-				qWarning() << qApp->translate("PluginFactory", "LMMS plugin %1 does not have a plugin descriptor named %2!").
-							  arg(file.absoluteFilePath()).arg(descriptorName);
-				continue;
+				pluginDescriptor = resolveDescriptor(*library, file);
+				if (pluginDescriptor)
+				{
+					cache.setEntry(file, describePlugin(pluginDescriptor));
+				}
+			}
+			else
+			{
+				// also cache libraries which are no plugins
+				QJsonObject dependency;
+				dependency["plugin"] = false;
+				cache.setEntry(file, dependency);
+				m_dependencies << file;
 			}
 		}
 
 		if(pluginDescriptor)
 		{
-			PluginInfo info;
-			info.file = file;
-			info.library = library;
 			info.descriptor = pluginDescriptor;
 			pluginInfos << info;
 
@@ -246,6 +386,38 @@ void PluginFactory::discoverPlugins()
 	m_descriptors = descriptors;
 }
 
+Plugin::Descriptor* PluginFactory::cachedDescriptor(const QJsonObject& entry, PluginInfo& info)
+{
+	auto cached = std::make_unique<CachedPlugin>();
+	cached->name = entry.value("name").toString().toUtf8();
+	cached->displayName = entry.value("displayName").toString().toUtf8();
+	cached->description = entry.value("description").toString().toUtf8();
+	cached->author = entry.value("author").toString().toUtf8();
+	cached->supportedFileTypes = entry.value("supportedFileTypes").toString().toUtf8();
+	Plugin::Descriptor& descriptor = cached->descriptor;
+	descriptor.name = cached->name.constData();
+	descriptor.displayName = cached->displayName.constData();
+	descriptor.description = cached->description.constData();
+	descriptor.author = cached->author.constData();
+	descriptor.version = entry.value("version").toInt();
+	descriptor.type = static_cast<Plugin::PluginTypes>(entry.value("type").toInt());
+	descriptor.supportedFileTypes = entry.contains("supportedFileTypes")
+		? cached->supportedFileTypes.constData()
+		: nullptr;
+	descriptor.subPluginFeatures = nullptr;
+	info.descriptor = &descriptor;
+
+	if (entry.contains("logo"))
+	{
+		cached->logo = std::make_unique<LibraryPixmapLoader>(
+			entry.value("logo").toString(), info);
+		descriptor.logo = cached->logo.get();
+	}
+
+	m_cachedPlugins.push_back(std::move(cached));
+	return &descriptor;
+}
+
 
 
 const QString PluginFactory::PluginInfo::name() const
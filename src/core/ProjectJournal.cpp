@@ -23,8 +23,14 @@
  */
 
 #include <cstdlib>
+#include <deque>
+
+#include <QtCore/QTextStream>
+#include <QtCore/QThread>
+#include <QtCore/QWaitCondition>
 
 #include "ProjectJournal.h"
+#include "ConfigManager.h"
 #include "Engine.h"
 #include "JournallingObject.h"
 #include "Song.h"
@@ -33,13 +39,121 @@
 //! and newly created IDs (have the bit set)
 static const int EO_ID_MSB = 1 << 23;
 
-const int ProjectJournal::MAX_UNDO_STATES = 100; // TODO: make this configurable in settings
+const int ProjectJournal::DEFAULT_UNDO_MEMORY_MB = 64;
+
+
+
+
+//! Compresses snapshots after they were pushed, so adding a checkpoint
+//! costs no more than serializing the object
+class ProjectJournal::Compressor : public QThread
+{
+public:
+	Compressor() :
+		m_quit( false )
+	{
+		start( QThread::LowPriority );
+	}
+
+	~Compressor() override
+	{
+		m_mutex.lock();
+		m_quit = true;
+		m_cond.wakeOne();
+		m_mutex.unlock();
+		wait();
+	}
+
+	void add( const SnapshotPtr & snapshot )
+	{
+		QMutexLocker lock( &m_mutex );
+		m_queue.push_back( snapshot );
+		m_cond.wakeOne();
+	}
+
+private:
+	void run() override
+	{
+		m_mutex.lock();
+		while( !m_quit )
+		{
+			if( m_queue.empty() )
+			{
+				m_cond.wait( &m_mutex );
+				continue;
+			}
+			// snapshots dropped from the history meanwhile are skipped
+			SnapshotPtr snapshot = m_queue.front().lock();
+			m_queue.pop_front();
+			m_mutex.unlock();
+			if( snapshot )
+			{
+				snapshot->compress();
+			}
+			m_mutex.lock();
+		}
+		m_mutex.unlock();
+	}
+
+	QMutex m_mutex;
+	QWaitCondition m_cond;
+	std::deque<std::weak_ptr<Snapshot>> m_queue;
+	bool m_quit;
+} ;
+
+
+
+
+int ProjectJournal::Snapshot::size() const
+{
+	QMutexLocker lock( &m_mutex );
+	return m_data.size();
+}
+
+
+
+
+QByteArray ProjectJournal::Snapshot::xml() const
+{
+	m_mutex.lock();
+	const QByteArray data = m_data;
+	const bool compressed = m_compressed;
+	m_mutex.unlock();
+	return compressed ? qUncompress( data ) : data;
+}
+
+
+
+
+void ProjectJournal::Snapshot::compress()
+{
+	m_mutex.lock();
+	const QByteArray xml = m_data;
+	const bool compressed = m_compressed;
+	m_mutex.unlock();
+	if( compressed )
+	{
+		return;
+	}
+
+	const QByteArray data = qCompress( xml );
+	if( data.size() < xml.size() )
+	{
+		QMutexLocker lock( &m_mutex );
+		m_data = data;
+		m_compressed = true;
+	}
+}
+
+
+
 
 ProjectJournal::ProjectJournal() :
 	m_joIDs(),
 	m_undoCheckPoints(),
 	m_redoCheckPoints(),
-	m_journalling( false )
+	m_journalling( false ),
+	m_compressor( new Compressor )
 {
 }
 
@@ -62,15 +176,8 @@ void ProjectJournal::undo()
 
 		if( jo )
 		{
-			DataFile curState( DataFile::JournalData );
-			jo->saveState( curState, curState.content() );
-			m_redoCheckPoints.push( CheckPoint( c.joID, curState ) );
-
-			bool prev = isJournalling();
-			setJournalling( false );
-			jo->restoreState( c.data.content().firstChildElement() );
-			setJournalling( prev );
-			Engine::getSong()->setModified();
+			m_redoCheckPoints.push( CheckPoint( c.joID, saveSnapshot( jo ) ) );
+			restoreSnapshot( jo, *c.data );
 			break;
 		}
 	}
@@ -87,15 +194,8 @@ void ProjectJournal::redo()
 
 		if( jo )
 		{
-			DataFile curState( DataFile::JournalData );
-			jo->saveState( curState, curState.content() );
-			m_undoCheckPoints.push( CheckPoint( c.joID, curState ) );
-
-			bool prev = isJournalling();
-			setJournalling( false );
-			jo->restoreState( c.data.content().firstChildElement() );
-			setJournalling( prev );
-			Engine::getSong()->setModified();
+			m_undoCheckPoints.push( CheckPoint( c.joID, saveSnapshot( jo ) ) );
+			restoreSnapshot( jo, *c.data );
 			break;
 		}
 	}
@@ -119,14 +219,77 @@ void ProjectJournal::addJournalCheckPoint( JournallingObject *jo )
 	{
 		m_redoCheckPoints.clear();
 
-		DataFile dataFile( DataFile::JournalData );
-		jo->saveState( dataFile, dataFile.content() );
+		m_undoCheckPoints.push( CheckPoint( jo->id(), saveSnapshot( jo ) ) );
+		limitMemory();
+	}
+}
+
+
+
+
+ProjectJournal::SnapshotPtr ProjectJournal::saveSnapshot( JournallingObject * jo )
+{
+	DataFile dataFile( DataFile::JournalData );
+	jo->saveState( dataFile, dataFile.content() );
+
+	// only the journal data element is kept, as unindented XML, which is a
+	// fraction of the size of the DOM and compresses well
+	QByteArray xml;
+	QTextStream stream( &xml );
+	stream.setCodec( "UTF-8" );
+	dataFile.content().save( stream, -1 );
+	stream.flush();
+
+	SnapshotPtr snapshot = std::make_shared<Snapshot>( xml );
+	m_compressor->add( snapshot );
+	return snapshot;
+}
 
-		m_undoCheckPoints.push( CheckPoint( jo->id(), dataFile ) );
-		if( m_undoCheckPoints.size() > MAX_UNDO_STATES )
+
+
+
+void ProjectJournal::restoreSnapshot( JournallingObject * jo, const Snapshot & snapshot )
+{
+	// restoreState() of some objects looks for the journal data element
+	// above them, so the saved element becomes the document element
+	QDomDocument doc;
+	doc.setContent( snapshot.xml() );
+
+	bool prev = isJournalling();
+	setJournalling( false );
+	jo->restoreState( doc.documentElement().firstChildElement() );
+	setJournalling( prev );
+	Engine::getSong()->setModified();
+}
+
+
+
+
+void ProjectJournal::limitMemory()
+{
+	const int limitMB = ConfigManager::inst()->value( "app", "undomemory" ).toInt();
+	const qint64 limit = qint64( limitMB > 0 ? limitMB : DEFAULT_UNDO_MEMORY_MB )
+							* 1024 * 1024;
+
+	qint64 used = 0;
+	for( const CheckPoint & c : m_redoCheckPoints )
+	{
+		used += c.data->size();
+	}
+	// always keep the last step, however large it is
+	int keep = 0;
+	for( int i = m_undoCheckPoints.size() - 1; i >= 0; --i )
+	{
+		used += m_undoCheckPoints[i].data->size();
+		if( keep > 0 && used > limit )
 		{
-			m_undoCheckPoints.remove( 0, m_undoCheckPoints.size() - MAX_UNDO_STATES );
+			break;
 		}
+		++keep;
+	}
+	if( keep < m_undoCheckPoints.size() )
+	{
+		m_undoCheckPoints.remove( 0, m_undoCheckPoints.size() - keep );
 	}
 }
 
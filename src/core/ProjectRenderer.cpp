@@ -23,6 +23,7 @@
  */
 
 
+#include <QElapsedTimer>
 #include <QFile>
 
 #include "ProjectRenderer.h"
@@ -84,9 +85,20 @@ ProjectRenderer::ProjectRenderer( const AudioEngine::qualitySettings & qualitySe
 	QThread( Engine::audioEngine() ),
 	m_fileDev( nullptr ),
 	m_qualitySettings( qualitySettings ),
+	m_blocks( BlockCount ),
+	m_freeBlocks( BlockCount ),
+	m_renderedBlocks( BlockCount + 1 ),
 	m_progress( 0 ),
-	m_abort( false )
+	m_abort( false ),
+	m_realTimeFactor( 0 )
 {
+	for( Block & block : m_blocks )
+	{
+		block.data.resize( BlockFrames );
+		block.frames = 0;
+		m_freeBlocks.write( &block );
+	}
+
 	AudioFileDeviceInstantiaton audioEncoderFactory = fileEncodeDevices[exportFileFormat].m_getDevInst;
 
 	if (audioEncoderFactory)
@@ -178,20 +190,55 @@ void ProjectRenderer::run()
 #endif
 
 	PerfLogTimer perfLog("Project Render");
+	QElapsedTimer timer;
+	timer.start();
 
 	Engine::getSong()->startExport();
 	// Skip first empty buffer.
 	Engine::audioEngine()->nextBuffer();
 
 	m_progress = 0;
+	f_cnt_t framesRendered = 0;
 
 	// Now start processing
 	Engine::audioEngine()->startProcessing(false);
 
+	// The encoder runs in parallel, so rendering only waits for it if
+	// all blocks are still queued for encoding
+	EncoderThread encoder( this );
+	encoder.start();
+
+	const fpp_t period = Engine::audioEngine()->framesPerPeriod();
+	Block * block = m_freeBlocks.read();
+	block->frames = 0;
+
 	// Continually track and emit progress percentage to listeners.
 	while (!Engine::getSong()->isExportDone() && !m_abort)
 	{
-		m_fileDev->processNextBuffer();
+		if (block->frames + period > BlockFrames)
+		{
+			m_renderedBlocks.write( block );
+			block = m_freeBlocks.read();
+			block->frames = 0;
+		}
+
+		surroundSampleFrame * buf = block->data.data() + block->frames;
+		const fpp_t frames = m_fileDev->fetchBuffer( buf );
+		if (frames == 0) { break; }
+
+		// apply the gain now, the master volume might change until the
+		// block is encoded
+		const float gain = Engine::audioEngine()->masterGain();
+		if (gain != 1.0f)
+		{
+			for (fpp_t f = 0; f < frames; ++f)
+			{
+				for (auto & sample : buf[f]) { sample *= gain; }
+			}
+		}
+		block->frames += frames;
+		framesRendered += frames;
+
 		const int nprog = Engine::getSong()->getExportProgress();
 		if (m_progress != nprog)
 		{
@@ -200,12 +247,20 @@ void ProjectRenderer::run()
 		}
 	}
 
+	m_renderedBlocks.write( block );
+	m_renderedBlocks.write( nullptr );
+	encoder.wait();
+
 	// Notify the audio engine of the end of processing.
 	Engine::audioEngine()->stopProcessing();
 
 	Engine::getSong()->stopExport();
 
 	perfLog.end();
+	const qint64 elapsed = timer.elapsed();
+	m_realTimeFactor = elapsed > 0
+		? framesRendered * 1000.0 / m_fileDev->sampleRate() / elapsed
+		: 0.0;
 
 	// If the user aborted export-process, the file has to be deleted.
 	const QString f = m_fileDev->outputFile();
@@ -218,6 +273,21 @@ void ProjectRenderer::run()
 
 
 
+void ProjectRenderer::encode()
+{
+	while (Block * block = m_renderedBlocks.read())
+	{
+		if (block->frames > 0)
+		{
+			m_fileDev->encodeBuffer( block->data.data(), block->frames, 1.0f );
+		}
+		m_freeBlocks.write( block );
+	}
+}
+
+
+
+
 void ProjectRenderer::abortProcessing()
 {
 	m_abort = true;
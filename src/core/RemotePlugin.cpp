@@ -31,6 +31,7 @@
 #include "BufferManager.h"
 #include "RemotePlugin.h"
 #include "AudioEngine.h"
+#include "ConfigManager.h"
 #include "Engine.h"
 
 #include <QDebug>
@@ -94,7 +95,11 @@ RemotePlugin::RemotePlugin() :
 	m_shmSize( 0 ),
 	m_shm( nullptr ),
 	m_inputCount( DEFAULT_CHANNELS ),
-	m_outputCount( DEFAULT_CHANNELS )
+	m_outputCount( DEFAULT_CHANNELS ),
+	m_pipelined( false ),
+	m_currentSlot( 0 ),
+	m_pendingRequests( 0 ),
+	m_pipelineFilled( false )
 {
 #ifndef SYNC_WITH_SHM_FIFO
 	struct sockaddr_un sa;
@@ -310,7 +315,12 @@ bool RemotePlugin::process( const sampleFrame * _in_buf, sampleFrame * _out_buf
 		return false;
 	}
 
-	memset( m_shm, 0, m_shmSize );
+	// effects mix the output with their input, so they can't be delayed
+	const bool pipelined = m_pipelined && _in_buf == nullptr;
+	const int slot = pipelined ? m_currentSlot : 0;
+	float * shm = m_shm + slot * slotSize();
+
+	memset( shm, 0, slotSize() * sizeof( float ) );
 
 	ch_cnt_t inputs = qMin<ch_cnt_t>( m_inputCount, DEFAULT_CHANNELS );
 
@@ -322,18 +332,18 @@ bool RemotePlugin::process( const sampleFrame * _in_buf, sampleFrame * _out_buf
 			{
 				for( fpp_t frame = 0; frame < frames; ++frame )
 				{
-					m_shm[ch * frames + frame] =
+					shm[ch * frames + frame] =
 							_in_buf[frame][ch];
 				}
 			}
 		}
 		else if( inputs == DEFAULT_CHANNELS )
 		{
-			memcpy( m_shm, _in_buf, frames * BYTES_PER_FRAME );
+			memcpy( shm, _in_buf, frames * BYTES_PER_FRAME );
 		}
 		else
 		{
-			sampleFrame * o = (sampleFrame *) m_shm;
+			sampleFrame * o = (sampleFrame *) shm;
 			for( ch_cnt_t ch = 0; ch < inputs; ++ch )
 			{
 				for( fpp_t frame = 0; frame < frames; ++frame )
@@ -345,7 +355,8 @@ bool RemotePlugin::process( const sampleFrame * _in_buf, sampleFrame * _out_buf
 	}
 
 	lock();
-	sendMessage( IdStartProcessing );
+	sendMessage( message( IdStartProcessing ).addInt( slot ) );
+	++m_pendingRequests;
 
 	if( m_failed || _out_buf == nullptr || m_outputCount == 0 )
 	{
@@ -353,8 +364,27 @@ bool RemotePlugin::process( const sampleFrame * _in_buf, sampleFrame * _out_buf
 		return false;
 	}
 
-	waitForMessage( IdProcessingDone );
-	unlock();
+	if( pipelined )
+	{
+		// only wait for the previous period, the current one is being
+		// processed while the engine continues
+		waitForProcessing( 1 );
+		unlock();
+
+		m_currentSlot = 1 - slot;
+		shm = m_shm + m_currentSlot * slotSize();
+		if( !m_pipelineFilled )
+		{
+			m_pipelineFilled = true;
+			BufferManager::clear( _out_buf, frames );
+			return true;
+		}
+	}
+	else
+	{
+		waitForProcessing( 0 );
+		unlock();
+	}
 
 	const ch_cnt_t outputs = qMin<ch_cnt_t>( m_outputCount,
 							DEFAULT_CHANNELS );
@@ -364,19 +394,19 @@ bool RemotePlugin::process( const sampleFrame * _in_buf, sampleFrame * _out_buf
 		{
 			for( fpp_t frame = 0; frame < frames; ++frame )
 			{
-				_out_buf[frame][ch] = m_shm[( m_inputCount+ch )*
+				_out_buf[frame][ch] = shm[( m_inputCount+ch )*
 								frames + frame];
 			}
 		}
 	}
 	else if( outputs == DEFAULT_CHANNELS )
 	{
-		memcpy( _out_buf, m_shm + m_inputCount * frames,
+		memcpy( _out_buf, shm + m_inputCount * frames,
 						frames * BYTES_PER_FRAME );
 	}
 	else
 	{
-		sampleFrame * o = (sampleFrame *) ( m_shm +
+		sampleFrame * o = (sampleFrame *) ( shm +
 							m_inputCount*frames );
 		// clear buffer, if plugin didn't fill up both channels
 		BufferManager::clear( _out_buf, frames );
@@ -397,6 +427,57 @@ bool RemotePlugin::process( const sampleFrame * _in_buf, sampleFrame * _out_buf
 
 
 
+bool RemotePlugin::pipeliningEnabled()
+{
+	return ConfigManager::inst()->value(
+			"audioengine", "pipelineremoteplugins" ).toInt();
+}
+
+
+
+
+void RemotePlugin::setPipelined( bool _on )
+{
+	lock();
+	m_pipelined = _on;
+	m_pipelineFilled = false;
+	unlock();
+}
+
+
+
+
+f_cnt_t RemotePlugin::latency() const
+{
+	return m_pipelined ? Engine::audioEngine()->framesPerPeriod() : 0;
+}
+
+
+
+
+void RemotePlugin::waitForProcessing( int _max )
+{
+	while( m_pendingRequests > _max && !isInvalid() )
+	{
+		if( waitForMessage( IdProcessingDone ).id != IdProcessingDone )
+		{
+			break;
+		}
+	}
+}
+
+
+
+
+size_t RemotePlugin::slotSize() const
+{
+	return ( m_inputCount + m_outputCount ) *
+				Engine::audioEngine()->framesPerPeriod();
+}
+
+
+
+
 void RemotePlugin::processMidiEvent( const MidiEvent & _e,
 							const f_cnt_t _offset )
 {
@@ -430,7 +511,8 @@ void RemotePlugin::hideUI()
 
 void RemotePlugin::resizeSharedProcessingMemory()
 {
-	const size_t s = ( m_inputCount+m_outputCount ) * Engine::audioEngine()->framesPerPeriod() * sizeof( float );
+	// two slots, so one can be filled while the other one is processed
+	const size_t s = 2 * slotSize() * sizeof( float );
 	if( m_shm != nullptr )
 	{
 #ifdef USE_QT_SHMEM
@@ -459,6 +541,8 @@ void RemotePlugin::resizeSharedProcessingMemory()
 	m_shm = (float *) shmat( m_shmID, 0, 0 );
 #endif
 	m_shmSize = s;
+	// the other slot does not hold valid output anymore
+	m_pipelineFilled = false;
 	sendMessage( message( IdChangeSharedMemoryKey ).
 				addInt( shm_key ).addInt( m_shmSize ) );
 }
@@ -537,6 +621,12 @@ bool RemotePlugin::processMessage( const message & _m )
 			break;
 
 		case IdProcessingDone:
+			if( m_pendingRequests > 0 )
+			{
+				--m_pendingRequests;
+			}
+			break;
+
 		case IdQuit:
 		default:
 			break;
@@ -40,7 +40,9 @@ RenderManager::RenderManager(
 	m_oldQualitySettings( Engine::audioEngine()->currentQualitySettings() ),
 	m_outputSettings(outputSettings),
 	m_format(fmt),
-	m_outputPath(outputPath)
+	m_outputPath(outputPath),
+	m_realTimeFactorSum(0.0),
+	m_renderCount(0)
 {
 	Engine::audioEngine()->storeAudioDevice();
 }
@@ -64,6 +66,11 @@ void RenderManager::abortProcessing()
 // Called to render each new track when rendering tracks individually.
 void RenderManager::renderNextTrack()
 {
+	if( m_activeRenderer && m_activeRenderer->isReady() )
+	{
+		m_realTimeFactorSum += m_activeRenderer->realTimeFactor();
+		++m_renderCount;
+	}
 	m_activeRenderer.reset();
 
 	if( m_tracksToRender.isEmpty() )
@@ -131,6 +138,11 @@ void RenderManager::renderTracks()
 	renderNextTrack();
 }
 
+double RenderManager::realTimeFactor() const
+{
+	return m_renderCount > 0 ? m_realTimeFactorSum / m_renderCount : 0.0;
+}
+
 // Render the song into a single track
 void RenderManager::renderProject()
 {
@@ -26,12 +26,17 @@
 #include "Oscillator.h"
 
 #include <algorithm>
+#include <functional>
+#include <list>
 
 #include <QBuffer>
 #include <QFile>
 #include <QFileInfo>
+#include <QMutex>
 #include <QMessageBox>
 #include <QPainter>
+#include <QSemaphore>
+#include <QThreadPool>
 #include <QDebug>
 
 
@@ -60,10 +65,106 @@
 #include "GuiApplication.h"
 #include "lmms_constants.h"
 #include "PathUtil.h"
+#include "WaveformPeaks.h"
 
 #include "FileDialog.h"
 
 
+namespace
+{
+
+//! unique over all buffers, so swapped data never matches a cache entry
+quint64 newDataRevision()
+{
+	static std::atomic<quint64> revision(0);
+	return ++revision;
+}
+
+
+
+
+//! Results of toBase64(), so unchanged samples aren't encoded again on every
+//! save. The size is bounded, the least recently saved samples are dropped.
+class Base64Cache
+{
+public:
+	bool find(const SampleBuffer* buffer, quint64 revision, QString& dst)
+	{
+		QMutexLocker lock(&m_mutex);
+		for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+		{
+			if (it->buffer == buffer && it->revision == revision)
+			{
+				m_entries.splice(m_entries.begin(), m_entries, it);
+				dst = it->encoded;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void insert(const SampleBuffer* buffer, quint64 revision, const QString& encoded)
+	{
+		if (encoded.size() > MaxChars) { return; }
+
+		QMutexLocker lock(&m_mutex);
+		removeLocked(buffer);
+		m_entries.push_front({buffer, revision, encoded});
+		m_chars += encoded.size();
+		while (m_chars > MaxChars)
+		{
+			m_chars -= m_entries.back().encoded.size();
+			m_entries.pop_back();
+		}
+	}
+
+	void remove(const SampleBuffer* buffer)
+	{
+		QMutexLocker lock(&m_mutex);
+		removeLocked(buffer);
+	}
+
+private:
+	// 64 MB of UTF-16
+	static constexpr int MaxChars = 32 * 1024 * 1024;
+
+	struct Entry
+	{
+		const SampleBuffer* buffer;
+		quint64 revision;
+		QString encoded;
+	};
+
+	void removeLocked(const SampleBuffer* buffer)
+	{
+		for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+		{
+			if (it->buffer == buffer)
+			{
+				m_chars -= it->encoded.size();
+				m_entries.erase(it);
+				return;
+			}
+		}
+	}
+
+	// most recently used first
+	std::list<Entry> m_entries;
+	int m_chars = 0;
+	QMutex m_mutex;
+};
+
+Base64Cache& base64Cache()
+{
+	static Base64Cache cache;
+	return cache;
+}
+
+}
+
+
+
+
 SampleBuffer::SampleBuffer() :
 	m_userAntiAliasWaveTable(nullptr),
 	m_audioFile(""),
@@ -78,7 +179,9 @@ SampleBuffer::SampleBuffer() :
 	m_amplification(1.0f),
 	m_reversed(false),
 	m_frequency(DefaultBaseFreq),
-	m_sampleRate(audioEngineSampleRate())
+	m_sampleRate(audioEngineSampleRate()),
+	m_cancelPeaks(false),
+	m_dataRevision(newDataRevision())
 {
 
 	connect(Engine::audioEngine(), SIGNAL(sampleRateChanged()), this, SLOT(sampleRateChanged()));
@@ -134,7 +237,9 @@ SampleBuffer::SampleBuffer(const f_cnt_t frames)
 
 
 
-SampleBuffer::SampleBuffer(const SampleBuffer& orig)
+SampleBuffer::SampleBuffer(const SampleBuffer& orig) :
+	m_cancelPeaks(false),
+	m_dataRevision(newDataRevision())
 {
 	orig.m_varLock.lockForRead();
 
@@ -151,6 +256,8 @@ SampleBuffer::SampleBuffer(const SampleBuffer& orig)
 	m_reversed = orig.m_reversed;
 	m_frequency = orig.m_frequency;
 	m_sampleRate = orig.m_sampleRate;
+	// the cache is immutable, so it can be shared
+	m_peaks = std::atomic_load(&orig.m_peaks);
 
 	//Deep copy m_origData and m_data from original
 	const auto origFrameBytes = m_origFrames * BYTES_PER_FRAME;
@@ -195,6 +302,10 @@ void swap(SampleBuffer& first, SampleBuffer& second) noexcept
 	swap(first.m_frequency, second.m_frequency);
 	swap(first.m_reversed, second.m_reversed);
 	swap(first.m_sampleRate, second.m_sampleRate);
+	swap(first.m_dataRevision, second.m_dataRevision);
+	const auto firstPeaks = std::atomic_load(&first.m_peaks);
+	std::atomic_store(&first.m_peaks, std::atomic_load(&second.m_peaks));
+	std::atomic_store(&second.m_peaks, firstPeaks);
 
 	// Unlock again
 	first.m_varLock.unlock();
@@ -215,6 +326,7 @@ SampleBuffer& SampleBuffer::operator=(SampleBuffer that)
 
 SampleBuffer::~SampleBuffer()
 {
+	invalidateCaches();
 	MM_FREE(m_origData);
 	MM_FREE(m_data);
 }
@@ -232,8 +344,87 @@ sample_rate_t SampleBuffer::audioEngineSampleRate()
 }
 
 
+
+
+namespace
+{
+
+class PeaksJob : public QRunnable
+{
+public:
+	PeaksJob(std::function<void()> func) : m_func(std::move(func))
+	{
+		setAutoDelete(false);
+	}
+
+	//! Wait until run() returned, the job must have been started
+	void wait() { m_done.acquire(); }
+
+private:
+	void run() override
+	{
+		m_func();
+		m_done.release();
+	}
+
+	std::function<void()> m_func;
+	QSemaphore m_done;
+};
+
+}
+
+
+
+
+void SampleBuffer::invalidateCaches()
+{
+	if (m_peaksJob)
+	{
+		m_cancelPeaks = true;
+		// a job which didn't start yet can just be dropped, a running one
+		// returns soon after being cancelled
+#if QT_VERSION >= QT_VERSION_CHECK(5, 9, 0)
+		if (!QThreadPool::globalInstance()->tryTake(m_peaksJob.get()))
+#endif
+		{
+			static_cast<PeaksJob*>(m_peaksJob.get())->wait();
+		}
+		m_peaksJob.reset();
+	}
+	std::atomic_store(&m_peaks, std::shared_ptr<const WaveformPeaks>());
+
+	m_dataRevision = newDataRevision();
+	base64Cache().remove(this);
+}
+
+
+
+
+void SampleBuffer::buildPeaks()
+{
+	invalidateCaches();
+
+	// scanning the frames is cheap enough for short samples
+	if (m_frames < 2 * WaveformPeaks::BucketSizes[0]) { return; }
+
+	m_cancelPeaks = false;
+	m_peaksJob.reset(new PeaksJob([this]
+	{
+		if (m_cancelPeaks) { return; }
+		QReadLocker lock(&m_varLock);
+		auto peaks = WaveformPeaks::build(m_data, m_frames, m_cancelPeaks);
+		if (peaks) { std::atomic_store(&m_peaks, peaks); }
+	}));
+	// shared with other background work, so there is no thread to create
+	// for every update
+	QThreadPool::globalInstance()->start(m_peaksJob.get(), -1);
+}
+
+
 void SampleBuffer::update(bool keepSettings)
 {
+	invalidateCaches();
+
 	const bool lock = (m_data != nullptr);
 	if (lock)
 	{
@@ -353,6 +544,8 @@ void SampleBuffer::update(bool keepSettings)
 		Engine::audioEngine()->doneChangeInModel();
 	}
 
+	buildPeaks();
+
 	emit sampleUpdated();
 
 	// allocate space for anti-aliased wave table
@@ -756,118 +949,177 @@ bool SampleBuffer::play(
 		playFrame = getPingPongIndex(playFrame, loopStartFrame, loopEndFrame);
 	}
 
-	f_cnt_t fragmentSize = (f_cnt_t)(frames * freqFactor) + MARGIN[state->interpolationMode()];
-
-	sampleFrame * tmp = nullptr;
+	const sampleFrame * fragment;
+	f_cnt_t framesUsed;
 
 	// check whether we have to change pitch...
 	if (freqFactor != 1.0 || state->m_varyingPitch)
 	{
-		SRC_DATA srcData;
-		// Generate output
-		srcData.data_in =
-			getSampleFragment(playFrame, fragmentSize, loopMode, &tmp, &isBackwards,
-			loopStartFrame, loopEndFrame, endFrame )->data();
-		srcData.data_out = ab->data();
-		srcData.input_frames = fragmentSize;
-		srcData.output_frames = frames;
-		srcData.src_ratio = 1.0 / freqFactor;
-		srcData.end_of_input = 0;
-		int error = src_process(state->m_resamplingData, &srcData);
-		if (error)
-		{
-			printf("SampleBuffer: error while resampling: %s\n",
-							src_strerror(error));
-		}
-		if (srcData.output_frames_gen > frames)
+		const f_cnt_t fragmentSize =
+			(f_cnt_t)(frames * freqFactor) + MARGIN[state->interpolationMode()];
+		fragment = getSampleFragment(playFrame, fragmentSize, loopMode, state,
+			&isBackwards, loopStartFrame, loopEndFrame, endFrame);
+
+		// both read the fragment where it is and write the amplified
+		// output directly into the buffer
+		framesUsed = state->m_resamplingData == nullptr
+			? interpolateFragment(fragment, ab, frames, freqFactor, state)
+			: resampleFragment(fragment, fragmentSize, ab, frames, freqFactor, state);
+	}
+	else
+	{
+		// we don't have to pitch, so we just copy the sample-data
+		// as is into the output buffer while amplifying it
+		fragment = getSampleFragment(playFrame, frames, loopMode, state,
+			&isBackwards, loopStartFrame, loopEndFrame, endFrame);
+		for (fpp_t i = 0; i < frames; ++i)
 		{
-			printf("SampleBuffer: not enough frames: %ld / %d\n",
-					srcData.output_frames_gen, frames);
+			ab[i][0] = fragment[i][0] * m_amplification;
+			ab[i][1] = fragment[i][1] * m_amplification;
 		}
-		// Advance
-		switch (loopMode)
+		framesUsed = frames;
+	}
+
+	// Advance
+	switch (loopMode)
+	{
+		case LoopOff:
+			playFrame += framesUsed;
+			break;
+		case LoopOn:
+			playFrame += framesUsed;
+			playFrame = getLoopedIndex(playFrame, loopStartFrame, loopEndFrame);
+			break;
+		case LoopPingPong:
 		{
-			case LoopOff:
-				playFrame += srcData.input_frames_used;
-				break;
-			case LoopOn:
-				playFrame += srcData.input_frames_used;
-				playFrame = getLoopedIndex(playFrame, loopStartFrame, loopEndFrame);
-				break;
-			case LoopPingPong:
+			f_cnt_t left = framesUsed;
+			if (state->isBackwards())
 			{
-				f_cnt_t left = srcData.input_frames_used;
-				if (state->isBackwards())
+				playFrame -= framesUsed;
+				if (playFrame < loopStartFrame)
 				{
-					playFrame -= srcData.input_frames_used;
-					if (playFrame < loopStartFrame)
-					{
-						left -= (loopStartFrame - playFrame);
-						playFrame = loopStartFrame;
-					}
-					else left = 0;
+					left -= (loopStartFrame - playFrame);
+					playFrame = loopStartFrame;
 				}
-				playFrame += left;
-				playFrame = getPingPongIndex(playFrame, loopStartFrame, loopEndFrame);
-				break;
+				else left = 0;
 			}
+			playFrame += left;
+			playFrame = getPingPongIndex(playFrame, loopStartFrame, loopEndFrame);
+			break;
+		}
+	}
+
+	state->setBackwards(isBackwards);
+	state->setFrameIndex(playFrame);
+
+	return true;
+}
+
+
+
+
+/* @brief Resamples a fragment with zero order hold or linear interpolation
+ * @param src: Fragment to read from, holding enough frames for the given step
+ * @param dst: Output buffer, amplification is applied while writing to it
+ * @param frames: Amount of frames to generate
+ * @param step: Amount of source frames to advance per output frame
+ * @param state: Playback state holding the fractional read position
+ * @return Amount of source frames consumed
+ */
+f_cnt_t SampleBuffer::interpolateFragment(
+	const sampleFrame * src,
+	sampleFrame * dst,
+	const fpp_t frames,
+	const double step,
+	handleState * state
+) const
+{
+	const float amp = m_amplification;
+	double pos = state->m_frameFraction;
+
+	if (state->interpolationMode() == SRC_ZERO_ORDER_HOLD)
+	{
+		for (fpp_t i = 0; i < frames; ++i)
+		{
+			const f_cnt_t idx = static_cast<f_cnt_t>(pos);
+			dst[i][0] = src[idx][0] * amp;
+			dst[i][1] = src[idx][1] * amp;
+			pos += step;
 		}
 	}
 	else
 	{
-		// we don't have to pitch, so we just copy the sample-data
-		// as is into pitched-copy-buffer
-
-		// Generate output
-		memcpy(ab,
-			getSampleFragment(playFrame, frames, loopMode, &tmp, &isBackwards,
-				loopStartFrame, loopEndFrame, endFrame),
-			frames * BYTES_PER_FRAME);
-		// Advance
-		switch (loopMode)
+		for (fpp_t i = 0; i < frames; ++i)
 		{
-			case LoopOff:
-				playFrame += frames;
-				break;
-			case LoopOn:
-				playFrame += frames;
-				playFrame = getLoopedIndex(playFrame, loopStartFrame, loopEndFrame);
-				break;
-			case LoopPingPong:
-			{
-				f_cnt_t left = frames;
-				if (state->isBackwards())
-				{
-					playFrame -= frames;
-					if (playFrame < loopStartFrame)
-					{
-						left -= (loopStartFrame - playFrame);
-						playFrame = loopStartFrame;
-					}
-					else left = 0;
-				}
-				playFrame += left;
-				playFrame = getPingPongIndex(playFrame, loopStartFrame, loopEndFrame);
-				break;
-			}
+			const f_cnt_t idx = static_cast<f_cnt_t>(pos);
+			const float frac = static_cast<float>(pos - idx);
+			dst[i][0] = linearInterpolate(src[idx][0], src[idx + 1][0], frac) * amp;
+			dst[i][1] = linearInterpolate(src[idx][1], src[idx + 1][1], frac) * amp;
+			pos += step;
 		}
 	}
 
-	if (tmp != nullptr)
+	const f_cnt_t used = static_cast<f_cnt_t>(pos);
+	state->m_frameFraction = pos - used;
+	return used;
+}
+
+
+
+
+/* @brief Resamples a fragment with one of the sinc modes of libsamplerate
+ * @param src: Fragment to read from, holding srcFrames frames
+ * @param srcFrames: Amount of frames in the fragment
+ * @param dst: Output buffer, amplified after resampling
+ * @param frames: Amount of frames to generate
+ * @param step: Amount of source frames to advance per output frame
+ * @param state: Playback state holding the libsamplerate state
+ * @return Amount of source frames consumed
+ *
+ * libsamplerate writes the output itself and has no gain, so the
+ * amplification can't be fused into it like in interpolateFragment().
+ * It is a second pass over the output of one period, not over the
+ * fragment, and skipped at unity gain.
+ */
+f_cnt_t SampleBuffer::resampleFragment(
+	const sampleFrame * src,
+	const f_cnt_t srcFrames,
+	sampleFrame * dst,
+	const fpp_t frames,
+	const double step,
+	handleState * state
+) const
+{
+	SRC_DATA srcData;
+	srcData.data_in = src->data();
+	srcData.data_out = dst->data();
+	srcData.input_frames = srcFrames;
+	srcData.output_frames = frames;
+	srcData.src_ratio = 1.0 / step;
+	srcData.end_of_input = 0;
+	int error = src_process(state->m_resamplingData, &srcData);
+	if (error)
 	{
-		MM_FREE(tmp);
+		printf("SampleBuffer: error while resampling: %s\n",
+						src_strerror(error));
+	}
+	if (srcData.output_frames_gen > frames)
+	{
+		printf("SampleBuffer: not enough frames: %ld / %d\n",
+				srcData.output_frames_gen, frames);
 	}
 
-	state->setBackwards(isBackwards);
-	state->setFrameIndex(playFrame);
-
-	for (fpp_t i = 0; i < frames; ++i)
+	if (m_amplification != 1.0f)
 	{
-		ab[i][0] *= m_amplification;
-		ab[i][1] *= m_amplification;
+		const float amp = m_amplification;
+		for (fpp_t i = 0; i < frames; ++i)
+		{
+			dst[i][0] *= amp;
+			dst[i][1] *= amp;
+		}
 	}
 
-	return true;
+	return srcData.input_frames_used;
 }
 
 
@@ -877,7 +1129,7 @@ sampleFrame * SampleBuffer::getSampleFragment(
 	f_cnt_t index,
 	f_cnt_t frames,
 	LoopMode loopMode,
-	sampleFrame * * tmp,
+	handleState * state,
 	bool * backwards,
 	f_cnt_t loopStart,
 	f_cnt_t loopEnd,
@@ -906,23 +1158,23 @@ sampleFrame * SampleBuffer::getSampleFragment(
 		}
 	}
 
-	*tmp = MM_ALLOC<sampleFrame>( frames);
+	sampleFrame * tmp = state->fragmentBuffer(frames);
 
 	if (loopMode == LoopOff)
 	{
 		f_cnt_t available = end - index;
-		memcpy(*tmp, m_data + index, available * BYTES_PER_FRAME);
-		memset(*tmp + available, 0, (frames - available) * BYTES_PER_FRAME);
+		memcpy(tmp, m_data + index, available * BYTES_PER_FRAME);
+		memset(tmp + available, 0, (frames - available) * BYTES_PER_FRAME);
 	}
 	else if (loopMode == LoopOn)
 	{
 		f_cnt_t copied = qMin(frames, loopEnd - index);
-		memcpy(*tmp, m_data + index, copied * BYTES_PER_FRAME);
+		memcpy(tmp, m_data + index, copied * BYTES_PER_FRAME);
 		f_cnt_t loopFrames = loopEnd - loopStart;
 		while (copied < frames)
 		{
 			f_cnt_t todo = qMin(frames - copied, loopFrames);
-			memcpy(*tmp + copied, m_data + loopStart, todo * BYTES_PER_FRAME);
+			memcpy(tmp + copied, m_data + loopStart, todo * BYTES_PER_FRAME);
 			copied += todo;
 		}
 	}
@@ -940,8 +1192,8 @@ sampleFrame * SampleBuffer::getSampleFragment(
 			copied = qMin(frames, pos - loopStart);
 			for (int i = 0; i < copied; i++)
 			{
-				(*tmp)[i][0] = m_data[pos - i][0];
-				(*tmp)[i][1] = m_data[pos - i][1];
+				tmp[i][0] = m_data[pos - i][0];
+				tmp[i][1] = m_data[pos - i][1];
 			}
 			pos -= copied;
 			if (pos == loopStart) { currentBackwards = false; }
@@ -949,7 +1201,7 @@ sampleFrame * SampleBuffer::getSampleFragment(
 		else
 		{
 			copied = qMin(frames, loopEnd - pos);
-			memcpy(*tmp, m_data + pos, copied * BYTES_PER_FRAME);
+			memcpy(tmp, m_data + pos, copied * BYTES_PER_FRAME);
 			pos += copied;
 			if (pos == loopEnd) { currentBackwards = true; }
 		}
@@ -961,8 +1213,8 @@ sampleFrame * SampleBuffer::getSampleFragment(
 				f_cnt_t todo = qMin(frames - copied, pos - loopStart);
 				for (int i = 0; i < todo; i++)
 				{
-					(*tmp)[copied + i][0] = m_data[pos - i][0];
-					(*tmp)[copied + i][1] = m_data[pos - i][1];
+					tmp[copied + i][0] = m_data[pos - i][0];
+					tmp[copied + i][1] = m_data[pos - i][1];
 				}
 				pos -= todo;
 				copied += todo;
@@ -971,7 +1223,7 @@ sampleFrame * SampleBuffer::getSampleFragment(
 			else
 			{
 				f_cnt_t todo = qMin(frames - copied, loopEnd - pos);
-				memcpy(*tmp + copied, m_data + pos, todo * BYTES_PER_FRAME);
+				memcpy(tmp + copied, m_data + pos, todo * BYTES_PER_FRAME);
 				pos += todo;
 				copied += todo;
 				if (pos >= loopEnd) { currentBackwards = true; }
@@ -980,7 +1232,7 @@ sampleFrame * SampleBuffer::getSampleFragment(
 		*backwards = currentBackwards;
 	}
 
-	return *tmp;
+	return tmp;
 }
 
 
@@ -988,19 +1240,23 @@ void SampleBuffer::trim(f_cnt_t start, f_cnt_t end)
 {
 	if (start>=end || start>m_frames || end>m_frames)
 		return;
+	invalidateCaches();
 	m_frames = end-start;
 	memcpy(m_data, m_data+(start), m_frames*BYTES_PER_FRAME);
 	m_startFrame = start;
 	m_endFrame = end;
+	buildPeaks();
 }
 
 void SampleBuffer::removeSection(f_cnt_t start, f_cnt_t end)
 {
 	if (start>=end || start>m_frames || end>m_frames || start<=0)
 		return;
+	invalidateCaches();
 	memmove(m_data+start, m_data+end, BYTES_PER_FRAME*(end-start));
 	m_frames=m_frames-end+start;
 	m_endFrame=m_frames;
+	buildPeaks();
 	emit sampleUpdated();
 	
 	
@@ -1103,6 +1359,10 @@ void SampleBuffer::visualize(
 		? w
 		: nbFrames;
 	if (totalPoints<=0) return;
+	// use the coarsest level of the peak cache that still has several
+	// buckets per pixel, if it has been built already
+	const auto peaks = std::atomic_load(&m_peaks);
+	const int peakLevel = peaks ? peaks->levelFor(fpp) : -1;
 	std::vector<QPointF> fEdgeMax(totalPoints);
 	std::vector<QPointF> fEdgeMin(totalPoints);
 	std::vector<QPointF> fRmsMax(totalPoints);
@@ -1126,22 +1386,33 @@ void SampleBuffer::visualize(
 		float minData = 1;
 
 		float rmsData[2] = {0, 0};
+		double rmsFrames = fpp;
 
-		// Find maximum and minimum samples within range
-		for (int i = 0; i < fpp && frame + i <= last; ++i)
+		if (peakLevel >= 0)
 		{
-			for (int j = 0; j < 2; ++j)
+			const f_cnt_t from = static_cast<f_cnt_t>(frame);
+			const f_cnt_t to = std::min<f_cnt_t>(frame + fpp, last + 1);
+			rmsFrames = std::max<f_cnt_t>(1,
+				peaks->scan(peakLevel, from, to, minData, maxData, rmsData[0]));
+		}
+		else
+		{
+			// Find maximum and minimum samples within range
+			for (int i = 0; i < fpp && frame + i <= last; ++i)
 			{
-				auto curData = m_data[static_cast<int>(frame) + i][j];
+				for (int j = 0; j < 2; ++j)
+				{
+					auto curData = m_data[static_cast<int>(frame) + i][j];
 
-				if (curData > maxData) { maxData = curData; }
-				if (curData < minData) { minData = curData; }
+					if (curData > maxData) { maxData = curData; }
+					if (curData < minData) { minData = curData; }
 
-				rmsData[j] += curData * curData;
+					rmsData[j] += curData * curData;
+				}
 			}
 		}
 
-		const float trueRmsData = (rmsData[0] + rmsData[1]) / 2 / fpp;
+		const float trueRmsData = (rmsData[0] + rmsData[1]) / 2 / rmsFrames;
 		const float sqrtRmsData = sqrt(trueRmsData);
 		const float maxRmsData = qBound(minData, sqrtRmsData, maxData);
 		const float minRmsData = qBound(minData, -sqrtRmsData, maxData);
@@ -1319,6 +1590,10 @@ void flacStreamEncoderMetadataCallback(
 
 QString & SampleBuffer::toBase64(QString & dst) const
 {
+	// QString is shared implicitly, so a cached result doesn't take more
+	// memory while it is in the saved document
+	if (base64Cache().find(this, m_dataRevision, dst)) { return dst; }
+
 #ifdef LMMS_HAVE_FLAC_STREAM_ENCODER_H
 	const f_cnt_t FRAMES_PER_BUF = 1152;
 
@@ -1376,6 +1651,7 @@ QString & SampleBuffer::toBase64(QString & dst) const
 
 #endif	/* LMMS_HAVE_FLAC_STREAM_ENCODER_H */
 
+	base64Cache().insert(this, m_dataRevision, dst);
 	return dst;
 }
 
@@ -1610,12 +1886,15 @@ void SampleBuffer::setAmplification(float a)
 
 void SampleBuffer::setReversed(bool on)
 {
+	const bool changed = m_reversed != on;
+	if (changed) { invalidateCaches(); }
 	Engine::audioEngine()->requestChangeInModel();
 	m_varLock.lockForWrite();
 	if (m_reversed != on) { std::reverse(m_data, m_data + m_frames); }
 	m_reversed = on;
 	m_varLock.unlock();
 	Engine::audioEngine()->doneChangeInModel();
+	if (changed) { buildPeaks(); }
 	emit sampleUpdated();
 }
 
@@ -1626,21 +1905,75 @@ void SampleBuffer::setReversed(bool on)
 SampleBuffer::handleState::handleState(bool varyingPitch, int interpolationMode) :
 	m_frameIndex(0),
 	m_varyingPitch(varyingPitch),
-	m_isBackwards(false)
+	m_isBackwards(false),
+	m_resamplingData(nullptr),
+	m_interpolationMode(interpolationMode),
+	m_frameFraction(0.0),
+	m_fragment(nullptr),
+	m_fragmentCapacity(0)
 {
-	int error;
+	reset(varyingPitch, interpolationMode);
+
+	// preallocate enough frames for playing a period up to one octave
+	// higher, so the audio thread doesn't have to allocate at loop points
+	fragmentBuffer(2 * Engine::audioEngine()->framesPerPeriod() + MARGIN[0]);
+}
+
+
+
+
+SampleBuffer::handleState::~handleState()
+{
+	if (m_resamplingData != nullptr)
+	{
+		src_delete(m_resamplingData);
+	}
+	MM_FREE(m_fragment);
+}
+
+
+
+
+void SampleBuffer::handleState::reset(bool varyingPitch, int interpolationMode)
+{
+	m_frameIndex = 0;
+	m_varyingPitch = varyingPitch;
+	m_isBackwards = false;
+	m_frameFraction = 0.0;
+
+	if (m_resamplingData != nullptr && interpolationMode != m_interpolationMode)
+	{
+		src_delete(m_resamplingData);
+		m_resamplingData = nullptr;
+	}
 	m_interpolationMode = interpolationMode;
 
-	if ((m_resamplingData = src_new(interpolationMode, DEFAULT_CHANNELS, &error)) == nullptr)
+	// zero order hold and linear interpolation are cheap enough to be done
+	// in place, so only the sinc modes need a libsamplerate state
+	if (m_resamplingData != nullptr)
 	{
-		qDebug("Error: src_new() failed in sample_buffer.cpp!\n");
+		src_reset(m_resamplingData);
+	}
+	else if (interpolationMode != SRC_ZERO_ORDER_HOLD && interpolationMode != SRC_LINEAR)
+	{
+		int error;
+		if ((m_resamplingData = src_new(interpolationMode, DEFAULT_CHANNELS, &error)) == nullptr)
+		{
+			qDebug("Error: src_new() failed in sample_buffer.cpp!\n");
+		}
 	}
 }
 
 
 
 
-SampleBuffer::handleState::~handleState()
+sampleFrame * SampleBuffer::handleState::fragmentBuffer(f_cnt_t frames)
 {
-	src_delete(m_resamplingData);
+	if (frames > m_fragmentCapacity)
+	{
+		MM_FREE(m_fragment);
+		m_fragment = MM_ALLOC<sampleFrame>(frames);
+		m_fragmentCapacity = frames;
+	}
+	return m_fragment;
 }
@@ -78,6 +78,7 @@ Song::Song() :
 	m_fileName(),
 	m_oldFileName(),
 	m_modified( false ),
+	m_modificationCount( 0 ),
 	m_loadOnLaunch( true ),
 	m_recording( false ),
 	m_exporting( false ),
@@ -448,6 +449,7 @@ void Song::processAutomations(const TrackList &tracklist, TimePos timeStart, fpp
 
 void Song::setModified(bool value)
 {
+	++m_modificationCount;
 	if( !m_loadingProject && m_modified != value)
 	{
 		m_modified = value;
@@ -1262,6 +1264,18 @@ void Song::loadProject( const QString & fileName )
 bool Song::saveProjectFile(const QString & filename, bool withResources)
 {
 	DataFile dataFile( DataFile::SongProject );
+	m_savingFileName = filename;
+	saveProjectState( dataFile );
+	m_savingFileName.clear();
+
+	return dataFile.writeFile(filename, withResources);
+}
+
+
+
+
+void Song::saveProjectState(DataFile & dataFile)
+{
 	m_savingProject = true;
 
 	m_tempoModel.saveSettings( dataFile, dataFile.head(), "bpm" );
@@ -1288,8 +1302,6 @@ bool Song::saveProjectFile(const QString & filename, bool withResources)
 	saveKeymapStates(dataFile, dataFile.content());
 
 	m_savingProject = false;
-
-	return dataFile.writeFile(filename, withResources);
 }
 
 
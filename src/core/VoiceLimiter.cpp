@@ -0,0 +1,268 @@
+/*
+ * VoiceLimiter.cpp - enforces polyphony limits by stealing voices
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "VoiceLimiter.h"
+
+#include <algorithm>
+
+#include "ConfigManager.h"
+#include "Engine.h"
+#include "InstrumentTrack.h"
+#include "NotePlayHandle.h"
+#include "Song.h"
+
+
+VoiceLimiter::VoiceLimiter() :
+	m_maxVoices( 0 ),
+	m_policy( StealQuietest ),
+	m_adaptive( false )
+{
+	m_voices.reserve( PlayHandle::MaxNumber );
+	loadSettings();
+}
+
+
+
+
+void VoiceLimiter::loadSettings()
+{
+	m_maxVoices = qBound( 0, ConfigManager::inst()->value(
+				"audioengine", "maxvoices", "0" ).toInt(), MaxGlobalVoices );
+	m_policy = static_cast<StealPolicy>( qBound<int>( StealOldest,
+			ConfigManager::inst()->value( "audioengine", "voicestealing",
+				QString::number( StealQuietest ) ).toInt(), StealSameKey ) );
+	m_adaptive = ConfigManager::inst()->value(
+				"audioengine", "adaptivevoices", "0" ).toInt();
+}
+
+
+
+
+void VoiceLimiter::process( const PlayHandleList & playHandles, float load,
+							qint64 periodLength )
+{
+	m_voices.clear();
+	for( PlayHandle * handle : playHandles )
+	{
+		if( handle->type() != PlayHandle::TypeNotePlayHandle )
+		{
+			continue;
+		}
+		// master notes of chords and arpeggios don't render anything
+		NotePlayHandle * note = static_cast<NotePlayHandle *>( handle );
+		if( note->isMasterNote() || note->isStolen() || note->isMuted() ||
+			note->isFinished() )
+		{
+			continue;
+		}
+		m_voices.push_back( { note, note->instrumentTrack(), false } );
+	}
+
+	limitTracks();
+
+	if( m_maxVoices > 0 && static_cast<int>( m_voices.size() ) > m_maxVoices )
+	{
+		steal( m_voices.begin(), m_voices.end(),
+				static_cast<int>( m_voices.size() ) - m_maxVoices, m_policy );
+		removeStolen();
+	}
+
+	if( m_adaptive && load > AdaptiveLoadLimit &&
+		!Engine::getSong()->isExporting() )
+	{
+		adapt( load, periodLength );
+	}
+}
+
+
+
+
+bool VoiceLimiter::stealFirst( const Voice & a, const Voice & b, StealPolicy policy )
+{
+	if( a.note->isReleased() != b.note->isReleased() )
+	{
+		return a.note->isReleased();
+	}
+	switch( policy )
+	{
+		case StealQuietest:
+			return audibility( a ) < audibility( b );
+		case StealSameKey:
+			if( a.replaced != b.replaced )
+			{
+				return a.replaced;
+			}
+			// otherwise the oldest
+			[[fallthrough]];
+		case StealOldest:
+		default:
+			return a.note->totalFramesPlayed() > b.note->totalFramesPlayed();
+	}
+}
+
+
+
+
+float VoiceLimiter::audibility( const Voice & voice )
+{
+	return voice.note->level() * voice.track->volumeModel()->value() / DefaultVolume;
+}
+
+
+
+
+void VoiceLimiter::steal( VoiceIterator begin, VoiceIterator end, int count,
+							StealPolicy policy )
+{
+	const auto compare = [policy]( const Voice & a, const Voice & b )
+	{
+		return stealFirst( a, b, policy );
+	};
+	if( count < end - begin )
+	{
+		std::nth_element( begin, begin + count, end, compare );
+	}
+	for( VoiceIterator it = begin; it != begin + count; ++it )
+	{
+		it->note->steal();
+	}
+}
+
+
+
+
+void VoiceLimiter::limitTracks()
+{
+	// group the voices by track, and within a track by key, newest first
+	std::sort( m_voices.begin(), m_voices.end(), []( const Voice & a, const Voice & b )
+	{
+		if( a.track != b.track )
+		{
+			return a.track < b.track;
+		}
+		if( a.note->key() != b.note->key() )
+		{
+			return a.note->key() < b.note->key();
+		}
+		return a.note->totalFramesPlayed() < b.note->totalFramesPlayed();
+	} );
+
+	bool stolen = false;
+	for( VoiceIterator begin = m_voices.begin(); begin != m_voices.end(); )
+	{
+		InstrumentTrack * track = begin->track;
+		const StealPolicy policy = static_cast<StealPolicy>( track->voiceStealing() );
+		VoiceIterator end = begin + 1;
+		for( ; end != m_voices.end() && end->track == track; ++end )
+		{
+			end->replaced = end->note->key() == ( end - 1 )->note->key();
+			// a released voice makes room for the new note of its key
+			if( policy == StealSameKey && end->replaced && end->note->isReleased() )
+			{
+				end->note->steal();
+				stolen = true;
+			}
+		}
+
+		int voices = 0;
+		for( VoiceIterator it = begin; it != end; ++it )
+		{
+			voices += it->note->isStolen() ? 0 : 1;
+		}
+		const int maxVoices = track->maxVoices();
+		if( maxVoices > 0 && voices > maxVoices )
+		{
+			// leave out the voices stolen for their key already
+			VoiceIterator playing = std::partition( begin, end,
+				[]( const Voice & v ) { return v.note->isStolen(); } );
+			steal( playing, end, voices - maxVoices, policy );
+			stolen = true;
+		}
+		begin = end;
+	}
+
+	if( stolen )
+	{
+		removeStolen();
+	}
+}
+
+
+
+
+void VoiceLimiter::adapt( float load, qint64 periodLength )
+{
+	// the voices which cost the most per audible level go first
+	const auto worth = []( const Voice & v )
+	{
+		return audibility( v ) / qMax<qint64>( 1, v.note->renderTime() );
+	};
+	const auto lessWorth = [&worth]( const Voice & a, const Voice & b )
+	{
+		if( a.note->isReleased() != b.note->isReleased() )
+		{
+			return a.note->isReleased();
+		}
+		return worth( a ) < worth( b );
+	};
+	qint64 voiceTime = 0;
+	for( const Voice & voice : m_voices )
+	{
+		voiceTime += voice.note->renderTime();
+	}
+	// if effects, mixer or sample tracks alone keep the period above the
+	// target, stealing would only silence every note without helping
+	const qint64 otherTime = static_cast<qint64>( load / 100.0f * periodLength ) - voiceTime;
+	if( voiceTime <= 0 || otherTime >= AdaptiveLoadTarget / 100.0f * periodLength )
+	{
+		return;
+	}
+
+	std::sort( m_voices.begin(), m_voices.end(), lessWorth );
+
+	qint64 excess = qMin( voiceTime, static_cast<qint64>(
+			( load - AdaptiveLoadTarget ) / 100.0f * periodLength ) );
+	for( Voice & voice : m_voices )
+	{
+		if( excess <= 0 )
+		{
+			break;
+		}
+		// voices which didn't play yet wouldn't free anything
+		if( voice.note->renderTime() > 0 )
+		{
+			voice.note->steal();
+			excess -= voice.note->renderTime();
+		}
+	}
+	removeStolen();
+}
+
+
+
+
+void VoiceLimiter::removeStolen()
+{
+	m_voices.erase( std::remove_if( m_voices.begin(), m_voices.end(),
+				[]( const Voice & v ) { return v.note->isStolen(); } ),
+			m_voices.end() );
+}
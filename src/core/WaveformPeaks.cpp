@@ -0,0 +1,122 @@
+/*
+ * WaveformPeaks.cpp - multi-resolution peak cache for drawing waveforms
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "WaveformPeaks.h"
+
+#include <algorithm>
+
+
+std::shared_ptr<const WaveformPeaks> WaveformPeaks::build(
+		const sampleFrame * data, f_cnt_t frames,
+		const std::atomic<bool> & cancel )
+{
+	std::shared_ptr<WaveformPeaks> peaks( new WaveformPeaks( frames ) );
+
+	// the finest level is computed from the frames ...
+	const f_cnt_t size = BucketSizes[0];
+	std::vector<Peak> & first = peaks->m_levels[0];
+	first.resize( ( frames + size - 1 ) / size );
+	for( std::size_t b = 0; b < first.size(); ++b )
+	{
+		if( b % 1024 == 0 && cancel )
+		{
+			return nullptr;
+		}
+		const f_cnt_t begin = b * size;
+		const f_cnt_t end = std::min( begin + size, frames );
+		Peak peak = { data[begin][0], data[begin][0], 0.0f };
+		for( f_cnt_t f = begin; f < end; ++f )
+		{
+			for( int ch = 0; ch < DEFAULT_CHANNELS; ++ch )
+			{
+				peak.min = std::min( peak.min, data[f][ch] );
+				peak.max = std::max( peak.max, data[f][ch] );
+				peak.sumSq += data[f][ch] * data[f][ch];
+			}
+		}
+		first[b] = peak;
+	}
+
+	// ... and each other level from the one below
+	for( int l = 1; l < Levels; ++l )
+	{
+		const std::vector<Peak> & below = peaks->m_levels[l - 1];
+		std::vector<Peak> & level = peaks->m_levels[l];
+		const std::size_t ratio = BucketSizes[l] / BucketSizes[l - 1];
+		level.resize( ( below.size() + ratio - 1 ) / ratio );
+		for( std::size_t b = 0; b < level.size(); ++b )
+		{
+			const std::size_t begin = b * ratio;
+			const std::size_t end = std::min( begin + ratio, below.size() );
+			Peak peak = below[begin];
+			for( std::size_t i = begin + 1; i < end; ++i )
+			{
+				peak.min = std::min( peak.min, below[i].min );
+				peak.max = std::max( peak.max, below[i].max );
+				peak.sumSq += below[i].sumSq;
+			}
+			level[b] = peak;
+		}
+	}
+
+	return peaks;
+}
+
+
+
+
+int WaveformPeaks::levelFor( double framesPerPixel ) const
+{
+	for( int l = Levels - 1; l >= 0; --l )
+	{
+		if( BucketSizes[l] <= framesPerPixel )
+		{
+			return l;
+		}
+	}
+	return -1;
+}
+
+
+
+
+f_cnt_t WaveformPeaks::scan( int level, f_cnt_t from, f_cnt_t to,
+				float & min, float & max, float & sumSq ) const
+{
+	const f_cnt_t size = BucketSizes[level];
+	const std::vector<Peak> & peaks = m_levels[level];
+	const f_cnt_t first = from / size;
+	const f_cnt_t last = std::min<f_cnt_t>( ( to - 1 ) / size,
+						peaks.size() - 1 );
+	if( first > last )
+	{
+		return 0;
+	}
+
+	for( f_cnt_t b = first; b <= last; ++b )
+	{
+		min = std::min( min, peaks[b].min );
+		max = std::max( max, peaks[b].max );
+		sumSq += peaks[b].sumSq;
+	}
+	return std::min( ( last + 1 ) * size, m_frames ) - first * size;
+}
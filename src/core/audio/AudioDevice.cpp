@@ -36,7 +36,8 @@ AudioDevice::AudioDevice( const ch_cnt_t _channels, AudioEngine*  _audioEngine )
 	m_sampleRate( _audioEngine->processingSampleRate() ),
 	m_channels( _channels ),
 	m_audioEngine( _audioEngine ),
-	m_buffer( new surroundSampleFrame[audioEngine()->framesPerPeriod()] )
+	m_buffer( new surroundSampleFrame[audioEngine()->framesPerPeriod()] ),
+	m_fifoBuffer( nullptr )
 {
 	int error;
 	if( ( m_srcState = src_new(
@@ -54,6 +55,7 @@ AudioDevice::~AudioDevice()
 {
 	src_delete( m_srcState );
 	delete[] m_buffer;
+	delete[] m_fifoBuffer;
 
 	m_devMutex.tryLock();
 	unlock();
@@ -64,10 +66,11 @@ AudioDevice::~AudioDevice()
 
 void AudioDevice::processNextBuffer()
 {
-	const fpp_t frames = getNextBuffer( m_buffer );
+	fpp_t frames;
+	const surroundSampleFrame * b = getNextBufferDirect( frames );
 	if( frames )
 	{
-		writeBuffer( m_buffer, frames, audioEngine()->masterGain() );
+		writeBuffer( b, frames, audioEngine()->masterGain() );
 	}
 	else
 	{
@@ -80,35 +83,49 @@ void AudioDevice::processNextBuffer()
 
 fpp_t AudioDevice::getNextBuffer( surroundSampleFrame * _ab )
 {
-	fpp_t frames = audioEngine()->framesPerPeriod();
-	const surroundSampleFrame * b = audioEngine()->nextBuffer();
-	if( !b )
+	fpp_t frames;
+	const surroundSampleFrame * b = getNextBufferDirect( frames );
+	if( frames )
 	{
-		return 0;
+		memcpy( _ab, b, frames * sizeof( surroundSampleFrame ) );
 	}
+	return frames;
+}
 
-	// make sure, no other thread is accessing device
-	lock();
 
-	// resample if necessary
-	if( audioEngine()->processingSampleRate() != m_sampleRate )
+
+
+const surroundSampleFrame * AudioDevice::getNextBufferDirect( fpp_t & _frames )
+{
+	// the previous buffer isn't used anymore
+	delete[] m_fifoBuffer;
+	m_fifoBuffer = nullptr;
+
+	_frames = audioEngine()->framesPerPeriod();
+	const surroundSampleFrame * b = audioEngine()->nextBuffer();
+	if( !b )
 	{
-		frames = resample( b, frames, _ab, audioEngine()->processingSampleRate(), m_sampleRate );
+		_frames = 0;
+		return nullptr;
 	}
-	else
+
+	// buffers from the FIFO are owned by whoever reads them
+	if( audioEngine()->hasFifoWriter() )
 	{
-		memcpy( _ab, b, frames * sizeof( surroundSampleFrame ) );
+		m_fifoBuffer = b;
 	}
 
-	// release lock
-	unlock();
-
-	if( audioEngine()->hasFifoWriter() )
+	// resample if necessary
+	if( audioEngine()->processingSampleRate() != m_sampleRate )
 	{
-		delete[] b;
+		// make sure, no other thread is accessing device
+		lock();
+		_frames = resample( b, _frames, m_buffer, audioEngine()->processingSampleRate(), m_sampleRate );
+		unlock();
+		return m_buffer;
 	}
 
-	return frames;
+	return b;
 }
 
 
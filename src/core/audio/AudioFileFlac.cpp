@@ -93,7 +93,11 @@ void AudioFileFlac::writeBuffer(surroundSampleFrame const* _ab, fpp_t const fram
 
 	if (depth == OutputSettings::Depth_24Bit || depth == OutputSettings::Depth_32Bit) // Float encoding
 	{
-		std::unique_ptr<sample_t[]> buf{ new sample_t[frames*channels()] };
+		if (m_floatBuffer.size() < static_cast<std::size_t>(frames * channels()))
+		{
+			m_floatBuffer.resize(frames * channels());
+		}
+		sample_t* buf = m_floatBuffer.data();
 		for(fpp_t frame = 0; frame < frames; ++frame)
 		{
 			for(ch_cnt_t channel=0; channel<channels(); ++channel)
@@ -104,13 +108,17 @@ void AudioFileFlac::writeBuffer(surroundSampleFrame const* _ab, fpp_t const fram
 				buf[frame*channels() + channel] = qMax( clipvalue, _ab[frame][channel] * master_gain );
 			}
 		}
-		sf_writef_float(m_sf,static_cast<float*>(buf.get()),frames);
+		sf_writef_float(m_sf, buf, frames);
 	}
 	else // integer PCM encoding
 	{
-		std::unique_ptr<int_sample_t[]> buf{ new int_sample_t[frames*channels()] };
-		convertToS16(_ab, frames, master_gain, buf.get(), !isLittleEndian());
-		sf_writef_short(m_sf, static_cast<short*>(buf.get()), frames);
+		if (m_intBuffer.size() < static_cast<std::size_t>(frames * channels()))
+		{
+			m_intBuffer.resize(frames * channels());
+		}
+		int_sample_t* buf = m_intBuffer.data();
+		convertToS16(_ab, frames, master_gain, buf, !isLittleEndian());
+		sf_writef_short(m_sf, buf, frames);
 	}
 
 }
@@ -102,9 +102,15 @@ void AudioFileWave::writeBuffer( const surroundSampleFrame * _ab,
 {
 	OutputSettings::BitDepth bitDepth = getOutputSettings().getBitDepth();
 
+	const std::size_t samples = _frames * channels();
+
 	if( bitDepth == OutputSettings::Depth_32Bit || bitDepth == OutputSettings::Depth_24Bit )
 	{
-		float *  buf = new float[_frames*channels()];
+		if( m_floatBuffer.size() < samples )
+		{
+			m_floatBuffer.resize( samples );
+		}
+		float * buf = m_floatBuffer.data();
 		for( fpp_t frame = 0; frame < _frames; ++frame )
 		{
 			for( ch_cnt_t chnl = 0; chnl < channels(); ++chnl )
@@ -114,16 +120,18 @@ void AudioFileWave::writeBuffer( const surroundSampleFrame * _ab,
 			}
 		}
 		sf_writef_float( m_sf, buf, _frames );
-		delete[] buf;
 	}
 	else
 	{
-		int_sample_t * buf = new int_sample_t[_frames * channels()];
+		if( m_intBuffer.size() < samples )
+		{
+			m_intBuffer.resize( samples );
+		}
+		int_sample_t * buf = m_intBuffer.data();
 		convertToS16( _ab, _frames, _master_gain, buf,
 							!isLittleEndian() );
 
 		sf_writef_short( m_sf, buf, _frames );
-		delete[] buf;
 	}
 }
 
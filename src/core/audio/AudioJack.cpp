@@ -26,18 +26,23 @@
 
 #ifdef LMMS_HAVE_JACK
 
+#include <algorithm>
 #include <QLineEdit>
 #include <QLabel>
 #include <QMessageBox>
+#include <QTimer>
 
 #include "Engine.h"
 #include "GuiApplication.h"
 #include "gui_templates.h"
+#include "BufferManager.h"
 #include "ConfigManager.h"
 #include "LcdSpinBox.h"
+#include "LedCheckbox.h"
 #include "AudioPort.h"
 #include "MainWindow.h"
 #include "AudioEngine.h"
+#include "Mixer.h"
 #include "MidiJack.h"
 
 
@@ -51,9 +56,18 @@ AudioJack::AudioJack( bool & _success_ful, AudioEngine*  _audioEngine ) :
 	m_active( false ),
 	m_midiClient( nullptr ),
 	m_tempOutBufs( new jack_default_audio_sample_t *[channels()] ),
-	m_outBuf( new surroundSampleFrame[audioEngine()->framesPerPeriod()] ),
+	m_outBuf( nullptr ),
 	m_framesDoneInCurBuf( 0 ),
-	m_framesToDoInCurBuf( 0 )
+	m_framesToDoInCurBuf( 0 ),
+	m_mixerOutputsEnabled( ConfigManager::inst()->value(
+					"audiojack", "mixeroutputs" ).toInt() ),
+	m_mixerOutputs( new MixerOutputList ),
+	m_mixerOutputsProcessing( nullptr ),
+	m_mixerOutputsRendering( nullptr ),
+	m_processCycle( 0 ),
+	m_mixerPeriodsWritten( 0 ),
+	m_mixerPeriodsRead( 0 ),
+	m_curMixerPeriod( -1 )
 {
 	m_stopped = true;
 
@@ -63,6 +77,16 @@ AudioJack::AudioJack( bool & _success_ful, AudioEngine*  _audioEngine ) :
 		connect( this, SIGNAL( zombified() ),
 				this, SLOT( restartAfterZombified() ),
 				Qt::QueuedConnection );
+
+		if( m_mixerOutputsEnabled )
+		{
+			// queued, as the channels change while the song holds
+			// the engine in requestChangeInModel()
+			connect( Engine::mixer(), SIGNAL( channelsChanged() ),
+					this, SLOT( updateMixerOutputs() ),
+					Qt::QueuedConnection );
+			updateMixerOutputs();
+		}
 	}
 
 }
@@ -91,7 +115,15 @@ AudioJack::~AudioJack()
 
 	delete[] m_tempOutBufs;
 
-	delete[] m_outBuf;
+	// the client is closed, so no thread uses any list anymore
+	m_mixerOutputsProcessing = nullptr;
+	m_mixerOutputsRendering = nullptr;
+	freeRetiredMixerOutputs();
+	for( MixerOutput * output : *m_mixerOutputs.load() )
+	{
+		delete output;
+	}
+	delete m_mixerOutputs.load();
 }
 
 
@@ -99,9 +131,13 @@ AudioJack::~AudioJack()
 
 void AudioJack::restartAfterZombified()
 {
+	// the ports went away with the old client
+	publishMixerOutputs( new MixerOutputList, *m_mixerOutputs.load(), false );
+
 	if( initJackClient() )
 	{
 		m_active = false;
+		updateMixerOutputs();
 		startProcessing();
 		QMessageBox::information( getGUI()->mainWindow(),
 			tr( "JACK client restarted" ),
@@ -178,6 +214,10 @@ bool AudioJack::initJackClient()
 		setSampleRate( jack_get_sample_rate( m_client ) );
 	}
 
+	// render one period per callback instead of splitting longer periods
+	// over several callbacks, which would render in bursts
+	audioEngine()->requestFramesPerPeriod( jack_get_buffer_size( m_client ) );
+
 	for( ch_cnt_t ch = 0; ch < channels(); ++ch )
 	{
 		QString name = QString( "master out " ) +
@@ -260,6 +300,224 @@ void AudioJack::stopProcessing()
 
 
 
+void AudioJack::updateMixerOutputs()
+{
+	if( !m_mixerOutputsEnabled || m_client == nullptr )
+	{
+		return;
+	}
+
+	Mixer * mixer = Engine::mixer();
+	const fpp_t frames = audioEngine()->framesPerPeriod();
+
+	// outputs belong to their channel and are named after it, so they
+	// keep their connections when other channels are deleted or moved
+	MixerOutputList removed = *m_mixerOutputs.load();
+	auto outputs = new MixerOutputList;
+	outputs->reserve( mixer->numChannels() );
+	for( int index = 1; index < mixer->numChannels(); ++index )
+	{
+		const MixerChannel * channel = mixer->mixerChannel( index );
+
+		QString name = "mixer " + channel->m_name;
+		for( int n = 2; std::any_of( outputs->begin(), outputs->end(),
+			[&name]( const MixerOutput * o ) { return o->name == name; } ); ++n )
+		{
+			name = QString( "mixer %1 (%2)" ).arg( channel->m_name ).arg( n );
+		}
+
+		auto it = std::find_if( removed.begin(), removed.end(),
+			[channel]( const MixerOutput * o ) { return o->channel == channel; } );
+		if( it != removed.end() )
+		{
+			MixerOutput * output = *it;
+			removed.erase( it );
+			if( output->name != name )
+			{
+				output->name = name;
+				for( ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch )
+				{
+					const QString portName = name + ( ch ? " R" : " L" );
+#ifdef LMMS_HAVE_JACK_PRENAME
+					jack_port_rename( m_client, output->ports[ch],
+							portName.toUtf8().constData() );
+#else
+					jack_port_set_name( output->ports[ch],
+							portName.toUtf8().constData() );
+#endif
+				}
+			}
+			outputs->push_back( output );
+			continue;
+		}
+
+		auto output = new MixerOutput;
+		output->channel = channel;
+		output->name = name;
+		for( ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch )
+		{
+			const QString portName = name + ( ch ? " R" : " L" );
+			output->ports[ch] = jack_port_register( m_client,
+						portName.toUtf8().constData(),
+						JACK_DEFAULT_AUDIO_TYPE,
+						JackPortIsOutput, 0 );
+			output->buffers[ch] = nullptr;
+		}
+		output->cycle = m_processCycle - 1;
+		if( output->ports[0] == nullptr || output->ports[1] == nullptr )
+		{
+			printf( "no more JACK-ports available!\n" );
+			for( jack_port_t * port : output->ports )
+			{
+				if( port != nullptr )
+				{
+					jack_port_unregister( m_client, port );
+				}
+			}
+			delete output;
+			break;
+		}
+		output->periods.resize( MixerOutputPeriods * frames );
+		outputs->push_back( output );
+	}
+
+	publishMixerOutputs( outputs, removed );
+}
+
+
+
+
+void AudioJack::publishMixerOutputs( MixerOutputList * outputs,
+				const MixerOutputList & removed, bool unregister )
+{
+	MixerOutputList * old = m_mixerOutputs.exchange( outputs );
+	m_retiredMixerOutputs.push_back( { old, removed, unregister } );
+	freeRetiredMixerOutputs();
+}
+
+
+
+
+void AudioJack::freeRetiredMixerOutputs()
+{
+	// both threads only hold on to a list for a part of one period, but
+	// the GUI thread must not wait for them, as the process callback may
+	// be waiting for the engine which may be waiting for the GUI thread
+	auto it = m_retiredMixerOutputs.begin();
+	for( ; it != m_retiredMixerOutputs.end(); ++it )
+	{
+		if( m_mixerOutputsProcessing.load() == it->list ||
+			m_mixerOutputsRendering.load() == it->list )
+		{
+			break;
+		}
+		delete it->list;
+		for( MixerOutput * output : it->removed )
+		{
+			for( jack_port_t * port : output->ports )
+			{
+				if( it->unregister && m_client != nullptr )
+				{
+					jack_port_unregister( m_client, port );
+				}
+			}
+			delete output;
+		}
+	}
+	m_retiredMixerOutputs.erase( m_retiredMixerOutputs.begin(), it );
+
+	if( !m_retiredMixerOutputs.empty() )
+	{
+		QTimer::singleShot( 10, this, SLOT( freeRetiredMixerOutputs() ) );
+	}
+}
+
+
+
+
+AudioJack::MixerOutputList * AudioJack::acquireMixerOutputs(
+				std::atomic<MixerOutputList *> & inUse )
+{
+	MixerOutputList * outputs;
+	// the list may be replaced right before it's marked as used
+	do
+	{
+		outputs = m_mixerOutputs.load();
+		inUse.store( outputs );
+	}
+	while( outputs != m_mixerOutputs.load() );
+	return outputs;
+}
+
+
+
+
+void AudioJack::processMixerChannels( Mixer * _mixer )
+{
+	if( !m_mixerOutputsEnabled )
+	{
+		return;
+	}
+
+	// count the periods even without outputs, so the ring stays in
+	// step with the master buffers once outputs are added
+	const fpp_t frames = audioEngine()->framesPerPeriod();
+	const int period = m_mixerPeriodsWritten % MixerOutputPeriods;
+
+	const MixerOutputList & outputs = *acquireMixerOutputs( m_mixerOutputsRendering );
+	for( std::size_t i = 0; i < outputs.size(); ++i )
+	{
+		sampleFrame * out = outputs[i]->periods.data() +
+							period * frames;
+		const mix_ch_t index = i + 1;
+		MixerChannel * ch = index < _mixer->numChannels()
+					? _mixer->mixerChannel( index ) : nullptr;
+		// the list is updated after the channels changed
+		if( ch == nullptr || ch != outputs[i]->channel || ch->m_muted )
+		{
+			BufferManager::clear( out, frames );
+			continue;
+		}
+
+		// after the fader, like the channel is heard in its sends
+		const ValueBuffer * volBuf = ch->m_volumeModel.valueBuffer();
+		const float v = ch->m_volumeModel.value();
+		for( fpp_t f = 0; f < frames; ++f )
+		{
+			const float gain = volBuf ? volBuf->values()[f] : v;
+			out[f][0] = ch->m_buffer[f][0] * gain;
+			out[f][1] = ch->m_buffer[f][1] * gain;
+		}
+	}
+	m_mixerOutputsRendering.store( nullptr );
+
+	++m_mixerPeriodsWritten;
+}
+
+
+
+
+void AudioJack::nextMixerPeriod()
+{
+	m_curMixerPeriod = -1;
+	if( !m_mixerOutputsEnabled ||
+		m_mixerPeriodsRead == m_mixerPeriodsWritten )
+	{
+		return;
+	}
+
+	const int period = m_mixerPeriodsRead % MixerOutputPeriods;
+	++m_mixerPeriodsRead;
+	// a resampled master buffer doesn't match the rendered periods
+	if( m_framesToDoInCurBuf == audioEngine()->framesPerPeriod() )
+	{
+		m_curMixerPeriod = period;
+	}
+}
+
+
+
+
 void AudioJack::applyQualitySettings()
 {
 	if( hqAudio() )
@@ -385,11 +643,14 @@ int AudioJack::processCallback( jack_nframes_t _nframes, void * _udata )
 	}
 #endif
 
+	// every registered output is written in every cycle
+	++m_processCycle;
+
 	jack_nframes_t done = 0;
 	while( done < _nframes && m_stopped == false )
 	{
 		jack_nframes_t todo = qMin<jack_nframes_t>(
-						_nframes,
+						_nframes - done,
 						m_framesToDoInCurBuf -
 							m_framesDoneInCurBuf );
 		const float gain = audioEngine()->masterGain();
@@ -401,12 +662,16 @@ int AudioJack::processCallback( jack_nframes_t _nframes, void * _udata )
 				o[done+frame] = m_outBuf[m_framesDoneInCurBuf+frame][c] * gain;
 			}
 		}
+		writeMixerOutputs( _nframes, done, todo, gain, false );
 		done += todo;
 		m_framesDoneInCurBuf += todo;
 		if( m_framesDoneInCurBuf == m_framesToDoInCurBuf )
 		{
-			m_framesToDoInCurBuf = getNextBuffer( m_outBuf );
+			fpp_t frames;
+			m_outBuf = getNextBufferDirect( frames );
+			m_framesToDoInCurBuf = frames;
 			m_framesDoneInCurBuf = 0;
+			nextMixerPeriod();
 			if( !m_framesToDoInCurBuf )
 			{
 				m_stopped = true;
@@ -423,6 +688,8 @@ int AudioJack::processCallback( jack_nframes_t _nframes, void * _udata )
 			memset( b, 0, sizeof( *b ) * ( _nframes - done ) );
 		}
 	}
+	// also silences outputs added after the last chunk
+	writeMixerOutputs( _nframes, done, _nframes - done, 0.0f, true );
 
 	return 0;
 }
@@ -430,6 +697,50 @@ int AudioJack::processCallback( jack_nframes_t _nframes, void * _udata )
 
 
 
+void AudioJack::writeMixerOutputs( jack_nframes_t nframes,
+		jack_nframes_t done, jack_nframes_t todo, float gain, bool silent )
+{
+	if( !m_mixerOutputsEnabled )
+	{
+		return;
+	}
+
+	// only held while copying, never while waiting for the next buffer
+	const MixerOutputList & outputs = *acquireMixerOutputs( m_mixerOutputsProcessing );
+	for( MixerOutput * output : outputs )
+	{
+		if( output->cycle != m_processCycle )
+		{
+			// added in this cycle, or the first chunk of it
+			output->cycle = m_processCycle;
+			for( ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch )
+			{
+				output->buffers[ch] = (jack_default_audio_sample_t *)
+					jack_port_get_buffer( output->ports[ch], nframes );
+				memset( output->buffers[ch], 0,
+						sizeof( *output->buffers[ch] ) * done );
+			}
+		}
+
+		const sampleFrame * in = silent || m_curMixerPeriod < 0 ? nullptr :
+			output->periods.data() +
+				m_curMixerPeriod * audioEngine()->framesPerPeriod() +
+				m_framesDoneInCurBuf;
+		for( ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch )
+		{
+			jack_default_audio_sample_t * o = output->buffers[ch] + done;
+			for( jack_nframes_t frame = 0; frame < todo; ++frame )
+			{
+				o[frame] = in ? in[frame][ch] * gain : 0.0f;
+			}
+		}
+	}
+	m_mixerOutputsProcessing.store( nullptr );
+}
+
+
+
+
 int AudioJack::staticProcessCallback( jack_nframes_t _nframes, void * _udata )
 {
 	return static_cast<AudioJack *>( _udata )->
@@ -476,6 +787,11 @@ AudioJack::setupWidget::setupWidget( QWidget * _parent ) :
 	m_channels->setLabel( tr( "Channels" ) );
 	m_channels->move( 180, 20 );
 
+	m_mixerOutputs = new LedCheckBox( tr( "Output mixer channels" ), this );
+	m_mixerOutputs->move( 10, 60 );
+	m_mixerOutputs->setChecked( ConfigManager::inst()->value( "audiojack",
+							"mixeroutputs" ).toInt() );
+
 }
 
 
@@ -495,6 +811,8 @@ void AudioJack::setupWidget::saveSettings()
 							m_clientName->text() );
 	ConfigManager::inst()->setValue( "audiojack", "channels",
 				QString::number( m_channels->value<int>() ) );
+	ConfigManager::inst()->setValue( "audiojack", "mixeroutputs",
+				QString::number( m_mixerOutputs->isChecked() ) );
 }
 
 
@@ -23,8 +23,13 @@
  */
 
 #include "AudioPort.h"
+
+#include <algorithm>
+#include <cstring>
+
 #include "AudioDevice.h"
 #include "AudioEngine.h"
+#include "AudioEngineWorkerThread.h"
 #include "EffectChain.h"
 #include "Mixer.h"
 #include "Engine.h"
@@ -34,7 +39,7 @@
 
 AudioPort::AudioPort( const QString & _name, bool _has_effect_chain,
 		FloatModel * volumeModel, FloatModel * panningModel,
-		BoolModel * mutedModel ) :
+		BoolModel * mutedModel, BoolModel * monitorModel ) :
 	m_bufferUsage( false ),
 	m_portBuffer( BufferManager::acquire() ),
 	m_extOutputEnabled( false ),
@@ -43,8 +48,21 @@ AudioPort::AudioPort( const QString & _name, bool _has_effect_chain,
 	m_effects( _has_effect_chain ? new EffectChain( nullptr ) : nullptr ),
 	m_volumeModel( volumeModel ),
 	m_panningModel( panningModel ),
-	m_mutedModel( mutedModel )
+	m_mutedModel( mutedModel ),
+	m_monitorModel( monitorModel ),
+	m_latency( 0 ),
+	m_delayBuffer( MaxCompensatedPeriods * Engine::audioEngine()->framesPerPeriod() ),
+	m_delay( 0 ),
+	m_delayPosition( 0 ),
+	m_delayedFrames( 0 )
 {
+	m_accumulators.resize( AudioEngineWorkerThread::slotCount() );
+	for( Accumulator & acc : m_accumulators )
+	{
+		acc.buffer = BufferManager::acquire();
+		acc.used = false;
+	}
+
 	Engine::audioEngine()->addAudioPort( this );
 	setExtOutputEnabled( true );
 }
@@ -57,6 +75,10 @@ AudioPort::~AudioPort()
 	setExtOutputEnabled( false );
 	Engine::audioEngine()->removeAudioPort( this );
 	BufferManager::release( m_portBuffer );
+	for( Accumulator & acc : m_accumulators )
+	{
+		BufferManager::release( acc.buffer );
+	}
 }
 
 
@@ -105,6 +127,15 @@ void AudioPort::doProcessing()
 {
 	if( m_mutedModel && m_mutedModel->value() )
 	{
+		for( Accumulator & acc : m_accumulators )
+		{
+			acc.used = false;
+		}
+		if( m_delayedFrames > 0 )
+		{
+			std::fill_n( m_delayBuffer.begin(), m_delay, sampleFrame{} );
+			m_delayedFrames = 0;
+		}
 		return;
 	}
 
@@ -113,6 +144,17 @@ void AudioPort::doProcessing()
 	// clear the buffer
 	BufferManager::clear( m_portBuffer, fpp );
 
+	// voices have been mixed per worker thread already
+	for( Accumulator & acc : m_accumulators )
+	{
+		if( acc.used )
+		{
+			m_bufferUsage = true;
+			MixHelpers::add( m_portBuffer, acc.buffer, fpp );
+			acc.used = false;
+		}
+	}
+
 	//qDebug( "Playhandles: %d", m_playHandles.size() );
 	for( PlayHandle * ph : m_playHandles ) // now we mix all playhandle buffers into the audioport buffer
 	{
@@ -130,6 +172,13 @@ void AudioPort::doProcessing()
 		}
 	}
 
+	if( m_monitorModel && m_monitorModel->value()
+		&& Engine::audioEngine()->inputBufferFrames() > 0 )
+	{
+		m_bufferUsage = true;
+		MixHelpers::add( m_portBuffer, Engine::audioEngine()->inputBuffer(), fpp );
+	}
+
 	if( m_bufferUsage )
 	{
 		// handle volume and panning
@@ -220,7 +269,7 @@ void AudioPort::doProcessing()
 
 	// handle effects
 	const bool me = processEffects();
-	if( me || m_bufferUsage )
+	if( compensateLatency( me || m_bufferUsage, fpp ) )
 	{
 		Engine::mixer()->mixToChannel( m_portBuffer, m_nextMixerChannel ); 	// send output to mixer
 																			// TODO: improve the flow here - convert to pull model
@@ -229,6 +278,75 @@ void AudioPort::doProcessing()
 }
 
 
+f_cnt_t AudioPort::latency() const
+{
+	return m_latency + ( m_effects ? m_effects->latency() : 0 );
+}
+
+
+
+
+bool AudioPort::compensateLatency( bool hasOutput, fpp_t fpp )
+{
+	// the latency may have changed since the maximum was determined
+	const f_cnt_t delay = qBound<f_cnt_t>( 0,
+					Engine::audioEngine()->maxLatency() - latency(),
+					m_delayBuffer.size() );
+	if( delay != m_delay )
+	{
+		// only happens when a latency changes
+		std::fill_n( m_delayBuffer.begin(), delay, sampleFrame{} );
+		m_delay = delay;
+		m_delayPosition = 0;
+		m_delayedFrames = 0;
+	}
+	if( delay == 0 )
+	{
+		return hasOutput;
+	}
+
+	if( !hasOutput )
+	{
+		if( m_delayedFrames == 0 )
+		{
+			return false;
+		}
+		// effects may have left something in the buffer
+		BufferManager::clear( m_portBuffer, fpp );
+	}
+
+	for( fpp_t f = 0; f < fpp; ++f )
+	{
+		std::swap( m_portBuffer[f], m_delayBuffer[m_delayPosition] );
+		if( ++m_delayPosition == delay )
+		{
+			m_delayPosition = 0;
+		}
+	}
+
+	const bool delayedOutput = hasOutput || m_delayedFrames > 0;
+	m_delayedFrames = hasOutput ? delay : qMax<f_cnt_t>( 0, m_delayedFrames - fpp );
+	return delayedOutput;
+}
+
+
+void AudioPort::accumulate( const sampleFrame * buf )
+{
+	Accumulator & acc = m_accumulators[AudioEngineWorkerThread::currentSlot()];
+	const fpp_t fpp = Engine::audioEngine()->framesPerPeriod();
+	if( acc.used )
+	{
+		MixHelpers::add( acc.buffer, buf, fpp );
+	}
+	else
+	{
+		// the first voice of this period initializes the accumulator
+		memcpy( acc.buffer, buf, fpp * sizeof( sampleFrame ) );
+		acc.used = true;
+	}
+}
+
+
 void AudioPort::addPlayHandle( PlayHandle * handle )
 {
 	m_playHandleLock.lock();
@@ -51,7 +51,8 @@ AudioPulseAudio::AudioPulseAudio( bool & _success_ful, AudioEngine*  _audioEngin
 		SURROUND_CHANNELS ), _audioEngine ),
 	m_s( nullptr ),
 	m_quit( false ),
-	m_convertEndian( false )
+	m_convertEndian( false ),
+	m_pcmBuffer( new int_sample_t[audioEngine()->framesPerPeriod() * channels()] )
 {
 	_success_ful = false;
 
@@ -68,6 +69,7 @@ AudioPulseAudio::AudioPulseAudio( bool & _success_ful, AudioEngine*  _audioEngin
 AudioPulseAudio::~AudioPulseAudio()
 {
 	stopProcessing();
+	delete[] m_pcmBuffer;
 }
 
 
@@ -263,33 +265,30 @@ void AudioPulseAudio::run()
 
 void AudioPulseAudio::streamWriteCallback( pa_stream *s, size_t length )
 {
-	const fpp_t fpp = audioEngine()->framesPerPeriod();
-	surroundSampleFrame * temp = new surroundSampleFrame[fpp];
-	int_sample_t* pcmbuf = (int_sample_t *)pa_xmalloc( fpp * channels() * sizeof(int_sample_t) );
-
+	// convert straight from the audio engine's buffer, PulseAudio
+	// copies the data on writing
+	const size_t frameSize = channels() * sizeof( int_sample_t );
 	size_t fd = 0;
-	while( fd < length/4 && m_quit == false )
+	while( fd < length / frameSize && m_quit == false )
 	{
-		const fpp_t frames = getNextBuffer( temp );
+		fpp_t frames;
+		const surroundSampleFrame * buf = getNextBufferDirect( frames );
 		if( !frames )
 		{
 			m_quit = true;
 			break;
 		}
-		int bytes = convertToS16( temp, frames,
+		int bytes = convertToS16( buf, frames,
 						audioEngine()->masterGain(),
-						pcmbuf,
+						m_pcmBuffer,
 						m_convertEndian );
 		if( bytes > 0 )
 		{
-			pa_stream_write( m_s, pcmbuf, bytes, nullptr, 0,
+			pa_stream_write( m_s, m_pcmBuffer, bytes, nullptr, 0,
 							PA_SEEK_RELATIVE );
 		}
 		fd += frames;
 	}
-
-	pa_xfree( pcmbuf );
-	delete[] temp;
 }
 
 
@@ -317,7 +317,7 @@ void AudioSdl::sdlInputAudioCallback(void *_udata, Uint8 *_buf, int _len) {
 }
 
 void AudioSdl::sdlInputAudioCallback(Uint8 *_buf, int _len) {
-	audioEngine()->addInputFrames((sampleFrame*)_buf, _len/sizeof(sampleFrame));
+	audioEngine()->pushInputFrames((sampleFrame*)_buf, _len/sizeof(sampleFrame));
 }	
 
 #endif
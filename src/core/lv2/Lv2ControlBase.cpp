@@ -27,11 +27,14 @@
 #ifdef LMMS_HAVE_LV2
 
 #include <algorithm>
+#include <QFileInfo>
 #include <QtGlobal>
+#include <QUuid>
 
 #include "Engine.h"
 #include "Lv2Manager.h"
 #include "Lv2Proc.h"
+#include "Song.h"
 
 
 
@@ -73,6 +76,9 @@ Lv2ControlBase::Lv2ControlBase(Model* that, const QString &uri) :
 		if (m_valid)
 		{
 			m_channelsPerProc = DEFAULT_CHANNELS / m_procs.size();
+			m_planar = std::all_of(m_procs.begin(), m_procs.end(),
+				[this](const std::unique_ptr<Lv2Proc>& proc)
+				{ return proc->canConnectChannels(m_channelsPerProc); });
 			linkAllModels();
 		}
 	}
@@ -125,6 +131,7 @@ void Lv2ControlBase::copyModelsToLmms() const
 void Lv2ControlBase::copyBuffersFromLmms(const sampleFrame *buf, fpp_t frames) {
 	unsigned firstChan = 0; // tell the procs which channels they shall read from
 	for (auto& c : m_procs) {
+		c->connectChannels(nullptr, firstChan, m_channelsPerProc);
 		c->copyBuffersFromCore(buf, firstChan, m_channelsPerProc, frames);
 		firstChan += m_channelsPerProc;
 	}
@@ -144,6 +151,18 @@ void Lv2ControlBase::copyBuffersToLmms(sampleFrame *buf, fpp_t frames) const {
 
 
 
+void Lv2ControlBase::connectPlanarBuffer(const PlanarBuffer &buf)
+{
+	unsigned firstChan = 0;
+	for (auto& c : m_procs) {
+		c->connectChannels(&buf, firstChan, m_channelsPerProc);
+		firstChan += m_channelsPerProc;
+	}
+}
+
+
+
+
 void Lv2ControlBase::run(fpp_t frames) {
 	for (auto& c : m_procs) { c->run(frames); }
 }
@@ -154,8 +173,30 @@ void Lv2ControlBase::run(fpp_t frames) {
 void Lv2ControlBase::saveSettings(QDomDocument &doc, QDomElement &that)
 {
 	LinkedModelGroups::saveSettings(doc, that);
-	
-	// TODO: save state if supported by plugin
+
+	// files of the state are only saved with a project file, next to it
+	const QString& project = Engine::getSong()->savingFileName();
+	if (!project.isEmpty() && m_stateDirName.isEmpty())
+	{
+		m_stateDirName = QUuid::createUuid().toRfc4122().toHex().left(8);
+	}
+
+	// save state if supported by plugin, one element per processor
+	QDomElement states = doc.createElement("states");
+	for (std::size_t i = 0; i < m_procs.size(); ++i)
+	{
+		QString state = m_procs[i]->saveState(project.isEmpty()
+			? QString() : stateDirectory(project, i));
+		if (state.isEmpty()) { break; }
+		QDomElement stateElem = doc.createElement("state");
+		stateElem.appendChild(doc.createCDATASection(state));
+		states.appendChild(stateElem);
+	}
+	if (states.hasChildNodes())
+	{
+		if (!project.isEmpty()) { states.setAttribute("dir", m_stateDirName); }
+		that.appendChild(states);
+	}
 }
 
 
@@ -164,8 +205,31 @@ void Lv2ControlBase::saveSettings(QDomDocument &doc, QDomElement &that)
 void Lv2ControlBase::loadSettings(const QDomElement &that)
 {
 	LinkedModelGroups::loadSettings(that);
-	
-	// TODO: load state if supported by plugin
+
+	// load state if saved, after the models (ports) have been set
+	const QDomElement states = that.firstChildElement("states");
+	const QString& project = Engine::getSong()->projectFileName();
+	m_stateDirName = states.attribute("dir");
+	QDomElement stateElem = states.firstChildElement("state");
+	for (std::size_t i = 0; i < m_procs.size(); ++i)
+	{
+		if (stateElem.isNull()) { break; }
+		m_procs[i]->restoreState(stateElem.text(),
+			project.isEmpty() || m_stateDirName.isEmpty()
+				? QString() : stateDirectory(project, i));
+		stateElem = stateElem.nextSiblingElement("state");
+	}
+}
+
+
+
+
+QString Lv2ControlBase::stateDirectory(const QString& project, std::size_t idx) const
+{
+	// relative to the project, so both can be moved together
+	const QFileInfo fi(project);
+	return QString("%1/%2.lv2state/%3-%4").arg(fi.absolutePath(),
+		fi.completeBaseName(), m_stateDirName).arg(idx);
 }
 
 
@@ -67,10 +67,14 @@ void Lv2Features::initCommon()
 void Lv2Features::createFeatureVectors()
 {
 	// create vector of features
+	// features left unset are only offered to plugins that can use them
+	// (e.g. the worker schedule for plugins with a worker interface)
 	for(std::pair<const char* const, void*>& pr : m_featureByUri)
 	{
-		Q_ASSERT(pr.second != nullptr);
-		m_features.push_back(LV2_Feature { pr.first, pr.second });
+		if (pr.second != nullptr)
+		{
+			m_features.push_back(LV2_Feature { pr.first, pr.second });
+		}
 	}
 
 	// create pointer vector (for lilv_plugin_instantiate)
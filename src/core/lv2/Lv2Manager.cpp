@@ -32,14 +32,19 @@
 #include <lilv/lilv.h>
 #include <lv2.h>
 #include <lv2/lv2plug.in/ns/ext/options/options.h>
+#include <lv2/lv2plug.in/ns/ext/state/state.h>
+#include <lv2/lv2plug.in/ns/ext/worker/worker.h>
 #include <QDebug>
 #include <QDir>
 #include <QLibrary>
 #include <QElapsedTimer>
+#include <QFileInfo>
+#include <QJsonObject>
 
 #include "ConfigManager.h"
 #include "Engine.h"
 #include "Plugin.h"
+#include "PluginCache.h"
 #include "PluginFactory.h"
 #include "Lv2ControlBase.h"
 #include "Lv2Options.h"
@@ -78,6 +83,9 @@ Lv2Manager::Lv2Manager() :
 	m_supportedFeatureURIs.insert(LV2_URID__map);
 	m_supportedFeatureURIs.insert(LV2_URID__unmap);
 	m_supportedFeatureURIs.insert(LV2_OPTIONS__options);
+	m_supportedFeatureURIs.insert(LV2_WORKER__schedule);
+	// no data, only tells the plugin that restore() may run concurrently
+	m_supportedFeatureURIs.insert(LV2_STATE__threadSafeRestore);
 
 	auto supportOpt = [this](Lv2UridCache::Id id)
 	{
@@ -133,40 +141,75 @@ void Lv2Manager::initPlugins()
 	QElapsedTimer timer;
 	timer.start();
 
+	// checking a plugin makes lilv load all of its data, so the results
+	// are cached by the bundle, which changes with any file in it
+	PluginCache cache(Engine::ignorePluginBlacklist()
+		? "lv2-noblacklist" : "lv2");
+
 	unsigned blacklisted = 0;
 	LILV_FOREACH(plugins, itr, plugins)
 	{
 		const LilvPlugin* curPlug = lilv_plugins_get(plugins, itr);
+		const char* uri = lilv_node_as_uri(lilv_plugin_get_uri(curPlug));
 
-		std::vector<PluginIssue> issues;
-		Plugin::PluginTypes type = Lv2ControlBase::check(curPlug, issues);
-		std::sort(issues.begin(), issues.end());
-		auto last = std::unique(issues.begin(), issues.end());
-		issues.erase(last, issues.end());
-		if (m_debug && issues.size())
+		QFileInfo bundle;
 		{
-			qDebug() << "Lv2 plugin"
-				<< qStringFromPluginNode(curPlug, lilv_plugin_get_name)
-				<< "(URI:"
-				<< lilv_node_as_uri(lilv_plugin_get_uri(curPlug))
-				<< ") can not be loaded:";
-			for (const PluginIssue& iss : issues) { qDebug() << "  - " << iss; }
+			char* bundlePath = lilv_file_uri_parse(lilv_node_as_uri(
+				lilv_plugin_get_bundle_uri(curPlug)), nullptr);
+			if (bundlePath)
+			{
+				bundle = QFileInfo(QString::fromLocal8Bit(bundlePath));
+				lilv_free(bundlePath);
+			}
+		}
+		const bool cacheable = !m_debug && bundle.isDir();
+		QJsonObject bundleData;
+		if (cacheable) { bundleData = cache.entry(bundle); }
+
+		Plugin::PluginTypes type;
+		bool valid, isBlacklisted;
+		const QJsonObject cached = bundleData.value(uri).toObject();
+		if (!cached.isEmpty())
+		{
+			type = static_cast<Plugin::PluginTypes>(cached.value("type").toInt());
+			valid = cached.value("valid").toBool();
+			isBlacklisted = cached.value("blacklisted").toBool();
 		}
-
-		Lv2Info info(curPlug, type, issues.empty());
-
-		m_lv2InfoMap[lilv_node_as_uri(lilv_plugin_get_uri(curPlug))]
-			= std::move(info);
-		if(issues.empty()) { ++pluginsLoaded; }
 		else
 		{
-			if(std::any_of(issues.begin(), issues.end(),
+			std::vector<PluginIssue> issues;
+			type = Lv2ControlBase::check(curPlug, issues);
+			std::sort(issues.begin(), issues.end());
+			auto last = std::unique(issues.begin(), issues.end());
+			issues.erase(last, issues.end());
+			if (m_debug && issues.size())
+			{
+				qDebug() << "Lv2 plugin"
+					<< qStringFromPluginNode(curPlug, lilv_plugin_get_name)
+					<< "(URI:" << uri << ") can not be loaded:";
+				for (const PluginIssue& iss : issues) { qDebug() << "  - " << iss; }
+			}
+			valid = issues.empty();
+			isBlacklisted = std::any_of(issues.begin(), issues.end(),
 				[](const PluginIssue& iss) {
-				return iss.type() == PluginIssueType::blacklisted; }))
+				return iss.type() == PluginIssueType::blacklisted; });
+
+			if (cacheable)
 			{
-				++blacklisted;
+				QJsonObject result;
+				result.insert("type", static_cast<int>(type));
+				result.insert("valid", valid);
+				result.insert("blacklisted", isBlacklisted);
+				bundleData.insert(uri, result);
+				cache.setEntry(bundle, bundleData);
 			}
 		}
+
+		Lv2Info info(curPlug, type, valid);
+
+		m_lv2InfoMap[uri] = std::move(info);
+		if(valid) { ++pluginsLoaded; }
+		else if(isBlacklisted) { ++blacklisted; }
 		++pluginCount;
 	}
 
@@ -34,6 +34,7 @@
 #include "Lv2Basics.h"
 #include "Lv2Manager.h"
 #include "Lv2Evbuf.h"
+#include "MixHelpers.h"
 
 namespace Lv2Ports {
 
@@ -312,10 +313,7 @@ Audio::Audio(std::size_t bufferSize, bool isSidechain)
 void Audio::copyBuffersFromCore(const sampleFrame *lmmsBuf,
 	unsigned channel, fpp_t frames)
 {
-	for (std::size_t f = 0; f < static_cast<unsigned>(frames); ++f)
-	{
-		m_buffer[f] = lmmsBuf[f][channel];
-	}
+	MixHelpers::deinterleave(m_buffer.data(), lmmsBuf, channel, frames);
 }
 
 
@@ -336,10 +334,27 @@ void Audio::averageWithBuffersFromCore(const sampleFrame *lmmsBuf,
 void Audio::copyBuffersToCore(sampleFrame *lmmsBuf,
 	unsigned channel, fpp_t frames) const
 {
-	for (std::size_t f = 0; f < static_cast<unsigned>(frames); ++f)
-	{
-		lmmsBuf[f][channel] = m_buffer[f];
-	}
+	MixHelpers::interleave(lmmsBuf, m_buffer.data(), channel, frames);
+}
+
+
+
+
+void Audio::copyStereoBuffersFromCore(Audio &left, Audio &right,
+	const sampleFrame *lmmsBuf, fpp_t frames)
+{
+	MixHelpers::deinterleave(left.m_buffer.data(), right.m_buffer.data(),
+		lmmsBuf, frames);
+}
+
+
+
+
+void Audio::copyStereoBuffersToCore(sampleFrame *lmmsBuf,
+	const Audio &left, const Audio &right, fpp_t frames)
+{
+	MixHelpers::interleave(lmmsBuf, left.m_buffer.data(),
+		right.m_buffer.data(), frames);
 }
 
 
@@ -30,7 +30,11 @@
 #include <lv2/lv2plug.in/ns/ext/midi/midi.h>
 #include <lv2/lv2plug.in/ns/ext/atom/atom.h>
 #include <lv2/lv2plug.in/ns/ext/resize-port/resize-port.h>
+#include <lv2/lv2plug.in/ns/ext/state/state.h>
+#include <lv2/lv2plug.in/ns/ext/worker/worker.h>
 #include <QDebug>
+#include <QDir>
+#include <QFile>
 #include <QtGlobal>
 
 #include "AudioEngine.h"
@@ -41,11 +45,18 @@
 #include "Lv2Manager.h"
 #include "Lv2Ports.h"
 #include "Lv2Evbuf.h"
+#include "Lv2Worker.h"
 #include "MidiEventToByteSeq.h"
 
 
 
 
+// state file in the state directory given to saveState()
+static const char* const stateFileName = "state.ttl";
+
+
+
+
 // container for everything required to store MIDI events going to the plugin
 struct MidiInputEvent
 {
@@ -286,6 +297,14 @@ void Lv2Proc::copyBuffersFromCore(const sampleFrame *buf,
 									unsigned firstChan, unsigned num,
 									fpp_t frames)
 {
+	if (num > 1 && firstChan == 0 && inPorts().m_right)
+	{
+		// stereo processor: deinterleave both channels in one pass
+		Lv2Ports::Audio::copyStereoBuffersFromCore(*inPorts().m_left,
+			*inPorts().m_right, buf, frames);
+		return;
+	}
+
 	inPorts().m_left->copyBuffersFromCore(buf, firstChan, frames);
 	if (num > 1)
 	{
@@ -311,6 +330,14 @@ void Lv2Proc::copyBuffersToCore(sampleFrame* buf,
 								unsigned firstChan, unsigned num,
 								fpp_t frames) const
 {
+	if (num > 1 && firstChan == 0 && outPorts().m_right)
+	{
+		// stereo processor: interleave both channels in one pass
+		Lv2Ports::Audio::copyStereoBuffersToCore(buf, *outPorts().m_left,
+			*outPorts().m_right, frames);
+		return;
+	}
+
 	outPorts().m_left->copyBuffersToCore(buf, firstChan + 0, frames);
 	if (num > 1)
 	{
@@ -326,9 +353,59 @@ void Lv2Proc::copyBuffersToCore(sampleFrame* buf,
 
 
 
+bool Lv2Proc::canConnectChannels(unsigned num) const
+{
+	AutoLilvNode inPlaceBroken = uri(LV2_CORE__inPlaceBroken);
+	if (lilv_plugin_has_feature(m_plugin, inPlaceBroken.get())) { return false; }
+
+	// each channel needs an input and an output, without mixing or
+	// duplicating as in copyBuffersFromCore() and copyBuffersToCore()
+	return m_inPorts.m_left && m_outPorts.m_left
+		&& (num == 1 || (num == 2 && m_inPorts.m_right && m_outPorts.m_right));
+}
+
+
+
+
+void Lv2Proc::connectChannels(const PlanarBuffer *buf, unsigned firstChan,
+								unsigned num)
+{
+	const sample_t* channel = buf ? buf->channels[firstChan] : nullptr;
+	if (channel == m_connectedChannel) { return; }
+
+	const auto connect = [this, buf](Lv2Ports::Audio* port, unsigned chan)
+	{
+		const uint32_t index = lilv_port_get_index(m_plugin, port->m_port);
+		if (buf)
+		{
+			lilv_instance_connect_port(m_instance, index, buf->channels[chan]);
+		}
+		else { connectPort(index); }
+	};
+	connect(m_inPorts.m_left, firstChan);
+	connect(m_outPorts.m_left, firstChan);
+	if (num > 1)
+	{
+		connect(m_inPorts.m_right, firstChan + 1);
+		connect(m_outPorts.m_right, firstChan + 1);
+	}
+	m_connectedChannel = channel;
+}
+
+
+
+
 void Lv2Proc::run(fpp_t frames)
 {
 	lilv_instance_run(m_instance, static_cast<uint32_t>(frames));
+
+	if (m_worker)
+	{
+		// deliver the results of work finished since the last period
+		m_stateWorker->emitResponses();
+		m_worker->emitResponses();
+		m_worker->endRun();
+	}
 }
 
 
@@ -369,6 +446,113 @@ void Lv2Proc::handleMidiInputEvent(const MidiEvent &event, const TimePos &time,
 
 
 
+QString Lv2Proc::saveState(const QString& dir)
+{
+	AutoLilvNode stateIface = uri(LV2_STATE__interface);
+	if (!m_valid || !lilv_plugin_has_extension_data(m_plugin, stateIface.get()))
+	{
+		return QString();
+	}
+
+	// with a directory, lilv passes state:mapPath and state:makePath to the
+	// plugin: new files are made in it, other files are copied or linked
+	// into it, and all of them are mapped to paths relative to it
+	const QByteArray dirName = QFile::encodeName(dir);
+	const char* stateDir = dir.isEmpty() ? nullptr : dirName.constData();
+	if (stateDir)
+	{
+		QDir().mkpath(dir);
+		QFile::remove(QDir(dir).filePath(stateFileName));
+	}
+
+	// control port values are not included, they are saved by our models
+	Lv2Manager* mgr = Engine::getLv2Manager();
+	LilvState* state = lilv_state_new_from_instance(m_plugin, m_instance,
+		mgr->uridMap().mapFeature(), stateDir, stateDir, stateDir, stateDir,
+		nullptr, nullptr, LV2_STATE_IS_POD | LV2_STATE_IS_PORTABLE,
+		m_features.featurePointers());
+	if (!state) { return QString(); }
+
+	if (stateDir)
+	{
+		// a state without files does not need its directory, otherwise
+		// keep the relative paths next to the files (the string has
+		// absolute ones)
+		if (QDir(dir).entryList(QDir::AllEntries | QDir::NoDotAndDotDot).isEmpty())
+		{
+			QDir().rmdir(dir);
+		}
+		else if (lilv_state_save(mgr->world(), mgr->uridMap().mapFeature(),
+			mgr->uridMap().unmapFeature(), state, nullptr, stateDir,
+			stateFileName))
+		{
+			qWarning() << "Could not save state of Lv2 plugin"
+				<< qStringFromPluginNode(m_plugin, lilv_plugin_get_name)
+				<< "to" << dir;
+		}
+	}
+
+	char* str = lilv_state_to_string(mgr->world(), mgr->uridMap().mapFeature(),
+		mgr->uridMap().unmapFeature(), state, "urn:lmms:state", nullptr);
+	QString res = str ? QString::fromUtf8(str) : QString();
+	lilv_free(str);
+	lilv_state_free(state);
+	return res;
+}
+
+
+
+
+void Lv2Proc::restoreState(const QString &stateStr, const QString& dir)
+{
+	if (!m_valid || stateStr.isEmpty()) { return; }
+
+	Lv2Manager* mgr = Engine::getLv2Manager();
+	LilvState* state = nullptr;
+	const QString file = QDir(dir).filePath(stateFileName);
+	if (!dir.isEmpty() && QFile::exists(file))
+	{
+		// lilv maps the relative paths of a state file to its directory,
+		// so this still works if the project has been moved
+		state = lilv_state_new_from_file(mgr->world(),
+			mgr->uridMap().mapFeature(), nullptr,
+			QFile::encodeName(file).constData());
+	}
+	if (!state)
+	{
+		state = lilv_state_new_from_string(mgr->world(),
+			mgr->uridMap().mapFeature(), stateStr.toUtf8().constData());
+	}
+	if (!state)
+	{
+		qWarning() << "Could not parse state of Lv2 plugin"
+			<< qStringFromPluginNode(m_plugin, lilv_plugin_get_name);
+		return;
+	}
+
+	// work scheduled by restore() is done right away in this thread,
+	// the responses are delivered to the plugin in the next run()
+	LV2_Feature workerFeature { LV2_WORKER__schedule,
+		m_stateWorker ? m_stateWorker->feature() : nullptr };
+	const LV2_Feature* features[] = { &workerFeature, nullptr };
+
+	AutoLilvNode threadSafeRestore = uri(LV2_STATE__threadSafeRestore);
+	const bool threadSafe =
+		lilv_plugin_has_feature(m_plugin, threadSafeRestore.get());
+
+	// plugins which do not support state:threadSafeRestore must not run
+	// while they are being restored
+	if (!threadSafe) { Engine::audioEngine()->requestChangeInModel(); }
+	lilv_state_restore(state, m_instance, nullptr, nullptr, 0,
+		m_stateWorker ? features : features + 1);
+	if (!threadSafe) { Engine::audioEngine()->doneChangeInModel(); }
+
+	lilv_state_free(state);
+}
+
+
+
+
 AutomatableModel *Lv2Proc::modelAtPort(const QString &uri)
 {
 	// unused currently
@@ -396,8 +580,18 @@ void Lv2Proc::initPlugin()
 
 	if (m_instance)
 	{
+		if (m_worker)
+		{
+			const auto iface = static_cast<const LV2_Worker_Interface*>(
+				lilv_instance_get_extension_data(m_instance, LV2_WORKER__interface));
+			LV2_Handle handle = lilv_instance_get_handle(m_instance);
+			m_worker->setHandle(handle, iface);
+			m_stateWorker->setHandle(handle, iface);
+		}
+
 		for (std::size_t portNum = 0; portNum < m_ports.size(); ++portNum)
 			connectPort(portNum);
+		m_connectedChannel = nullptr;
 		lilv_instance_activate(m_instance);
 	}
 	else
@@ -416,6 +610,11 @@ void Lv2Proc::initPlugin()
 
 void Lv2Proc::shutdownPlugin()
 {
+	if (m_worker)
+	{
+		// the worker thread must not call work() on a freed instance
+		m_worker->stop();
+	}
 	if (m_valid)
 	{
 		lilv_instance_deactivate(m_instance);
@@ -471,6 +670,14 @@ void Lv2Proc::initPluginSpecificFeatures()
 {
 	initMOptions();
 	m_features[LV2_OPTIONS__options] = const_cast<LV2_Options_Option*>(m_options.feature());
+
+	AutoLilvNode workerIface = uri(LV2_WORKER__interface);
+	if (lilv_plugin_has_extension_data(m_plugin, workerIface.get()))
+	{
+		m_worker.reset(new Lv2Worker(true));
+		m_stateWorker.reset(new Lv2Worker(false));
+		m_features[LV2_WORKER__schedule] = m_worker->feature();
+	}
 }
 
 
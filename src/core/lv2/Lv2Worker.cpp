@@ -0,0 +1,217 @@
+/*
+ * Lv2Worker.cpp - Lv2Worker implementation
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "Lv2Worker.h"
+
+#ifdef LMMS_HAVE_LV2
+
+#include <cstring>
+
+
+Lv2Worker::Lv2Worker(bool threaded) :
+	m_threaded(threaded),
+	m_requests(m_ringSize),
+	m_requestsReader(m_requests),
+	m_responses(m_ringSize),
+	m_responsesReader(m_responses),
+	m_requestStage(m_ringSize),
+	m_responseStage(m_ringSize),
+	m_requestData(m_ringSize),
+	m_responseData(m_ringSize),
+	m_exit(false)
+{
+	m_scheduleFeature.handle = static_cast<LV2_Worker_Schedule_Handle>(this);
+	m_scheduleFeature.schedule_work = &Lv2Worker::staticScheduleWork;
+
+	if (m_threaded)
+	{
+		m_thread.reset(new WorkerThread(this));
+		m_thread->setObjectName("lv2 worker");
+		m_thread->start(QThread::LowPriority);
+	}
+}
+
+
+
+
+Lv2Worker::~Lv2Worker()
+{
+	stop();
+}
+
+
+
+
+void Lv2Worker::setHandle(LV2_Handle handle, const LV2_Worker_Interface* iface)
+{
+	m_handle = handle;
+	m_iface = iface;
+}
+
+
+
+
+void Lv2Worker::stop()
+{
+	if (m_thread)
+	{
+		m_exit = true;
+		m_sem.release();
+		m_thread->wait();
+		m_thread.reset();
+	}
+}
+
+
+
+
+void Lv2Worker::emitResponses()
+{
+	if (!m_iface) { return; }
+	while (m_responsesReader.read_space() >= sizeof(uint32_t))
+	{
+		uint32_t size = readMessage(m_responsesReader, m_responseData);
+		m_iface->work_response(m_handle, size, m_responseData.data());
+	}
+}
+
+
+
+
+void Lv2Worker::endRun()
+{
+	if (m_iface && m_iface->end_run) { m_iface->end_run(m_handle); }
+}
+
+
+
+
+LV2_Worker_Status Lv2Worker::staticScheduleWork(
+	LV2_Worker_Schedule_Handle handle, uint32_t size, const void* data)
+{
+	return static_cast<Lv2Worker*>(handle)->scheduleWork(size, data);
+}
+
+
+
+
+LV2_Worker_Status Lv2Worker::staticRespond(
+	LV2_Worker_Respond_Handle handle, uint32_t size, const void* data)
+{
+	return static_cast<Lv2Worker*>(handle)->respond(size, data);
+}
+
+
+
+
+LV2_Worker_Status Lv2Worker::scheduleWork(uint32_t size, const void* data)
+{
+	if (!m_iface) { return LV2_WORKER_ERR_UNKNOWN; }
+
+	if (m_threaded)
+	{
+		// called from the audio thread: hand the request to the worker
+		if (!writeMessage(m_requests, m_requestStage, size, data))
+		{
+			return LV2_WORKER_ERR_NO_SPACE;
+		}
+		m_sem.release();
+		return LV2_WORKER_SUCCESS;
+	}
+	else
+	{
+		// called from a non-RT thread (e.g. during restore): work now
+		return m_iface->work(m_handle, &Lv2Worker::staticRespond, this,
+			size, data);
+	}
+}
+
+
+
+
+LV2_Worker_Status Lv2Worker::respond(uint32_t size, const void* data)
+{
+	return writeMessage(m_responses, m_responseStage, size, data)
+		? LV2_WORKER_SUCCESS
+		: LV2_WORKER_ERR_NO_SPACE;
+}
+
+
+
+
+bool Lv2Worker::writeMessage(ringbuffer_t<char>& ring,
+	std::vector<char>& stage, uint32_t size, const void* data)
+{
+	const std::size_t total = sizeof(size) + size;
+	if (total > stage.size() || ring.write_space() < total) { return false; }
+
+	// write header and body at once, so the reader never sees half a message
+	std::memcpy(stage.data(), &size, sizeof(size));
+	std::memcpy(stage.data() + sizeof(size), data, size);
+	return ring.write(stage.data(), total) == total;
+}
+
+
+
+
+uint32_t Lv2Worker::readMessage(ringbuffer_reader_t<char>& reader,
+	std::vector<char>& dest)
+{
+	uint32_t size;
+	{
+		auto header = reader.read(sizeof(size));
+		char bytes[sizeof(size)];
+		for (std::size_t i = 0; i < sizeof(size); ++i) { bytes[i] = header[i]; }
+		std::memcpy(&size, bytes, sizeof(size));
+	}
+	{
+		auto body = reader.read(size);
+		for (uint32_t i = 0; i < size; ++i) { dest[i] = body[i]; }
+	}
+	return size;
+}
+
+
+
+
+void Lv2Worker::workerFunc()
+{
+	while (true)
+	{
+		m_sem.acquire();
+		if (m_exit) { break; }
+
+		// one semaphore count per request, but be robust against batching
+		while (m_requestsReader.read_space() >= sizeof(uint32_t))
+		{
+			uint32_t size = readMessage(m_requestsReader, m_requestData);
+			if (m_iface)
+			{
+				m_iface->work(m_handle, &Lv2Worker::staticRespond, this,
+					size, m_requestData.data());
+			}
+		}
+	}
+}
+
+
+#endif // LMMS_HAVE_LV2
@@ -58,6 +58,7 @@
 #include <signal.h>
 
 #include "MainApplication.h"
+#include "BatchRenderer.h"
 #include "ConfigManager.h"
 #include "DataFile.h"
 #include "NotePlayHandle.h"
@@ -166,6 +167,9 @@ void printHelp()
 		"  compress <in>                         Compress file <in>\n"
 		"  render <project> [options...]         Render given project file\n"
 		"  rendertracks <project> [options...]   Render each track to a different file\n"
+		"  render-batch <joblist> [options...]   Render all projects listed in <joblist>\n"
+		"                                        (one per line, optionally followed by\n"
+		"                                        a tab and the output file)\n"
 		"  upgrade <in> [out]                    Upgrade file <in> and save as <out>\n"
 		"                                        Standard out is used if no output file\n"
 		"                                        is specified\n"
@@ -184,7 +188,7 @@ void printHelp()
 		"          geometry is <xsizexysize+xoffset+yoffsety>.\n"
 		"      --import <in> [-e]         Import MIDI or Hydrogen file <in>.\n"
 		"          If -e is specified lmms exits after importing the file.\n"
-		"\nOptions for \"render\" and \"rendertracks\":\n"
+		"\nOptions for \"render\", \"rendertracks\" and \"render-batch\":\n"
 		"  -a, --float                    Use 32bit float bit depth\n"
 		"  -b, --bitrate <bitrate>        Specify output bitrate in KBit/s\n"
 		"          Default: 160.\n"
@@ -213,7 +217,10 @@ void printHelp()
 		"          Range: 44100 (default) to 192000\n"
 		"  -x, --oversampling <value>     Specify oversampling\n"
 		"          Possible values: 1, 2, 4, 8\n"
-		"          Default: 2\n\n",
+		"          Default: 2\n"
+		"\nOptions for \"render-batch\":\n"
+		"  -j, --jobs <n>                 Render in <n> worker processes at once\n"
+		"          Default: 1, rendering all projects in this process\n\n",
 		LMMS_VERSION, LMMS_PROJECT_COPYRIGHT );
 }
 
@@ -307,7 +314,10 @@ int main( int argc, char * * argv )
 	bool allowRoot = false;
 	bool renderLoop = false;
 	bool renderTracks = false;
+	int batchJobs = 1;
+	int batchListArgument = -1;
 	QString fileToLoad, fileToImport, renderOut, profilerOutputFile, configFile;
+	QString batchList;
 
 	// first of two command-line parsing stages
 	for( int i = 1; i < argc; ++i )
@@ -316,7 +326,8 @@ int main( int argc, char * * argv )
 
 		if( arg == "--help"    || arg == "-h" ||
 		    arg == "--version" || arg == "-v" ||
-		    arg == "render" || arg == "--render" || arg == "-r" )
+		    arg == "render" || arg == "--render" || arg == "-r" ||
+		    arg == "render-batch" )
 		{
 			coreOnly = true;
 		}
@@ -486,6 +497,33 @@ int main( int argc, char * * argv )
 			fileToLoad = QString::fromLocal8Bit( argv[i] );
 			renderOut = fileToLoad;
 		}
+		else if( arg == "render-batch" )
+		{
+			++i;
+
+			if( i == argc )
+			{
+				return usageError( "No job list specified" );
+			}
+
+			batchList = QString::fromLocal8Bit( argv[i] );
+			batchListArgument = i;
+		}
+		else if( arg == "--jobs" || arg == "-j" )
+		{
+			++i;
+
+			if( i == argc )
+			{
+				return usageError( "No number of jobs specified" );
+			}
+
+			batchJobs = QString( argv[i] ).toInt();
+			if( batchJobs < 1 )
+			{
+				return usageError( QString( "Invalid number of jobs %1" ).arg( argv[i] ) );
+			}
+		}
 		else if( arg == "--loop" || arg == "-l" )
 		{
 			renderLoop = true;
@@ -800,10 +838,39 @@ int main( int argc, char * * argv )
 #endif
 
 	bool destroyEngine = false;
+	BatchRenderer * batchRenderer = nullptr;
+
+	// if we have a job list, render all projects in it without starting
+	// the GUI
+	if( !batchList.isEmpty() )
+	{
+		batchRenderer = new BatchRenderer( qs, os, eff, renderLoop );
+		if( !batchRenderer->loadJobList( batchList ) )
+		{
+			printf( "Could not read the job list %s\n",
+					batchList.toUtf8().constData() );
+			exit( EXIT_FAILURE );
+		}
+		QCoreApplication::instance()->connect( batchRenderer,
+				SIGNAL( finished() ), SLOT( quit() ) );
 
+		if( batchJobs > 1 )
+		{
+			// the workers initialize the engine themselves
+			batchRenderer->startWorkers( batchJobs,
+				QCoreApplication::arguments(), batchListArgument );
+		}
+		else
+		{
+			// initialize once for all projects
+			Engine::init( true );
+			destroyEngine = true;
+			batchRenderer->start();
+		}
+	}
 	// if we have an output file for rendering, just render the song
 	// without starting the GUI
-	if( !renderOut.isEmpty() )
+	else if( !renderOut.isEmpty() )
 	{
 		Engine::init( true );
 		destroyEngine = true;
@@ -829,6 +896,11 @@ int main( int argc, char * * argv )
 
 		// create renderer
 		RenderManager * r = new RenderManager( qs, os, eff, renderOut );
+		QObject::connect( r, &RenderManager::finished, [r]()
+		{
+			fprintf( stderr, "\nRendered at %.1fx real time\n",
+						r->realTimeFactor() );
+		} );
 		QCoreApplication::instance()->connect( r,
 				SIGNAL( finished() ), SLOT( quit() ) );
 
@@ -1012,7 +1084,12 @@ int main( int argc, char * * argv )
 		}
 	}
 
-	const int ret = app->exec();
+	int ret = app->exec();
+	if( batchRenderer )
+	{
+		if( batchRenderer->failedJobs() > 0 ) { ret = EXIT_FAILURE; }
+		delete batchRenderer;
+	}
 	delete app;
 
 	if( destroyEngine )
@@ -52,7 +52,7 @@ MidiAlsaRaw::MidiAlsaRaw() :
 	m_pfds = new pollfd[m_npfds];
 	snd_rawmidi_poll_descriptors( m_input, m_pfds, m_npfds );
 
-	start( QThread::LowPriority );
+	start( QThread::HighPriority );
 }
 
 
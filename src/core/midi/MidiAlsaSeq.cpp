@@ -116,7 +116,7 @@ MidiAlsaSeq::MidiAlsaSeq() :
 		perror( "MidiAlsaSeq: pipe" );
 	}
 
-	start( QThread::IdlePriority );
+	start( QThread::HighPriority );
 }
 
 
@@ -118,8 +118,10 @@ MidiClientRaw::~MidiClientRaw()
 
 
 
-void MidiClientRaw::parseData( const unsigned char c )
+void MidiClientRaw::parseData( const unsigned char c, MidiClock::time_point timestamp )
 {
+	m_midiParseData.m_timestamp = timestamp;
+
 	/*********************************************************************/
 	/* 'Process' system real-time messages                               */
 	/*********************************************************************/
@@ -255,7 +257,8 @@ void MidiClientRaw::processParsedEvent()
 {
 	for( int i = 0; i < m_midiPorts.size(); ++i )
 	{
-		m_midiPorts[i]->processInEvent( m_midiParseData.m_midiEvent );
+		m_midiPorts[i]->processInEvent( m_midiParseData.m_midiEvent,
+				TimePos(), m_midiParseData.m_timestamp );
 	}
 }
 
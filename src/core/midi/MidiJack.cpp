@@ -183,6 +183,11 @@ void MidiJack::JackMidiRead(jack_nframes_t nframes)
 	jack_nframes_t event_index = 0;
 	jack_nframes_t event_count = jack_midi_get_event_count(port_buf);
 
+	// the events of this cycle were received during the previous one, so
+	// reconstruct their timestamps from their frame offsets
+	const MidiClock::time_point cycleStart = MidiClock::now();
+	const double framesPerSecond = jack_get_sample_rate(jackClient());
+
 	int rval = jack_midi_event_get(&in_event, port_buf, 0);
 	if (rval == 0 /* 0 = success */)
 	{
@@ -190,10 +195,14 @@ void MidiJack::JackMidiRead(jack_nframes_t nframes)
 		{
 			while((in_event.time == i) && (event_index < event_count))
 			{
+				const auto timestamp = cycleStart -
+					std::chrono::duration_cast<MidiClock::duration>(
+						std::chrono::duration<double>(
+							(nframes - in_event.time) / framesPerSecond));
 				// lmms is setup to parse bytes coming from a device
 				// parse it byte by byte as it expects
 				for(b=0;b<in_event.size;b++)
-					parseData( *(in_event.buffer + b) );
+					parseData( *(in_event.buffer + b), timestamp );
 
 				event_index++;
 				if(event_index < event_count)
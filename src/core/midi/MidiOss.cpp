@@ -42,7 +42,7 @@ MidiOss::MidiOss() :
 	if( m_midiDev.open( QIODevice::ReadWrite ) ||
 					m_midiDev.open( QIODevice::ReadOnly ) )
 	{
-		start( QThread::LowPriority );
+		start( QThread::HighPriority );
 	}
 }
 
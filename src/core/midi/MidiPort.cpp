@@ -26,13 +26,19 @@
 #include <QDomElement>
 
 #include "MidiPort.h"
+#include "AudioEngine.h"
+#include "Engine.h"
 #include "MidiClient.h"
 #include "MidiDummy.h"
+#include "MidiEventProcessor.h"
 #include "Note.h"
 #include "Song.h"
 
 static MidiDummy s_dummyClient;
 
+// maximum amount of incoming events per port and period
+static const size_t MAX_QUEUED_IN_EVENTS = 1024;
+
 
 
 MidiPort::MidiPort( const QString& name,
@@ -56,9 +62,11 @@ MidiPort::MidiPort( const QString& name,
 	m_outputProgramModel( 1, 1, MidiProgramCount, this, tr( "Output MIDI program" ) ),
 	m_baseVelocityModel( MidiMaxVelocity/2, 1, MidiMaxVelocity, this, tr( "Base velocity" ) ),
 	m_readableModel( false, this, tr( "Receive MIDI-events" ) ),
-	m_writableModel( false, this, tr( "Send MIDI-events" ) )
+	m_writableModel( false, this, tr( "Send MIDI-events" ) ),
+	m_inEventQueue( MAX_QUEUED_IN_EVENTS )
 {
 	m_midiClient->addPort( this );
+	Engine::audioEngine()->addMidiPort( this );
 
 	m_readableModel.setValue( m_mode == Input || m_mode == Duplex );
 	m_writableModel.setValue( m_mode == Output || m_mode == Duplex );
@@ -97,6 +105,18 @@ MidiPort::~MidiPort()
 
 	// and finally unregister ourself
 	m_midiClient->removePort( this );
+	if( Engine::audioEngine() )
+	{
+		Engine::audioEngine()->removeMidiPort( this );
+	}
+
+	// drop events which haven't been processed anymore
+	for( auto e = m_inEventQueue.popList(); e; )
+	{
+		auto next = e->next;
+		m_inEventQueue.free( e );
+		e = next;
+	}
 }
 
 
@@ -120,7 +140,8 @@ void MidiPort::setMode( Mode mode )
 
 
 
-void MidiPort::processInEvent( const MidiEvent& event, const TimePos& time )
+void MidiPort::processInEvent( const MidiEvent& event, const TimePos& time,
+					MidiClock::time_point timestamp )
 {
 	// mask event
 	if( isInputEnabled() &&
@@ -142,7 +163,59 @@ void MidiPort::processInEvent( const MidiEvent& event, const TimePos& time )
 			}
 		}
 
-		m_midiEventProcessor->processInEvent( inEvent, time );
+		// the source port points to data of the MIDI client which is
+		// reused once this returns
+		m_midiEventProcessor->inEventReceived( inEvent );
+		inEvent.setSourcePort( nullptr );
+
+		if( !m_inEventQueue.push( { inEvent, time, timestamp } ) )
+		{
+			qWarning( "MidiPort: too many incoming events, dropping event" );
+		}
+	}
+}
+
+
+
+
+void MidiPort::processQueuedInEvents( MidiClock::time_point lastPeriodStart,
+					MidiClock::time_point periodStart, fpp_t frames )
+{
+	auto e = m_inEventQueue.popList();
+	if( e == nullptr )
+	{
+		return;
+	}
+
+	// the list is in reverse order, so restore the order of arrival
+	decltype( e ) ordered = nullptr;
+	while( e )
+	{
+		auto next = e->next;
+		e->next = ordered;
+		ordered = e;
+		e = next;
+	}
+
+	// map the time between the previous and the current period start onto
+	// the frames of this period, which also works if the audio thread
+	// renders several periods in a row (e.g. with a FIFO)
+	const double periodLength = std::chrono::duration<double>(
+					periodStart - lastPeriodStart ).count();
+	for( e = ordered; e; )
+	{
+		f_cnt_t offset = 0;
+		if( periodLength > 0 )
+		{
+			const double pos = std::chrono::duration<double>(
+				e->value.timestamp - lastPeriodStart ).count() / periodLength;
+			offset = qBound<f_cnt_t>( 0, static_cast<f_cnt_t>( pos * frames ), frames - 1 );
+		}
+		m_midiEventProcessor->processInEvent( e->value.event, e->value.time, offset );
+
+		auto next = e->next;
+		m_inEventQueue.free( e );
+		e = next;
 	}
 }
 
@@ -63,7 +63,9 @@ public:
 	}
 
 
-	void processInEvent( const MidiEvent& event, const TimePos& time, f_cnt_t offset = 0 ) override
+	// detects on the MIDI thread, as the source port of the event is only
+	// valid there, and so the audio thread doesn't call into the client
+	void inEventReceived( const MidiEvent& event ) override
 	{
 		if( event.type() == MidiControlChange &&
 			( m_midiPort.inputChannel() == 0 || m_midiPort.inputChannel() == event.channel() + 1 ) )
@@ -77,6 +79,11 @@ public:
 	}
 
 
+	void processInEvent( const MidiEvent&, const TimePos&, f_cnt_t = 0 ) override
+	{
+	}
+
+
 	// Would be a nice copy ctor, but too hard to add copy ctor because
 	// model has none.
 	MidiController* copyToMidiController( Model* parent )
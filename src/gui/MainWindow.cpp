@@ -67,6 +67,7 @@
 #include "RemotePlugin.h"
 #include "SetupDialog.h"
 #include "SideBar.h"
+#include "Song.h"
 #include "SongEditor.h"
 #include "TemplatesMenu.h"
 #include "TextFloat.h"
@@ -99,6 +100,9 @@ MainWindow::MainWindow() :
 	m_workspace( nullptr ),
 	m_toolsMenu( nullptr ),
 	m_autoSaveTimer( this ),
+	m_autoSaveWriter( this ),
+	m_autoSaveModificationCount( 0 ),
+	m_autoSavePendingCount( 0 ),
 	m_viewMenu( nullptr ),
 	m_metronomeToggle( 0 ),
 	m_session( Normal )
@@ -239,6 +243,14 @@ MainWindow::MainWindow() :
 	{
 		// connect auto save
 		connect(&m_autoSaveTimer, SIGNAL(timeout()), this, SLOT(autoSave()));
+		// a failed write is retried with the next auto-save
+		connect(&m_autoSaveWriter, &QThread::finished, this, [this]()
+		{
+			if (m_autoSaveWriter.succeeded())
+			{
+				m_autoSaveModificationCount = m_autoSavePendingCount;
+			}
+		}, Qt::DirectConnection);
 		m_autoSaveInterval = ConfigManager::inst()->value(
 					"ui", "saveinterval" ).toInt() < 1 ?
 						DEFAULT_AUTO_SAVE_INTERVAL :
@@ -1383,6 +1395,8 @@ void MainWindow::closeEvent( QCloseEvent * _ce )
 
 void MainWindow::sessionCleanup()
 {
+	// a pending auto-save would recreate the file after deleting it
+	m_autoSaveWriter.wait();
 	// delete recover session files
 	QFile::remove( ConfigManager::inst()->recoveryFile() );
 	setSession( Normal );
@@ -1485,15 +1499,27 @@ void MainWindow::browseHelp()
 
 void MainWindow::autoSave()
 {
-	if( !Engine::getSong()->isExporting() &&
-		!Engine::getSong()->isLoadingProject() &&
+	Song * song = Engine::getSong();
+	if( !m_autoSaveWriter.isRunning() &&
+		!song->isExporting() &&
+		!song->isLoadingProject() &&
 		!RemotePluginBase::isMainThreadWaiting() &&
 		!QApplication::mouseButtons() &&
 		( ConfigManager::inst()->value( "ui",
 				"enablerunningautosave" ).toInt() ||
-			! Engine::getSong()->isPlaying() ) )
+			! song->isPlaying() ) )
 	{
-		Engine::getSong()->saveProjectFile(ConfigManager::inst()->recoveryFile());
+		// nothing to do if the project didn't change since the last auto-save
+		if( song->modificationCount() != m_autoSaveModificationCount )
+		{
+			// only taking the snapshot has to happen here, serializing,
+			// compressing and writing it is done by the writer thread
+			auto dataFile = std::make_unique<DataFile>( DataFile::SongProject );
+			song->saveProjectState( *dataFile );
+			m_autoSavePendingCount = song->modificationCount();
+			m_autoSaveWriter.write( std::move( dataFile ),
+					ConfigManager::inst()->recoveryFile() );
+		}
 		autoSaveTimerReset();  // Reset timer
 	}
 	else
@@ -201,7 +201,6 @@ PluginDescWidget::PluginDescWidget(const PluginKey &_pk,
 							QWidget * _parent ) :
 	QWidget( _parent ),
 	m_pluginKey( _pk ),
-	m_logo( _pk.logo()->pixmap() ),
 	m_mouseOver( false )
 {
 	setFixedHeight( DEFAULT_HEIGHT );
@@ -237,6 +236,10 @@ void PluginDescWidget::paintEvent( QPaintEvent * )
 	const int s = 16 + ( 32 * ( qBound( 24, height(), 60 ) - 24 ) ) /
 								( 60 - 24 );
 	const QSize logo_size( s, s );
+	if( m_logo.isNull() && m_pluginKey.logo() )
+	{
+		m_logo = m_pluginKey.logo()->pixmap();
+	}
 	QPixmap logo = m_logo.scaled( logo_size, Qt::KeepAspectRatio,
 						Qt::SmoothTransformation );
 	p.drawPixmap( 4, 4, logo );
@@ -31,6 +31,7 @@
 #include "gui_templates.h"
 #include "GuiApplication.h"
 #include "Knob.h"
+#include "LedCheckbox.h"
 #include "MainWindow.h"
 #include "Song.h"
 #include "TabWidget.h"
@@ -110,18 +111,31 @@ SampleTrackWindow::SampleTrackWindow(SampleTrackView * tv) :
 	basicControlsLayout->setAlignment(label, labelAlignment);
 
 
-	basicControlsLayout->setColumnStretch(2, 1);
+	// set up input monitoring switch
+	m_monitorButton = new LedCheckBox(nullptr, tr("Monitor input"), LedCheckBox::Green);
+	m_monitorButton->setToolTip(tr("Play the audio input through this track"));
+
+	basicControlsLayout->addWidget(m_monitorButton, 0, 2);
+	basicControlsLayout->setAlignment(m_monitorButton, widgetAlignment);
+
+	label = new QLabel(tr("MON"), this);
+	label->setStyleSheet(labelStyleSheet);
+	basicControlsLayout->addWidget(label, 1, 2);
+	basicControlsLayout->setAlignment(label, labelAlignment);
+
+
+	basicControlsLayout->setColumnStretch(3, 1);
 
 
 	// setup spinbox for selecting Mixer-channel
 	m_mixerChannelNumber = new MixerLineLcdSpinBox(2, nullptr, tr("Mixer channel"), m_stv);
 
-	basicControlsLayout->addWidget(m_mixerChannelNumber, 0, 3);
+	basicControlsLayout->addWidget(m_mixerChannelNumber, 0, 4);
 	basicControlsLayout->setAlignment(m_mixerChannelNumber, widgetAlignment);
 
 	label = new QLabel(tr("CHANNEL"), this);
 	label->setStyleSheet(labelStyleSheet);
-	basicControlsLayout->addWidget(label, 1, 3);
+	basicControlsLayout->addWidget(label, 1, 4);
 	basicControlsLayout->setAlignment(label, labelAlignment);
 
 	generalSettingsLayout->addLayout(basicControlsLayout);
@@ -183,6 +197,7 @@ void SampleTrackWindow::modelChanged()
 
 	m_volumeKnob->setModel(&m_track->m_volumeModel);
 	m_panningKnob->setModel(&m_track->m_panningModel);
+	m_monitorButton->setModel(&m_track->m_monitorModel);
 	m_mixerChannelNumber->setModel(&m_track->m_mixerChannelModel);
 
 	updateName();
@@ -45,6 +45,7 @@
 #include "TabBar.h"
 #include "TabButton.h"
 #include "ToolTip.h"
+#include "VoiceLimiter.h"
 
 
 // Platform-specific audio-interface classes.
@@ -127,6 +128,11 @@ SetupDialog::SetupDialog(ConfigTabs tab_to_open) :
 			"ui", "enableautosave", "1").toInt()),
 	m_enableRunningAutoSave(ConfigManager::inst()->value(
 			"ui", "enablerunningautosave", "0").toInt()),
+	m_undoMemory(ConfigManager::inst()->value(
+			"app", "undomemory").toInt() < 1 ?
+			ProjectJournal::DEFAULT_UNDO_MEMORY_MB :
+			ConfigManager::inst()->value(
+			"app", "undomemory").toInt()),
 	m_smoothScroll(ConfigManager::inst()->value(
 			"ui", "smoothscroll").toInt()),
 	m_animateAFP(ConfigManager::inst()->value(
@@ -138,12 +144,18 @@ SetupDialog::SetupDialog(ConfigTabs tab_to_open) :
 			"ui", "syncvstplugins", "1").toInt()),
 	m_disableAutoQuit(ConfigManager::inst()->value(
 			"ui", "disableautoquit", "1").toInt()),
+	m_pipelineRemotePlugins(ConfigManager::inst()->value(
+			"audioengine", "pipelineremoteplugins").toInt()),
 	m_NaNHandler(ConfigManager::inst()->value(
 			"app", "nanhandler", "1").toInt()),
 	m_hqAudioDev(ConfigManager::inst()->value(
 			"audioengine", "hqaudio").toInt()),
 	m_bufferSize(ConfigManager::inst()->value(
 			"audioengine", "framesperaudiobuffer").toInt()),
+	m_maxVoices(ConfigManager::inst()->value(
+			"audioengine", "maxvoices").toInt()),
+	m_adaptiveVoices(ConfigManager::inst()->value(
+			"audioengine", "adaptivevoices").toInt()),
 	m_workingDir(QDir::toNativeSeparators(ConfigManager::inst()->workingDir())),
 	m_vstDir(QDir::toNativeSeparators(ConfigManager::inst()->vstDir())),
 	m_ladspaDir(QDir::toNativeSeparators(ConfigManager::inst()->ladspaDir())),
@@ -376,6 +388,27 @@ SetupDialog::SetupDialog(ConfigTabs tab_to_open) :
 	m_runningAutoSave->setVisible(m_enableAutoSave);
 
 
+	// Undo tab.
+	TabWidget * undo_tw = new TabWidget(
+			tr("Undo history"), performance_w);
+	undo_tw->setFixedHeight(70);
+
+	m_undoMemorySlider = new QSlider(Qt::Horizontal, undo_tw);
+	m_undoMemorySlider->setRange(1, 64);
+	m_undoMemorySlider->setValue(qBound(1, m_undoMemory / 16, 64));
+	m_undoMemorySlider->setTickInterval(4);
+	m_undoMemorySlider->setPageStep(4);
+	m_undoMemorySlider->setGeometry(10, 18, 340, 18);
+	m_undoMemorySlider->setTickPosition(QSlider::TicksBelow);
+
+	m_undoMemoryLbl = new QLabel(undo_tw);
+	m_undoMemoryLbl->setGeometry(10, 40, 300, 24);
+	setUndoMemory(m_undoMemorySlider->value());
+
+	connect(m_undoMemorySlider, SIGNAL(valueChanged(int)),
+			this, SLOT(setUndoMemory(int)));
+
+
 	counter = 0;
 
 	// UI effect vs. performance tab.
@@ -437,11 +470,15 @@ SetupDialog::SetupDialog(ConfigTabs tab_to_open) :
 	addLedCheckBox(tr("Keep effects running even without input"), plugins_tw, counter,
 		m_disableAutoQuit, SLOT(toggleDisableAutoQuit(bool)), false);
 
+	addLedCheckBox(tr("Run remote instruments one buffer ahead"), plugins_tw, counter,
+		m_pipelineRemotePlugins, SLOT(togglePipelineRemotePlugins(bool)), true);
+
 	plugins_tw->setFixedHeight(YDelta + YDelta * counter);
 
 
 	// Performance layout ordering.
 	performance_layout->addWidget(auto_save_tw);
+	performance_layout->addWidget(undo_tw);
 	performance_layout->addWidget(ui_fx_tw);
 	performance_layout->addWidget(plugins_tw);
 	performance_layout->addStretch();
@@ -594,11 +631,53 @@ SetupDialog::SetupDialog(ConfigTabs tab_to_open) :
 			tr("Reset to default value"));
 
 
+	// Voices tab.
+	TabWidget * voices_tw = new TabWidget(
+			tr("Voices"), audio_w);
+	voices_tw->setFixedHeight(100);
+
+	m_maxVoicesSlider = new QSlider(Qt::Horizontal, voices_tw);
+	m_maxVoicesSlider->setRange(0, VoiceLimiter::MaxGlobalVoices / 16);
+	m_maxVoicesSlider->setValue(qBound(0, m_maxVoices / 16,
+			VoiceLimiter::MaxGlobalVoices / 16));
+	m_maxVoicesSlider->setTickInterval(8);
+	m_maxVoicesSlider->setPageStep(4);
+	m_maxVoicesSlider->setGeometry(10, 18, 340, 18);
+	m_maxVoicesSlider->setTickPosition(QSlider::TicksBelow);
+
+	m_maxVoicesLbl = new QLabel(voices_tw);
+	m_maxVoicesLbl->setGeometry(10, 40, 300, 24);
+	setMaxVoices(m_maxVoicesSlider->value());
+
+	connect(m_maxVoicesSlider, SIGNAL(valueChanged(int)),
+			this, SLOT(setMaxVoices(int)));
+
+	m_voiceStealingComboBox = new QComboBox(voices_tw);
+	m_voiceStealingComboBox->setGeometry(10, 68, 160, 22);
+	m_voiceStealingComboBox->addItem(tr("Steal oldest"), VoiceLimiter::StealOldest);
+	m_voiceStealingComboBox->addItem(tr("Steal quietest"), VoiceLimiter::StealQuietest);
+	m_voiceStealingComboBox->addItem(tr("Steal same key"), VoiceLimiter::StealSameKey);
+	m_voiceStealingComboBox->setCurrentIndex(m_voiceStealingComboBox->findData(
+			ConfigManager::inst()->value("audioengine", "voicestealing",
+				QString::number(VoiceLimiter::StealQuietest)).toInt()));
+
+	LedCheckBox * adaptiveVoices = new LedCheckBox(
+			tr("Adapt to CPU load"), voices_tw);
+	adaptiveVoices->move(180, 72);
+	adaptiveVoices->setChecked(m_adaptiveVoices);
+	connect(adaptiveVoices, SIGNAL(toggled(bool)),
+			this, SLOT(toggleAdaptiveVoices(bool)));
+	ToolTip::add(adaptiveVoices,
+			tr("Steal the least audible voices when rendering a period "
+				"takes almost as long as playing it"));
+
+
 	// Audio layout ordering.
 	audio_layout->addWidget(audioiface_tw);
 	audio_layout->addWidget(as_w);
 	audio_layout->addWidget(hqaudio);
 	audio_layout->addWidget(bufferSize_tw);
+	audio_layout->addWidget(voices_tw);
 	audio_layout->addStretch();
 
 
@@ -938,6 +1017,8 @@ void SetupDialog::accept()
 					QString::number(m_enableAutoSave));
 	ConfigManager::inst()->setValue("ui", "enablerunningautosave",
 					QString::number(m_enableRunningAutoSave));
+	ConfigManager::inst()->setValue("app", "undomemory",
+					QString::number(m_undoMemory));
 	ConfigManager::inst()->setValue("ui", "smoothscroll",
 					QString::number(m_smoothScroll));
 	ConfigManager::inst()->setValue("ui", "animateafp",
@@ -950,6 +1031,8 @@ void SetupDialog::accept()
 					QString::number(m_syncVSTPlugins));
 	ConfigManager::inst()->setValue("ui", "disableautoquit",
 					QString::number(m_disableAutoQuit));
+	ConfigManager::inst()->setValue("audioengine", "pipelineremoteplugins",
+					QString::number(m_pipelineRemotePlugins));
 	ConfigManager::inst()->setValue("audioengine", "audiodev",
 					m_audioIfaceNames[m_audioInterfaces->currentText()]);
 	ConfigManager::inst()->setValue("app", "nanhandler",
@@ -958,6 +1041,12 @@ void SetupDialog::accept()
 					QString::number(m_hqAudioDev));
 	ConfigManager::inst()->setValue("audioengine", "framesperaudiobuffer",
 					QString::number(m_bufferSize));
+	ConfigManager::inst()->setValue("audioengine", "maxvoices",
+					QString::number(m_maxVoices));
+	ConfigManager::inst()->setValue("audioengine", "voicestealing",
+					m_voiceStealingComboBox->currentData().toString());
+	ConfigManager::inst()->setValue("audioengine", "adaptivevoices",
+					QString::number(m_adaptiveVoices));
 	ConfigManager::inst()->setValue("audioengine", "mididev",
 					m_midiIfaceNames[m_midiInterfaces->currentText()]);
 	ConfigManager::inst()->setValue("midi", "midiautoassign",
@@ -988,6 +1077,11 @@ void SetupDialog::accept()
 		it.value()->saveSettings();
 	}
 	ConfigManager::inst()->saveConfigFile();
+
+	// The voice limits take effect without a restart.
+	Engine::audioEngine()->requestChangeInModel();
+	Engine::audioEngine()->voiceLimiter().loadSettings();
+	Engine::audioEngine()->doneChangeInModel();
 }
 
 
@@ -1116,6 +1210,15 @@ void SetupDialog::resetAutoSave()
 }
 
 
+void SetupDialog::setUndoMemory(int steps)
+{
+	// the slider moves in steps of 16 MB
+	m_undoMemory = steps * 16;
+	m_undoMemoryLbl->setText(
+		tr("Memory for undo history: %1 MB").arg(m_undoMemory));
+}
+
+
 void SetupDialog::toggleSmoothScroll(bool enabled)
 {
 	m_smoothScroll = enabled;
@@ -1153,6 +1256,12 @@ void SetupDialog::toggleDisableAutoQuit(bool enabled)
 }
 
 
+void SetupDialog::togglePipelineRemotePlugins(bool enabled)
+{
+	m_pipelineRemotePlugins = enabled;
+}
+
+
 
 
 // Audio settings slots.
@@ -1209,6 +1318,22 @@ void SetupDialog::resetBufferSize()
 }
 
 
+void SetupDialog::setMaxVoices(int steps)
+{
+	// the slider moves in steps of 16 voices
+	m_maxVoices = steps * 16;
+	m_maxVoicesLbl->setText(m_maxVoices > 0 ?
+		tr("Maximum voices: %1").arg(m_maxVoices) :
+		tr("Maximum voices: unlimited"));
+}
+
+
+void SetupDialog::toggleAdaptiveVoices(bool enabled)
+{
+	m_adaptiveVoices = enabled;
+}
+
+
 // MIDI settings slots.
 
 void SetupDialog::midiInterfaceChanged(const QString & iface)
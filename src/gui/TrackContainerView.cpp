@@ -75,6 +75,8 @@ TrackContainerView::TrackContainerView( TrackContainer * _tc ) :
 	m_scrollLayout->setSizeConstraint( QLayout::SetMinAndMaxSize );
 
 	m_scrollArea->setWidget( scrollContent );
+	connect( m_scrollArea->verticalScrollBar(), SIGNAL( valueChanged( int ) ),
+			this, SLOT( updateVisibleTracks() ) );
 
 	m_scrollArea->show();
 	m_rubberBand->hide();
@@ -231,18 +233,54 @@ void TrackContainerView::realignTracks()
 	m_scrollArea->widget()->setFixedWidth(width());
 	m_scrollArea->widget()->setFixedHeight(
 				m_scrollArea->widget()->minimumSizeHint().height());
+	// track geometries are needed below to find the visible ones
+	m_scrollLayout->activate();
 
 	for( trackViewList::iterator it = m_trackViews.begin();
 						it != m_trackViews.end(); ++it )
 	{
 		( *it )->show();
-		( *it )->update();
+		// tracks outside of the viewport get updated once they're
+		// scrolled into it
+		if( isInViewport( *it ) )
+		{
+			( *it )->update();
+		}
+		else
+		{
+			( *it )->getTrackContentWidget()->invalidate();
+		}
+	}
+}
+
+
+
+
+void TrackContainerView::updateVisibleTracks()
+{
+	for( TrackView * tv : m_trackViews )
+	{
+		if( tv->getTrackContentWidget()->isInvalid() && isInViewport( tv ) )
+		{
+			tv->update();
+		}
 	}
 }
 
 
 
 
+bool TrackContainerView::isInViewport( const TrackView * _tv ) const
+{
+	const QRect visible( 0, m_scrollArea->verticalScrollBar()->value(),
+				m_scrollArea->viewport()->width(),
+				m_scrollArea->viewport()->height() );
+	return _tv->geometry().intersects( visible );
+}
+
+
+
+
 TrackView * TrackContainerView::createTrackView( Track * _t )
 {
 	//m_tc->addJournalCheckPoint();
@@ -437,6 +475,7 @@ void TrackContainerView::resizeEvent( QResizeEvent * _re )
 {
 	realignTracks();
 	QWidget::resizeEvent( _re );
+	updateVisibleTracks();
 }
 
 
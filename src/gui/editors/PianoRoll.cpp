@@ -211,8 +211,20 @@ PianoRoll::PianoRoll() :
 	m_ghostNoteBorders( true ),
 	m_backgroundShade( 0, 0, 0 ),
 	m_whiteKeyWidth(WHITE_KEY_WIDTH),
-	m_blackKeyWidth(BLACK_KEY_WIDTH)
+	m_blackKeyWidth(BLACK_KEY_WIDTH),
+	m_drawNoteNames(ConfigManager::inst()->value("ui", "printnotelabels").toInt())
 {
+	// reading the config on every paint event is too slow
+	connect(ConfigManager::inst(), &ConfigManager::valueChanged, this,
+		[this](QString cls, QString attr, QString value)
+	{
+		if (cls == "ui" && attr == "printnotelabels")
+		{
+			m_drawNoteNames = value.toInt();
+			update();
+		}
+	});
+
 	// gui names of edit modes
 	m_nemStr.push_back( tr( "Note Velocity" ) );
 	m_nemStr.push_back( tr( "Note Panning" ) );
@@ -2271,11 +2283,11 @@ void PianoRoll::mouseReleaseEvent( QMouseEvent * me )
 			computeSelectedNotes(
 					me->modifiers() & Qt::ShiftModifier );
 		}
-		else if( m_action == ActionMoveNote )
+		else if( m_action == ActionMoveNote || m_action == ActionResizeNote )
 		{
-			// we moved one or more notes so they have to be
-			// moved properly according to new starting-
-			// time in the note-array of pattern
+			// we moved one or more notes (resizing may move their
+			// start too) so they have to be moved properly according
+			// to new starting-time in the note-array of pattern
 			m_pattern->rearrangeAllNotes();
 
 		}
@@ -3004,9 +3016,174 @@ void PianoRoll::dragNotes(int x, int y, bool alt, bool shift, bool ctrl)
 
 
 
+bool PianoRoll::GridCacheKey::operator==(const GridCacheKey& other) const
+{
+	return size == other.size
+		&& devicePixelRatio == other.devicePixelRatio
+		&& position == other.position
+		&& ppb == other.ppb
+		&& zoom == other.zoom
+		&& quantization == other.quantization
+		&& keyLineHeight == other.keyLineHeight
+		&& startKey == other.startKey
+		&& keysVisible == other.keysVisible
+		&& notesEditHeight == other.notesEditHeight
+		&& whiteKeyWidth == other.whiteKeyWidth
+		&& numerator == other.numerator
+		&& denominator == other.denominator
+		&& markedSemiTones == other.markedSemiTones
+		&& colors == other.colors;
+}
+
+
+
+
+void PianoRoll::updateGridCache(int q, int topKey)
+{
+	const MeterModel& timeSig = Engine::getSong()->getTimeSigModel();
+
+	GridCacheKey key;
+	key.size = size();
+	key.devicePixelRatio = devicePixelRatioF();
+	key.position = m_currentPosition;
+	key.ppb = m_ppb;
+	key.zoom = m_zoomingModel.value();
+	key.quantization = q;
+	key.keyLineHeight = m_keyLineHeight;
+	key.startKey = m_startKey;
+	key.keysVisible = m_pianoKeysVisible;
+	key.notesEditHeight = m_notesEditHeight;
+	key.whiteKeyWidth = m_whiteKeyWidth;
+	key.numerator = timeSig.getNumerator();
+	key.denominator = timeSig.getDenominator();
+	key.markedSemiTones = m_markedSemiTones;
+	key.colors = { m_lineColor.rgba(), m_beatLineColor.rgba(),
+		m_barLineColor.rgba(), m_backgroundShade.rgba(),
+		m_markedSemitoneColor.rgba() };
+
+	if (!m_gridCache.isNull() && key == m_gridCacheKey) { return; }
+	m_gridCacheKey = key;
+
+	m_gridCache = QPixmap(size() * key.devicePixelRatio);
+	m_gridCache.setDevicePixelRatio(key.devicePixelRatio);
+	m_gridCache.fill(Qt::transparent);
+	QPainter p(&m_gridCache);
+
+	int x, tick;
+	auto xCoordOfTick = [=](int tick) {
+		return m_whiteKeyWidth + (
+			(tick - m_currentPosition) * m_ppb / TimePos::ticksPerBar()
+		);
+	};
+
+	// draw vertical quantization lines, the keys are drawn over their
+	// left part
+	p.setClipRect(m_whiteKeyWidth + 1, keyAreaTop(), width(), noteEditBottom() - keyAreaTop());
+	p.setPen(m_lineColor);
+	for (tick = m_currentPosition - m_currentPosition % q,
+		x = xCoordOfTick(tick);
+		x <= width();
+		tick += q, x = xCoordOfTick(tick))
+	{
+		p.drawLine(x, keyAreaTop(), x, noteEditBottom());
+	}
+
+	// draw horizontal grid lines
+	p.setClipRect(0, keyAreaTop(), width(), keyAreaBottom() - keyAreaTop());
+	auto drawHorizontalLine = [&](
+		const int key,
+		const int y
+	)
+	{
+		if (key % KeysPerOctave == Key_C) { p.setPen(m_beatLineColor); }
+		else { p.setPen(m_lineColor); }
+		p.drawLine(m_whiteKeyWidth, y, width(), y);
+	};
+	int grid_line_y = keyAreaTop() + m_keyLineHeight - 1;
+	const int lastKey = qMax(0, topKey - m_pianoKeysVisible);
+	for (int key = topKey; key > lastKey; --key)
+	{
+		if (Piano::isWhiteKey(key))
+		{
+			drawHorizontalLine(key, grid_line_y);
+			grid_line_y += m_keyLineHeight;
+		}
+		else
+		{
+			// same steps as for the keys in paintEvent()
+			drawHorizontalLine(key - 1, grid_line_y + m_keyLineHeight);
+			drawHorizontalLine(key, grid_line_y);
+			grid_line_y += m_keyLineHeight + m_keyLineHeight;
+			--key;
+		}
+	}
+
+	// don't draw over keys
+	p.setClipRect(m_whiteKeyWidth, keyAreaTop(), width(), noteEditBottom() - keyAreaTop());
+
+	// draw alternating shading on bars
+	float timeSignature =
+		static_cast<float>(key.numerator) / static_cast<float>(key.denominator);
+	float zoomFactor = m_zoomLevels[m_zoomingModel.value()];
+	//the bars which disappears at the left side by scrolling
+	int leftBars = m_currentPosition * zoomFactor / TimePos::ticksPerBar();
+	//iterates the visible bars and draw the shading on uneven bars
+	for (int x = m_whiteKeyWidth, barCount = leftBars;
+		x < width() + m_currentPosition * zoomFactor / timeSignature;
+		x += m_ppb, ++barCount)
+	{
+		if ((barCount + leftBars) % 2 != 0)
+		{
+			p.fillRect(x - m_currentPosition * zoomFactor / timeSignature,
+				PR_TOP_MARGIN,
+				m_ppb,
+				height() - (PR_BOTTOM_MARGIN + PR_TOP_MARGIN),
+				m_backgroundShade);
+		}
+	}
+
+	// draw vertical beat lines
+	int ticksPerBeat = DefaultTicksPerBar / key.denominator;
+	p.setPen(m_beatLineColor);
+	for(tick = m_currentPosition - m_currentPosition % ticksPerBeat,
+		x = xCoordOfTick( tick );
+		x <= width();
+		tick += ticksPerBeat, x = xCoordOfTick(tick))
+	{
+		p.drawLine(x, PR_TOP_MARGIN, x, noteEditBottom());
+	}
+
+	// draw vertical bar lines
+	p.setPen(m_barLineColor);
+	for(tick = m_currentPosition - m_currentPosition % TimePos::ticksPerBar(),
+		x = xCoordOfTick( tick );
+		x <= width();
+		tick += TimePos::ticksPerBar(), x = xCoordOfTick(tick))
+	{
+		p.drawLine(x, PR_TOP_MARGIN, x, noteEditBottom());
+	}
+
+	// draw marked semitones after the grid
+	for(x = 0; x < m_markedSemiTones.size(); ++x)
+	{
+		const int key_num = m_markedSemiTones.at(x);
+		const int y = keyAreaBottom() + 5 - m_keyLineHeight *
+			(key_num - m_startKey + 1);
+		if(y > keyAreaBottom()) { break; }
+		p.fillRect(m_whiteKeyWidth + 1,
+			y - m_keyLineHeight / 2,
+			width() - 10,
+			m_keyLineHeight + 1,
+			m_markedSemitoneColor);
+	}
+}
+
+
+
+
 void PianoRoll::paintEvent(QPaintEvent * pe )
 {
-	bool drawNoteNames = ConfigManager::inst()->value( "ui", "printnotelabels").toInt();
+	const bool drawNoteNames = m_drawNoteNames;
 
 	QStyleOption opt;
 	opt.initFrom( this );
@@ -3027,12 +3204,14 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 	QRect const boundingRect = fontMetrics.boundingRect(QString("G-1")) + QMargins(0, 0, 1, 0);
 
 	// Order of drawing
-	// - vertical quantization lines
-	// - piano roll + horizontal key lines
-	// - alternating bar colors
-	// - vertical beat lines
-	// - vertical bar lines
-	// - marked semitones
+	// - piano roll
+	// - cached grid (see updateGridCache())
+	//   - vertical quantization lines
+	//   - horizontal key lines
+	//   - alternating bar colors
+	//   - vertical beat lines
+	//   - vertical bar lines
+	//   - marked semitones
 	// - note editing
 	// - notes
 	// - selection frame
@@ -3089,9 +3268,8 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 			// otherwise we add height
 			else { m_notesEditHeight += partialKeyVisible; }
 		}
-		int x, q = quantization(), tick;
+		int q = quantization();
 
-		// draw vertical quantization lines
 		// If we're over 100% zoom, we allow all quantization level grids
 		if (m_zoomingModel.value() <= 3)
 		{
@@ -3101,21 +3279,11 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 			// allow quantization grid up to 1/32 for normal notes
 			else if (q < 6) { q = 6; }
 		}
-		auto xCoordOfTick = [=](int tick) {
-			return m_whiteKeyWidth + (
-				(tick - m_currentPosition) * m_ppb / TimePos::ticksPerBar()
-			);
-		};
-		p.setPen(m_lineColor);
-		for (tick = m_currentPosition - m_currentPosition % q,
-			x = xCoordOfTick(tick);
-			x <= width();
-			tick += q, x = xCoordOfTick(tick))
-		{
-			p.drawLine(x, keyAreaTop(), x, noteEditBottom());
-		}
 
-		// draw horizontal grid lines and piano notes
+		// lines, bar shading and marked semitones don't change that often
+		updateGridCache(q, topKey);
+
+		// draw piano keys
 		p.setClipRect(0, keyAreaTop(), width(), keyAreaBottom() - keyAreaTop());
 		// the first grid line from the top Y position
 		int grid_line_y = keyAreaTop() + m_keyLineHeight - 1;
@@ -3231,16 +3399,6 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 				p.drawText(textRect, Qt::AlignRight | Qt::AlignHCenter, noteString);
 			}
 		};
-		// lambda for drawing the horizontal grid line
-		auto drawHorizontalLine = [&](
-			const int key,
-			const int y
-		)
-		{
-			if (key % KeysPerOctave == Key_C) { p.setPen(m_beatLineColor); }
-			else { p.setPen(m_lineColor); }
-			p.drawLine(m_whiteKeyWidth, y, width(), y);
-		};
 		// correct y offset of the top key
 		switch (prKeyOrder[topNote])
 		{
@@ -3255,88 +3413,27 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 		const int lastKey = qMax(0, topKey - m_pianoKeysVisible);
 		for (int key = topKey; key > lastKey; --key)
 		{
-			bool whiteKey = Piano::isWhiteKey(key);
-			if (whiteKey)
+			if (Piano::isWhiteKey(key))
 			{
 				drawKey(key, grid_line_y);
-				drawHorizontalLine(key, grid_line_y);
 				grid_line_y += m_keyLineHeight;
 			}
 			else
 			{
 				// draw next white key
 				drawKey(key - 1, grid_line_y + m_keyLineHeight);
-				drawHorizontalLine(key - 1, grid_line_y + m_keyLineHeight);
 				// draw black key over previous and next white key
 				drawKey(key, grid_line_y);
-				drawHorizontalLine(key, grid_line_y);
-				// drew two grid keys so skip ahead properly
+				// drew two keys so skip ahead properly
 				grid_line_y += m_keyLineHeight + m_keyLineHeight;
 				// capture double key draw
 				--key;
 			}
 		}
 
-		// don't draw over keys
-		p.setClipRect(m_whiteKeyWidth, keyAreaTop(), width(), noteEditBottom() - keyAreaTop());
-
-		// draw alternating shading on bars
-		float timeSignature =
-			static_cast<float>(Engine::getSong()->getTimeSigModel().getNumerator()) /
-			static_cast<float>(Engine::getSong()->getTimeSigModel().getDenominator());
-		float zoomFactor = m_zoomLevels[m_zoomingModel.value()];
-		//the bars which disappears at the left side by scrolling
-		int leftBars = m_currentPosition * zoomFactor / TimePos::ticksPerBar();
-		//iterates the visible bars and draw the shading on uneven bars
-		for (int x = m_whiteKeyWidth, barCount = leftBars;
-			x < width() + m_currentPosition * zoomFactor / timeSignature;
-			x += m_ppb, ++barCount)
-		{
-			if ((barCount + leftBars) % 2 != 0)
-			{
-				p.fillRect(x - m_currentPosition * zoomFactor / timeSignature,
-					PR_TOP_MARGIN,
-					m_ppb,
-					height() - (PR_BOTTOM_MARGIN + PR_TOP_MARGIN),
-					m_backgroundShade);
-			}
-		}
-
-		// draw vertical beat lines
-		int ticksPerBeat = DefaultTicksPerBar /
-			Engine::getSong()->getTimeSigModel().getDenominator();
-		p.setPen(m_beatLineColor);
-		for(tick = m_currentPosition - m_currentPosition % ticksPerBeat,
-			x = xCoordOfTick( tick );
-			x <= width();
-			tick += ticksPerBeat, x = xCoordOfTick(tick))
-		{
-			p.drawLine(x, PR_TOP_MARGIN, x, noteEditBottom());
-		}
-
-		// draw vertical bar lines
-		p.setPen(m_barLineColor);
-		for(tick = m_currentPosition - m_currentPosition % TimePos::ticksPerBar(),
-			x = xCoordOfTick( tick );
-			x <= width();
-			tick += TimePos::ticksPerBar(), x = xCoordOfTick(tick))
-		{
-			p.drawLine(x, PR_TOP_MARGIN, x, noteEditBottom());
-		}
-
-		// draw marked semitones after the grid
-		for(x = 0; x < m_markedSemiTones.size(); ++x)
-		{
-			const int key_num = m_markedSemiTones.at(x);
-			const int y = keyAreaBottom() + 5 - m_keyLineHeight *
-				(key_num - m_startKey + 1);
-			if(y > keyAreaBottom()) { break; }
-			p.fillRect(m_whiteKeyWidth + 1,
-				y - m_keyLineHeight / 2,
-				width() - 10,
-				m_keyLineHeight + 1,
-				m_markedSemitoneColor);
-		}
+		// the grid is drawn over the right edge of the keys
+		p.setClipRect(0, 0, width(), height());
+		p.drawPixmap(0, 0, m_gridCache);
 	}
 
 	// reset clip
@@ -3445,6 +3542,11 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 		}
 		// -- End ghost pattern
 
+		// notes are sorted by position, except while they are being moved or
+		// resized (rearrangeAllNotes() is called when that is done)
+		const bool notesSorted = m_action != ActionMoveNote
+			&& m_action != ActionResizeNote;
+
 		for( const Note *note : m_pattern->notes() )
 		{
 			int len_ticks = note->length();
@@ -3463,6 +3565,11 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 			int note_width = len_ticks * m_ppb / TimePos::ticksPerBar();
 			const int x = ( pos_ticks - m_currentPosition ) *
 					m_ppb / TimePos::ticksPerBar();
+			// all following notes start right of the visible area
+			if (notesSorted && x > width() - m_whiteKeyWidth)
+			{
+				break;
+			}
 			// skip this note if not in visible area at all
 			if (!(x + note_width >= 0 && x <= width() - m_whiteKeyWidth))
 			{
@@ -4769,8 +4876,7 @@ void PianoRoll::paintGhostNotes(QPainter & p,
 				drawNoteRect(
 					p, x + m_whiteKeyWidth, dr.height()-((note->key()-minKey)*dr.height()/range)-32, note_width,
 					note, m_ghostNoteColor, m_ghostNoteTextColor, m_selectedNoteColor,
-					m_ghostNoteOpacity, m_ghostNoteBorders, 
-					(bool)ConfigManager::inst()->value( "ui", "printnotelabels").toInt());
+					m_ghostNoteOpacity, m_ghostNoteBorders, m_drawNoteNames);
 			//}
 
 		}
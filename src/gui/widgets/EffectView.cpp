@@ -39,6 +39,7 @@
 #include "Knob.h"
 #include "LedCheckbox.h"
 #include "MainWindow.h"
+#include "Oversampler.h"
 #include "TempoSyncKnob.h"
 #include "ToolTip.h"
 
@@ -199,6 +200,21 @@ void EffectView::contextMenuEvent( QContextMenuEvent * )
 						tr( "Move &down" ),
 						this, SLOT( moveDown() ) );
 	contextMenu->addSeparator();
+	if( effect()->supportsOversampling() )
+	{
+		QMenu * oversamplingMenu = contextMenu->addMenu( tr( "&Oversampling" ) );
+		IntModel * model = &effect()->m_oversamplingModel;
+		for( int stages = 0; stages <= Oversampler::MaxStages; ++stages )
+		{
+			QAction * action = oversamplingMenu->addAction(
+						tr( "%1x" ).arg( 1 << stages ) );
+			action->setCheckable( true );
+			action->setChecked( model->value() == stages );
+			connect( action, &QAction::triggered,
+					[model, stages]() { model->setValue( stages ); } );
+		}
+		contextMenu->addSeparator();
+	}
 	contextMenu->addAction( embed::getIconPixmap( "cancel" ),
 						tr( "&Remove this plugin" ),
 						this, SLOT( deletePlugin() ) );
@@ -32,6 +32,7 @@
 #include "GroupBox.h"
 #include "gui_templates.h"
 #include "InstrumentTrack.h"
+#include "LcdSpinBox.h"
 #include "LedCheckbox.h"
 
 
@@ -81,6 +82,29 @@ InstrumentMiscView::InstrumentMiscView(InstrumentTrack *it, QWidget *parent) :
 	m_rangeImportCheckbox->setCheckable(true);
 	microtunerLayout->addWidget(m_rangeImportCheckbox);
 
+	// Polyphony limit
+	m_polyphonyGroupBox = new GroupBox(tr("POLYPHONY"));
+	m_polyphonyGroupBox->setModel(&it->m_limitVoicesModel);
+	layout->addWidget(m_polyphonyGroupBox);
+
+	QGridLayout *polyphonyLayout = new QGridLayout(m_polyphonyGroupBox);
+	polyphonyLayout->setContentsMargins(8, 18, 8, 8);
+
+	QLabel *maxVoicesLabel = new QLabel(tr("Maximum voices:"));
+	polyphonyLayout->addWidget(maxVoicesLabel, 0, 0);
+
+	m_maxVoicesSpinBox = new LcdSpinBox(3, this);
+	m_maxVoicesSpinBox->setModel(&it->m_maxVoicesModel);
+	m_maxVoicesSpinBox->setToolTip(tr("Above this number of notes, the notes chosen by the stealing policy are faded out."));
+	polyphonyLayout->addWidget(m_maxVoicesSpinBox, 0, 1);
+
+	QLabel *stealingLabel = new QLabel(tr("Voice stealing:"));
+	polyphonyLayout->addWidget(stealingLabel, 1, 0, 1, 2);
+
+	m_voiceStealingCombo = new ComboBox();
+	m_voiceStealingCombo->setModel(&it->m_voiceStealingModel);
+	polyphonyLayout->addWidget(m_voiceStealingCombo, 2, 0, 1, 2);
+
 	// Fill remaining space
 	layout->addStretch();
 }
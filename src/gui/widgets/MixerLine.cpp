@@ -293,7 +293,7 @@ void MixerLine::renameFinished()
 	setFocus();
 	if( !newName.isEmpty() && Engine::mixer()->mixerChannel( m_channelIndex )->m_name != newName )
 	{
-		Engine::mixer()->mixerChannel( m_channelIndex )->m_name = newName;
+		Engine::mixer()->renameChannel( m_channelIndex, newName );
 		m_renameLineEdit->setText( elideName( newName ) );
 		Engine::getSong()->setModified();
 	}
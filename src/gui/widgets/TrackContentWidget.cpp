@@ -60,6 +60,7 @@ const int BARS_PER_GROUP = 4;
 TrackContentWidget::TrackContentWidget( TrackView * parent ) :
 	QWidget( parent ),
 	m_trackView( parent ),
+	m_invalid( false ),
 	m_darkerColor( Qt::SolidPattern ),
 	m_lighterColor( Qt::SolidPattern ),
 	m_gridColor( Qt::SolidPattern ),
@@ -183,7 +184,15 @@ void TrackContentWidget::update()
 				it != m_tcoViews.end(); ++it )
 	{
 		( *it )->setFixedHeight( height() - 1 );
-		( *it )->update();
+		// views outside of the visible range get repainted when shown
+		if( ( *it )->isHidden() )
+		{
+			( *it )->setNeedsUpdate( true );
+		}
+		else
+		{
+			( *it )->update();
+		}
 	}
 	QWidget::update();
 }
@@ -234,6 +243,14 @@ void TrackContentWidget::changePosition( const TimePos & newPos )
 		return;
 	}
 
+	// with thousands of TCOs, only the visible tracks are kept up to date
+	if( !m_trackView->trackContainerView()->isInViewport( m_trackView ) )
+	{
+		invalidate();
+		return;
+	}
+	m_invalid = false;
+
 	TimePos pos = newPos;
 	if( pos < 0 )
 	{
@@ -251,14 +268,14 @@ void TrackContentWidget::changePosition( const TimePos & newPos )
 		TrackContentObjectView * tcov = *it;
 		TrackContentObject * tco = tcov->getTrackContentObject();
 
-		tco->changeLength( tco->length() );
-
 		const int ts = tco->startPosition();
 		const int te = tco->endPosition()-3;
 		if( ( ts >= begin && ts <= end ) ||
 			( te >= begin && te <= end ) ||
 			( ts <= begin && te >= end ) )
 		{
+			// the zoom may have changed since the TCO was visible
+			tcov->updateLength();
 			tcov->move( static_cast<int>( ( ts - begin ) * ppb /
 						TimePos::ticksPerBar() ),
 								tcov->y() );
@@ -269,7 +286,9 @@ void TrackContentWidget::changePosition( const TimePos & newPos )
 		}
 		else
 		{
+			// hidden views are skipped by painting and updating
 			tcov->move( -tcov->width()-10, tcov->y() );
+			tcov->hide();
 		}
 	}
 	setUpdatesEnabled( true );
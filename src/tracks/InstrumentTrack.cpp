@@ -36,6 +36,7 @@
 #include "MixHelpers.h"
 #include "Pattern.h"
 #include "Song.h"
+#include "VoiceLimiter.h"
 
 
 InstrumentTrack::InstrumentTrack( TrackContainer* tc ) :
@@ -58,6 +59,9 @@ InstrumentTrack::InstrumentTrack( TrackContainer* tc ) :
 	m_pitchRangeModel( 1, 1, 60, this, tr( "Pitch range" ) ),
 	m_mixerChannelModel( 0, 0, 0, this, tr( "Mixer channel" ) ),
 	m_useMasterPitchModel( true, this, tr( "Master pitch") ),
+	m_limitVoicesModel( false, this, tr( "Limit voices" ) ),
+	m_maxVoicesModel( Instrument::DefaultPolyphony, 1, VoiceLimiter::MaxVoices, this, tr( "Maximum voices" ) ),
+	m_voiceStealingModel( this, tr( "Voice stealing" ) ),
 	m_instrument( nullptr ),
 	m_soundShaping( this ),
 	m_arpeggio( this ),
@@ -71,6 +75,11 @@ InstrumentTrack::InstrumentTrack( TrackContainer* tc ) :
 	m_firstKeyModel.setInitValue(0);
 	m_lastKeyModel.setInitValue(NumKeys - 1);
 
+	// same order as VoiceLimiter::StealPolicy
+	m_voiceStealingModel.addItem( tr( "Oldest" ) );
+	m_voiceStealingModel.addItem( tr( "Quietest" ) );
+	m_voiceStealingModel.addItem( tr( "Same key" ) );
+
 	m_mixerChannelModel.setRange( 0, Engine::mixer()->numChannels()-1, 1);
 
 	for( int i = 0; i < NumKeys; ++i )
@@ -261,13 +270,19 @@ void InstrumentTrack::processAudioBuffer( sampleFrame* buf, const fpp_t frames,
 		const float vol = ( (float) n->getVolume() * DefaultVolumeRatio );
 		const panning_t pan = qBound( PanningLeft, n->getPanning(), PanningRight );
 		stereoVolumeVector vv = panningToVolumeVector( pan, vol );
+		// a stolen voice fades out over the frames of this period
+		const float fadeStep = n->isStolen() ? 1.0f / frames : 0.0f;
+		float peak = 0.0f;
 		for( f_cnt_t f = offset; f < frames; ++f )
 		{
+			const float fade = 1.0f - ( f + 1 ) * fadeStep;
 			for( int c = 0; c < 2; ++c )
 			{
-				buf[f][c] *= vv.vol[c];
+				buf[f][c] *= vv.vol[c] * fade;
+				peak = qMax( peak, qAbs( buf[f][c] ) );
 			}
 		}
+		n->setLevel( peak );
 	}
 }
 
@@ -445,6 +460,10 @@ void InstrumentTrack::processInEvent( const MidiEvent& event, const TimePos& tim
 
 	// If the event wasn't handled, check if there's a loaded instrument and if so send the
 	// event to it. If it returns false means the instrument didn't handle the event, so we trigger a warning.
+	if (eventHandled == false && instrument())
+	{
+		instrument()->wakeUp();
+	}
 	if (eventHandled == false && !(instrument() && instrument()->handleMidiEvent(event, time, offset)))
 	{
 		qWarning("InstrumentTrack: unhandled MIDI event %d", event.type());
@@ -463,6 +482,8 @@ void InstrumentTrack::processOutEvent( const MidiEvent& event, const TimePos& ti
 		return;
 	}
 
+	m_instrument->wakeUp();
+
 	const MidiEvent transposedEvent = applyMasterKey( event );
 	const int key = transposedEvent.key();
 
@@ -813,6 +834,9 @@ void InstrumentTrack::saveTrackSpecificSettings( QDomDocument& doc, QDomElement
 	m_firstKeyModel.saveSettings(doc, thisElement, "firstkey");
 	m_lastKeyModel.saveSettings(doc, thisElement, "lastkey");
 	m_useMasterPitchModel.saveSettings( doc, thisElement, "usemasterpitch");
+	m_limitVoicesModel.saveSettings( doc, thisElement, "limitvoices" );
+	m_maxVoicesModel.saveSettings( doc, thisElement, "maxvoices" );
+	m_voiceStealingModel.saveSettings( doc, thisElement, "voicestealing" );
 	m_microtuner.saveSettings(doc, thisElement);
 
 	// Save MIDI CC stuff
@@ -880,6 +904,9 @@ void InstrumentTrack::loadTrackSpecificSettings( const QDomElement & thisElement
 	m_firstKeyModel.loadSettings(thisElement, "firstkey");
 	m_lastKeyModel.loadSettings(thisElement, "lastkey");
 	m_useMasterPitchModel.loadSettings( thisElement, "usemasterpitch");
+	m_limitVoicesModel.loadSettings( thisElement, "limitvoices" );
+	m_maxVoicesModel.loadSettings( thisElement, "maxvoices" );
+	m_voiceStealingModel.loadSettings( thisElement, "voicestealing" );
 	m_microtuner.loadSettings(thisElement);
 
 	// clear effect-chain just in case we load an old preset without FX-data
@@ -39,7 +39,9 @@ SampleTrack::SampleTrack(TrackContainer* tc) :
 	m_volumeModel(DefaultVolume, MinVolume, MaxVolume, 0.1f, this, tr("Volume")),
 	m_panningModel(DefaultPanning, PanningLeft, PanningRight, 0.1f, this, tr("Panning")),
 	m_mixerChannelModel(0, 0, 0, this, tr("Mixer channel")),
-	m_audioPort(tr("Sample track"), true, &m_volumeModel, &m_panningModel, &m_mutedModel),
+	m_monitorModel(false, this, tr("Monitor input")),
+	m_audioPort(tr("Sample track"), true, &m_volumeModel, &m_panningModel, &m_mutedModel,
+		&m_monitorModel),
 	m_isPlaying(false)
 {
 	setName(tr("Sample track"));
@@ -224,6 +226,7 @@ void SampleTrack::saveTrackSpecificSettings( QDomDocument & _doc,
 	m_volumeModel.saveSettings( _doc, _this, "vol" );
 	m_panningModel.saveSettings( _doc, _this, "pan" );
 	m_mixerChannelModel.saveSettings( _doc, _this, "mixch" );
+	m_monitorModel.saveSettings( _doc, _this, "monitor" );
 }
 
 
@@ -248,6 +251,7 @@ void SampleTrack::loadTrackSpecificSettings( const QDomElement & _this )
 	m_panningModel.loadSettings( _this, "pan" );
 	m_mixerChannelModel.setRange( 0, Engine::mixer()->numChannels() - 1 );
 	m_mixerChannelModel.loadSettings( _this, "mixch" );
+	m_monitorModel.loadSettings( _this, "monitor" );
 }
 
 
@@ -0,0 +1,241 @@
+/*
+ * Benchmark.cpp - base class of the headless engine benchmarks
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "lmmsconfig.h"
+
+#ifdef LMMS_BUILD_WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "AudioEngine.h"
+#include "AutomationPattern.h"
+#include "AutomationTrack.h"
+#include "Engine.h"
+#include "InstrumentTrack.h"
+#include "Pattern.h"
+#include "PluginFactory.h"
+#include "Song.h"
+
+
+//! Highest resident set size of the process so far, in KiB
+static qint64 peakRss()
+{
+#ifdef LMMS_BUILD_WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		return counters.PeakWorkingSetSize / 1024;
+	}
+	return 0;
+#else
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#ifdef LMMS_BUILD_APPLE
+	// bytes on macOS, KiB everywhere else
+	return usage.ru_maxrss / 1024;
+#else
+	return usage.ru_maxrss;
+#endif
+#endif
+}
+
+
+
+
+Benchmark::Benchmark(const QString& name) :
+	m_name(name)
+{
+	registry() << this;
+}
+
+
+
+
+QList<Benchmark*> Benchmark::benchmarks()
+{
+	return registry();
+}
+
+
+
+
+QList<Benchmark*>& Benchmark::registry()
+{
+	// not a static member, the benchmarks register themselves during static
+	// initialization
+	static QList<Benchmark*> benchmarks;
+	return benchmarks;
+}
+
+
+
+
+QJsonObject Benchmark::run(const BenchmarkOptions& options)
+{
+	using Clock = std::chrono::steady_clock;
+	using std::chrono::nanoseconds;
+
+	Song* song = Engine::getSong();
+	AudioEngine* audioEngine = Engine::audioEngine();
+
+	song->clearProject();
+	m_results = QJsonObject();
+
+	const auto setUpStart = Clock::now();
+	if (!setUp(options))
+	{
+		song->clearProject();
+		return QJsonObject();
+	}
+	const auto setUpTime = Clock::now() - setUpStart;
+
+	for (int i = 0; i < options.warmUp; ++i)
+	{
+		audioEngine->nextBuffer();
+	}
+
+	std::vector<qint64> periods;
+	periods.reserve(options.periods);
+	const auto start = Clock::now();
+	for (int i = 0; i < options.periods; ++i)
+	{
+		const auto periodStart = Clock::now();
+		audioEngine->nextBuffer();
+		periods.push_back(std::chrono::duration_cast<nanoseconds>(Clock::now() - periodStart).count());
+	}
+	const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	song->clearProject();
+
+	std::sort(periods.begin(), periods.end());
+	const auto percentile = [&periods](double p)
+	{
+		const size_t index = std::min(periods.size() - 1, static_cast<size_t>(p * periods.size()));
+		return periods[index] / 1000.0;
+	};
+	double sum = 0;
+	for (qint64 period : periods) { sum += period; }
+
+	const fpp_t framesPerPeriod = audioEngine->framesPerPeriod();
+	const sample_rate_t sampleRate = audioEngine->processingSampleRate();
+	const double audioSeconds = static_cast<double>(options.periods) * framesPerPeriod / sampleRate;
+
+	QJsonObject periodTimes;
+	periodTimes["p50"] = percentile(0.5);
+	periodTimes["p99"] = percentile(0.99);
+	periodTimes["max"] = periods.back() / 1000.0;
+	periodTimes["mean"] = sum / periods.size() / 1000.0;
+	periodTimes["deadline"] = 1e6 * framesPerPeriod / sampleRate;
+
+	QJsonObject result = m_results;
+	result["name"] = m_name;
+	result["periods"] = options.periods;
+	result["frames_per_period"] = framesPerPeriod;
+	result["sample_rate"] = static_cast<int>(sampleRate);
+	result["setup_ms"] = std::chrono::duration<double, std::milli>(setUpTime).count();
+	result["period_us"] = periodTimes;
+	result["realtime_factor"] = audioSeconds / seconds;
+	result["peak_rss_kib"] = peakRss();
+	return result;
+}
+
+
+
+
+void Benchmark::addResult(const QString& key, double value)
+{
+	m_results[key] = value;
+}
+
+
+
+
+tick_t Benchmark::songLength(const BenchmarkOptions& options)
+{
+	const f_cnt_t frames = static_cast<f_cnt_t>(options.warmUp + options.periods)
+			* Engine::audioEngine()->framesPerPeriod();
+	return static_cast<tick_t>(frames / Engine::framesPerTick()) + TimePos::ticksPerBar();
+}
+
+
+
+
+bool Benchmark::hasPlugin(const char* name)
+{
+	return !getPluginFactory()->pluginInfo(name).isNull();
+}
+
+
+
+
+InstrumentTrack* Benchmark::addInstrumentTrack(const char* instrument)
+{
+	auto track = dynamic_cast<InstrumentTrack*>(Track::create(Track::InstrumentTrack, Engine::getSong()));
+	track->loadInstrument(instrument);
+	return track;
+}
+
+
+
+
+void Benchmark::addNotes(InstrumentTrack* track, tick_t length, int seed)
+{
+	const tick_t step = TimePos::ticksPerBar() / 16;
+	auto pattern = dynamic_cast<Pattern*>(track->createTCO(0));
+	for (tick_t pos = 0; pos < length; pos += step)
+	{
+		const int root = 36 + (pos / step * 5 + seed * 7) % 36;
+		for (int interval : {0, 4, 7})
+		{
+			pattern->addNote(Note(step - 2, pos, root + interval), false);
+		}
+	}
+}
+
+
+
+
+void Benchmark::addAutomation(AutomatableModel* model, tick_t length, int seed)
+{
+	auto track = dynamic_cast<AutomationTrack*>(Track::create(Track::AutomationTrack, Engine::getSong()));
+	auto pattern = dynamic_cast<AutomationPattern*>(track->createTCO(0));
+	pattern->setProgressionType(AutomationPattern::LinearProgression);
+	pattern->addObject(model);
+
+	const float min = model->minValue<float>();
+	const float range = model->maxValue<float>() - min;
+	for (tick_t tick = 0; tick < length; ++tick)
+	{
+		const float phase = 0.05f * tick + seed;
+		pattern->putValue(tick, min + range * (0.5f + 0.4f * std::sin(phase)), false);
+	}
+}
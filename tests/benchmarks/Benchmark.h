@@ -0,0 +1,97 @@
+/*
+ * Benchmark.h - base class of the headless engine benchmarks
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+#include "lmms_basics.h"
+
+class AutomatableModel;
+class InstrumentTrack;
+
+
+//! Size of the generated scenarios, set on the command line
+struct BenchmarkOptions
+{
+	int periods = 2000;	//!< measured periods per scenario
+	int warmUp = 50;	//!< periods rendered before measuring
+	int voices = 64;	//!< notes held in the voices scenario
+	int channels = 32;	//!< mixer channels in the mixer scenario
+	int tracks = 16;	//!< tracks in the other scenarios
+};
+
+
+/**
+	A generated stress scenario, rendered without GUI and audio device
+
+	Subclasses build their project in setUp() and register themselves by
+	defining a global instance, like the test suites do. run() renders the
+	project through AudioEngine::renderNextBuffer() and reports the
+	distribution of the time each period took, the throughput in multiples
+	of real time and the peak memory usage.
+*/
+class Benchmark
+{
+public:
+	explicit Benchmark(const QString& name);
+	virtual ~Benchmark() = default;
+
+	static QList<Benchmark*> benchmarks();
+
+	const QString& name() const
+	{
+		return m_name;
+	}
+
+	//! Render the scenario, the result is empty if it was skipped
+	QJsonObject run(const BenchmarkOptions& options);
+
+protected:
+	//! Build the project in the empty song and start playing it if needed,
+	//! return false to skip the scenario, e.g. if a plugin is missing
+	virtual bool setUp(const BenchmarkOptions& options) = 0;
+
+	//! Add a value to the results, e.g. the time of loading a project
+	void addResult(const QString& key, double value);
+
+	//! Length of a song that lasts until the end of the run
+	static tick_t songLength(const BenchmarkOptions& options);
+
+	static bool hasPlugin(const char* name);
+	static InstrumentTrack* addInstrumentTrack(const char* instrument);
+	//! Fill the song with chords of 16th notes, different for each @p seed
+	static void addNotes(InstrumentTrack* track, tick_t length, int seed);
+	//! Automate @p model with a new value on every tick
+	static void addAutomation(AutomatableModel* model, tick_t length, int seed);
+
+private:
+	static QList<Benchmark*>& registry();
+
+	QString m_name;
+	QJsonObject m_results;
+} ;
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * main.cpp - runs the headless engine benchmarks and prints their results
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "Benchmark.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTextStream>
+
+#include "lmmsversion.h"
+
+#include "AudioDevice.h"
+#include "AudioEngine.h"
+#include "denormals.h"
+#include "Engine.h"
+
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("benchmarks");
+
+	BenchmarkOptions options;
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Renders generated projects without GUI "
+		"and audio device and prints the time per period as JSON.");
+	parser.addHelpOption();
+	const QCommandLineOption periodsOption("periods", "Measured periods per scenario.",
+		"count", QString::number(options.periods));
+	const QCommandLineOption warmUpOption("warmup", "Periods rendered before measuring.",
+		"count", QString::number(options.warmUp));
+	const QCommandLineOption voicesOption("voices", "Notes held in the voices scenario.",
+		"count", QString::number(options.voices));
+	const QCommandLineOption channelsOption("channels", "Mixer channels in the mixer scenario.",
+		"count", QString::number(options.channels));
+	const QCommandLineOption tracksOption("tracks", "Tracks in the other scenarios.",
+		"count", QString::number(options.tracks));
+	const QCommandLineOption filterOption("filter", "Only run the scenarios with this name.",
+		"name");
+	const QCommandLineOption outputOption("output", "Write the results to this file "
+		"instead of the standard output.", "file");
+	const QCommandLineOption listOption("list", "List the scenarios and exit.");
+	parser.addOptions({periodsOption, warmUpOption, voicesOption, channelsOption,
+		tracksOption, filterOption, outputOption, listOption});
+	parser.process(app);
+
+	if (parser.isSet(listOption))
+	{
+		QTextStream out(stdout);
+		for (const Benchmark* benchmark : Benchmark::benchmarks())
+		{
+			out << benchmark->name() << "\n";
+		}
+		return EXIT_SUCCESS;
+	}
+
+	options.periods = qMax(1, parser.value(periodsOption).toInt());
+	options.warmUp = qMax(0, parser.value(warmUpOption).toInt());
+	options.voices = qMax(0, parser.value(voicesOption).toInt());
+	options.channels = qMax(0, parser.value(channelsOption).toInt());
+	options.tracks = qMax(0, parser.value(tracksOption).toInt());
+	const QStringList filter = parser.values(filterOption);
+
+	// the periods are rendered on this thread, like the audio device would
+	disable_denormals();
+	Engine::init(true);
+
+	// a device without a thread of its own, so nothing renders but us
+	AudioEngine* audioEngine = Engine::audioEngine();
+	audioEngine->setAudioDevice(new AudioDevice(DEFAULT_CHANNELS, audioEngine),
+		audioEngine->currentQualitySettings(), false, false);
+
+	QJsonArray results;
+	for (Benchmark* benchmark : Benchmark::benchmarks())
+	{
+		if (!filter.isEmpty() && !filter.contains(benchmark->name()))
+		{
+			continue;
+		}
+		const QJsonObject result = benchmark->run(options);
+		if (result.isEmpty())
+		{
+			qWarning("Skipped %s", qUtf8Printable(benchmark->name()));
+			continue;
+		}
+		results.append(result);
+	}
+
+	Engine::destroy();
+
+	QJsonObject report;
+	report["version"] = LMMS_VERSION;
+	report["benchmarks"] = results;
+	const QByteArray json = QJsonDocument(report).toJson();
+
+	if (parser.isSet(outputOption))
+	{
+		QFile file(parser.value(outputOption));
+		if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size())
+		{
+			qCritical("Could not write %s", qUtf8Printable(file.fileName()));
+			return EXIT_FAILURE;
+		}
+	}
+	else
+	{
+		QTextStream(stdout) << json;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,188 @@
+/*
+ * ProjectBenchmarks.cpp - scenarios importing, saving and loading projects
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "Benchmark.h"
+
+#include <chrono>
+
+#include <QByteArray>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include "Engine.h"
+#include "ImportFilter.h"
+#include "InstrumentTrack.h"
+#include "Song.h"
+#include "TimePos.h"
+
+
+using Clock = std::chrono::steady_clock;
+
+static double millisecondsSince(Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+
+
+
+//! Imports a generated Standard MIDI File with dense chords on every channel
+class MidiImportBenchmark : public Benchmark
+{
+public:
+	MidiImportBenchmark() : Benchmark("midi_import") {}
+
+protected:
+	bool setUp(const BenchmarkOptions& options) override
+	{
+		QTemporaryDir dir;
+		if (!hasPlugin("midiimport") || !dir.isValid()) { return false; }
+
+		// one MIDI tick per LMMS tick, a chord on every 32nd note
+		const int ticksPerQuarter = TimePos::ticksPerBar() / 4;
+		const int step = ticksPerQuarter / 8;
+		const int steps = songLength(options) / step;
+		const int tracks = qBound(1, options.tracks, 16);
+
+		QByteArray smf("MThd");
+		appendBigEndian(smf, 6, 4);
+		appendBigEndian(smf, 1, 2);	// format 1: simultaneous tracks
+		appendBigEndian(smf, tracks, 2);
+		appendBigEndian(smf, ticksPerQuarter, 2);
+		for (int channel = 0; channel < tracks; ++channel)
+		{
+			appendTrack(smf, channel, steps, step);
+		}
+
+		const QString fileName = dir.filePath("benchmark.mid");
+		QFile file(fileName);
+		if (!file.open(QIODevice::WriteOnly) || file.write(smf) != smf.size()) { return false; }
+		file.close();
+
+		const auto start = Clock::now();
+		ImportFilter::import(fileName, Engine::getSong());
+		addResult("import_ms", millisecondsSince(start));
+		addResult("midi_bytes", smf.size());
+
+		Engine::getSong()->playSong();
+		return true;
+	}
+
+private:
+	static void appendBigEndian(QByteArray& out, quint32 value, int bytes)
+	{
+		while (bytes-- > 0)
+		{
+			out.append(static_cast<char>((value >> (8 * bytes)) & 0xff));
+		}
+	}
+
+	static void appendVariableLength(QByteArray& out, quint32 value)
+	{
+		char groups[5];
+		int count = 0;
+		do
+		{
+			groups[count++] = value & 0x7f;
+			value >>= 7;
+		}
+		while (value);
+		// the most significant group comes first, all but the last one
+		// have the continuation bit set
+		while (count-- > 0)
+		{
+			out.append(static_cast<char>(groups[count] | (count > 0 ? 0x80 : 0)));
+		}
+	}
+
+	static void appendTrack(QByteArray& smf, int channel, int steps, int step)
+	{
+		QByteArray events;
+		for (int s = 0; s < steps; ++s)
+		{
+			const int root = 36 + (s * 5 + channel * 7) % 36;
+			const int keys[] = {root, root + 4, root + 7, root + 12};
+			for (int key : keys)
+			{
+				// the chord starts right after the previous one ends
+				appendVariableLength(events, key == root && s > 0 ? 1 : 0);
+				events.append(static_cast<char>(0x90 | channel));
+				events.append(static_cast<char>(key));
+				events.append(static_cast<char>(100));
+			}
+			for (int key : keys)
+			{
+				appendVariableLength(events, key == root ? step - 1 : 0);
+				events.append(static_cast<char>(0x80 | channel));
+				events.append(static_cast<char>(key));
+				events.append(static_cast<char>(0));
+			}
+		}
+		// end of track
+		events.append("\x00\xff\x2f\x00", 4);
+
+		smf.append("MTrk");
+		appendBigEndian(smf, events.size(), 4);
+		smf.append(events);
+	}
+} MidiImportBenchmarkInstance;
+
+
+
+
+//! Saves and loads a project with automated tracks, then plays it
+class ProjectLoadSaveBenchmark : public Benchmark
+{
+public:
+	ProjectLoadSaveBenchmark() : Benchmark("project_load_save") {}
+
+protected:
+	bool setUp(const BenchmarkOptions& options) override
+	{
+		QTemporaryDir dir;
+		if (!hasPlugin("tripleoscillator") || !dir.isValid()) { return false; }
+
+		const tick_t length = songLength(options);
+		for (int i = 0; i < options.tracks; ++i)
+		{
+			InstrumentTrack* track = addInstrumentTrack("tripleoscillator");
+			addNotes(track, length, i);
+			addAutomation(track->volumeModel(), length, i);
+		}
+
+		Song* song = Engine::getSong();
+		const QString fileName = dir.filePath("benchmark.mmp");
+		auto start = Clock::now();
+		if (!song->saveProjectFile(fileName)) { return false; }
+		addResult("save_ms", millisecondsSince(start));
+		addResult("project_bytes", QFileInfo(fileName).size());
+
+		song->clearProject();
+		start = Clock::now();
+		song->loadProject(fileName);
+		addResult("load_ms", millisecondsSince(start));
+
+		song->playSong();
+		return true;
+	}
+} ProjectLoadSaveBenchmarkInstance;
@@ -0,0 +1,174 @@
+/*
+ * SynthesisBenchmarks.cpp - scenarios stressing voices, mixer and playback
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "Benchmark.h"
+
+#include <cmath>
+#include <memory>
+
+#include "AudioEngine.h"
+#include "Effect.h"
+#include "Engine.h"
+#include "InstrumentTrack.h"
+#include "lmms_constants.h"
+#include "Mixer.h"
+#include "SampleBuffer.h"
+#include "SampleTCO.h"
+#include "SampleTrack.h"
+#include "Song.h"
+
+
+//! Holds TripleOscillator notes, without playing the song
+class VoicesBenchmark : public Benchmark
+{
+public:
+	VoicesBenchmark() : Benchmark("voices") {}
+
+protected:
+	bool setUp(const BenchmarkOptions& options) override
+	{
+		if (!hasPlugin("tripleoscillator")) { return false; }
+
+		// a track holds each key only once
+		const int keysPerTrack = 64;
+		InstrumentTrack* track = nullptr;
+		for (int voice = 0; voice < options.voices; ++voice)
+		{
+			if (voice % keysPerTrack == 0)
+			{
+				track = addInstrumentTrack("tripleoscillator");
+			}
+			const int key = 30 + voice % keysPerTrack;
+			track->processInEvent(MidiEvent(MidiNoteOn, 0, key, 100));
+		}
+		return true;
+	}
+} VoicesBenchmarkInstance;
+
+
+
+
+//! Sources feeding chains of mixer channels, each with an effect
+class MixerBenchmark : public Benchmark
+{
+public:
+	MixerBenchmark() : Benchmark("mixer") {}
+
+protected:
+	bool setUp(const BenchmarkOptions& options) override
+	{
+		if (!hasPlugin("tripleoscillator")) { return false; }
+
+		const int chainLength = 4;
+		Mixer* mixer = Engine::mixer();
+		for (int i = 0; i < options.channels; ++i)
+		{
+			const int channel = mixer->createChannel();
+			if (hasPlugin("amplifier"))
+			{
+				EffectChain* chain = &mixer->mixerChannel(channel)->m_fxChain;
+				chain->appendEffect(Effect::instantiate("amplifier", chain, nullptr));
+			}
+			// every channel but the last of a chain sends to the next one
+			if (i % chainLength != 0)
+			{
+				mixer->deleteChannelSend(channel - 1, 0);
+				mixer->createChannelSend(channel - 1, channel, 0.8f);
+			}
+		}
+
+		// one source at the start of each chain
+		for (int first = 1; first <= options.channels; first += chainLength)
+		{
+			InstrumentTrack* track = addInstrumentTrack("tripleoscillator");
+			track->mixerChannelModel()->setValue(first);
+			for (int key : {48, 52, 55})
+			{
+				track->processInEvent(MidiEvent(MidiNoteOn, 0, key + first % 12, 100));
+			}
+		}
+		return true;
+	}
+} MixerBenchmarkInstance;
+
+
+
+
+//! Plays notes with the volume, panning and pitch of each track automated
+class AutomationBenchmark : public Benchmark
+{
+public:
+	AutomationBenchmark() : Benchmark("automation") {}
+
+protected:
+	bool setUp(const BenchmarkOptions& options) override
+	{
+		if (!hasPlugin("tripleoscillator")) { return false; }
+
+		const tick_t length = songLength(options);
+		for (int i = 0; i < options.tracks; ++i)
+		{
+			InstrumentTrack* track = addInstrumentTrack("tripleoscillator");
+			addNotes(track, length, i);
+			addAutomation(track->volumeModel(), length, i);
+			addAutomation(track->panningModel(), length, i + 1);
+			addAutomation(track->pitchModel(), length, i + 2);
+		}
+		Engine::getSong()->playSong();
+		return true;
+	}
+} AutomationBenchmarkInstance;
+
+
+
+
+//! Plays generated samples as long as the song on several tracks
+class SampleTracksBenchmark : public Benchmark
+{
+public:
+	SampleTracksBenchmark() : Benchmark("sample_tracks") {}
+
+protected:
+	bool setUp(const BenchmarkOptions& options) override
+	{
+		const f_cnt_t frames = static_cast<f_cnt_t>(songLength(options) * Engine::framesPerTick());
+		const float sampleRate = Engine::audioEngine()->processingSampleRate();
+		std::unique_ptr<sampleFrame[]> data(new sampleFrame[frames]);
+
+		for (int i = 0; i < options.tracks; ++i)
+		{
+			const float frequency = 110.0f * (i + 1);
+			for (f_cnt_t f = 0; f < frames; ++f)
+			{
+				const float s = 0.2f * std::sin(D_2PI * frequency * f / sampleRate);
+				data[f][0] = s;
+				data[f][1] = -s;
+			}
+
+			auto track = dynamic_cast<SampleTrack*>(Track::create(Track::SampleTrack, Engine::getSong()));
+			auto tco = dynamic_cast<SampleTCO*>(track->createTCO(0));
+			tco->setSampleBuffer(new SampleBuffer(data.get(), frames));
+		}
+		Engine::getSong()->playSong();
+		return true;
+	}
+} SampleTracksBenchmarkInstance;
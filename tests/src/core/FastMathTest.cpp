@@ -0,0 +1,279 @@
+/*
+ * FastMathTest.cpp
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "QTestSuite.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include "FastMath.h"
+
+class FastMathTest : QTestSuite
+{
+	Q_OBJECT
+private:
+	static constexpr int Points = 200000;
+	static constexpr int BlockSize = 256;
+
+	//! Largest error of @p fast compared to @p exact on [@p from, @p to],
+	//! divided by the documented bound
+	static double worstError( const std::function<float( float )> & fast,
+				const std::function<double( double )> & exact,
+				const std::function<double( double, double )> & bound,
+				double from, double to, bool logSpaced = false )
+	{
+		double worst = 0.0;
+		for( int i = 0; i <= Points; ++i )
+		{
+			const double t = static_cast<double>( i ) / Points;
+			const float x = static_cast<float>( logSpaced
+					? from * std::pow( to / from, t )
+					: from + ( to - from ) * t );
+			const double ref = exact( x );
+			const double error = std::abs( fast( x ) - ref );
+			worst = std::max( worst, error / bound( x, ref ) );
+		}
+		return worst;
+	}
+
+	//! Same as worstError(), but on the @p steps floats around each
+	//! @p peak + k * pi in [@p from, @p to], where the error of a sine peaks
+	static double worstErrorAtPeaks( const std::function<float( float )> & fast,
+				const std::function<double( double )> & exact,
+				double bound, double peak, double from, double to, int steps = 64 )
+	{
+		double worst = 0.0;
+		for( double k = std::ceil( ( from - peak ) / M_PI );
+			k * M_PI + peak <= to; k += 1.0 )
+		{
+			float x = static_cast<float>( k * M_PI + peak );
+			for( int i = 0; i < steps / 2; ++i )
+			{
+				x = std::nextafter( x, -INFINITY );
+			}
+			for( int i = 0; i < steps; ++i )
+			{
+				worst = std::max( worst, std::abs( fast( x ) - exact( x ) ) / bound );
+				x = std::nextafter( x, INFINITY );
+			}
+		}
+		return worst;
+	}
+
+	static std::vector<float> ramp( float from, float to )
+	{
+		std::vector<float> v( BlockSize );
+		for( int i = 0; i < BlockSize; ++i )
+		{
+			v[i] = from + ( to - from ) * i / BlockSize;
+		}
+		return v;
+	}
+
+private slots:
+	void Exp2Test()
+	{
+		QVERIFY( worstError( fastExp2f,
+			[]( double x ) { return std::exp2( x ); },
+			[]( double, double ref ) { return 3e-7 * ref; },
+			-126.0, 127.0 ) < 1.0 );
+		QCOMPARE( fastExp2f( 0.0f ), 1.0f );
+		QCOMPARE( fastExp2f( 1000.0f ), std::ldexp( 1.0f, 127 ) );
+		QCOMPARE( fastExp2f( -1000.0f ), std::ldexp( 1.0f, -126 ) );
+	}
+
+	void ExpTest()
+	{
+		QVERIFY( worstError( fastExpf,
+			[]( double x ) { return std::exp( x ); },
+			[]( double x, double ref ) { return ( 3e-7 + 1e-7 * std::abs( x ) ) * ref; },
+			-87.0, 87.0 ) < 1.0 );
+	}
+
+	void Log2Test()
+	{
+		QVERIFY( worstError( fastLog2f,
+			[]( double x ) { return std::log2( x ); },
+			[]( double, double ref ) { return 2e-7 * std::max( 1.0, std::abs( ref ) ); },
+			1e-37, 1e37, true ) < 1.0 );
+		QCOMPARE( fastLog2f( 1.0f ), 0.0f );
+		QCOMPARE( fastLog2f( 1024.0f ), 10.0f );
+	}
+
+	void SinCosTest()
+	{
+		QVERIFY( worstError( fastSinf,
+			[]( double x ) { return std::sin( x ); },
+			[]( double, double ) { return 2.5e-7; },
+			-1e4, 1e4 ) < 1.0 );
+		QVERIFY( worstErrorAtPeaks( fastSinf,
+			[]( double x ) { return std::sin( x ); }, 2.5e-7, M_PI / 2, -1e4, 1e4 ) < 1.0 );
+		QVERIFY( worstError( fastCosf,
+			[]( double x ) { return std::cos( x ); },
+			[]( double, double ) { return 3e-7; },
+			-1e4, 1e4 ) < 1.0 );
+		QVERIFY( worstErrorAtPeaks( fastCosf,
+			[]( double x ) { return std::cos( x ); }, 3e-7, 0.0, -1e4, 1e4 ) < 1.0 );
+		QCOMPARE( fastSinf( 0.0f ), 0.0f );
+		QCOMPARE( fastCosf( 0.0f ), 1.0f );
+	}
+
+	void TanhTest()
+	{
+		QVERIFY( worstError( fastTanhf,
+			[]( double x ) { return std::tanh( x ); },
+			[]( double, double ) { return 3e-7; },
+			-20.0, 20.0 ) < 1.0 );
+		QCOMPARE( fastTanhf( 0.0f ), 0.0f );
+		QCOMPARE( fastTanhf( INFINITY ), 1.0f );
+		QCOMPARE( fastTanhf( -INFINITY ), -1.0f );
+	}
+
+	void DbfsTest()
+	{
+		QVERIFY( worstError( fastDbfsToAmp,
+			[]( double x ) { return std::pow( 10.0, x * 0.05 ); },
+			[]( double x, double ref ) { return ( 3e-7 + 1e-8 * std::abs( x ) ) * ref; },
+			-750.0, 100.0 ) < 1.0 );
+		QVERIFY( worstError( fastAmpToDbfs,
+			[]( double x ) { return 20.0 * std::log10( x ); },
+			[]( double, double ref ) { return 2e-7 * std::max( 6.0, std::abs( ref ) ); },
+			1e-37, 1e37, true ) < 1.0 );
+	}
+
+	void BlockTest()
+	{
+		// the block variants must give the same results as the scalar ones
+		const std::vector<float> in = ramp( -10.0f, 10.0f );
+		std::vector<float> out( BlockSize );
+		fastSinfBlock( in.data(), out.data(), BlockSize );
+		for( int i = 0; i < BlockSize; ++i )
+		{
+			QCOMPARE( out[i], fastSinf( in[i] ) );
+		}
+		fastTanhfBlock( in.data(), out.data(), BlockSize );
+		for( int i = 0; i < BlockSize; ++i )
+		{
+			QCOMPARE( out[i], fastTanhf( in[i] ) );
+		}
+	}
+
+	// benchmarks of one block, run with "tests -tickcounter" to compare
+	// them with the libm functions below
+
+	void Exp2Benchmark()
+	{
+		const std::vector<float> in = ramp( -10.0f, 10.0f );
+		std::vector<float> out( BlockSize );
+		QBENCHMARK { fastExp2fBlock( in.data(), out.data(), BlockSize ); }
+	}
+
+	void Exp2LibmBenchmark()
+	{
+		const std::vector<float> in = ramp( -10.0f, 10.0f );
+		std::vector<float> out( BlockSize );
+		QBENCHMARK
+		{
+			for( int i = 0; i < BlockSize; ++i ) { out[i] = std::exp2( in[i] ); }
+		}
+	}
+
+	void ExpBenchmark()
+	{
+		const std::vector<float> in = ramp( -10.0f, 10.0f );
+		std::vector<float> out( BlockSize );
+		QBENCHMARK { fastExpfBlock( in.data(), out.data(), BlockSize ); }
+	}
+
+	void Log2Benchmark()
+	{
+		const std::vector<float> in = ramp( 0.001f, 10.0f );
+		std::vector<float> out( BlockSize );
+		QBENCHMARK { fastLog2fBlock( in.data(), out.data(), BlockSize ); }
+	}
+
+	void Log2LibmBenchmark()
+	{
+		const std::vector<float> in = ramp( 0.001f, 10.0f );
+		std::vector<float> out( BlockSize );
+		QBENCHMARK
+		{
+			for( int i = 0; i < BlockSize; ++i ) { out[i] = std::log2( in[i] ); }
+		}
+	}
+
+	void SinBenchmark()
+	{
+		const std::vector<float> in = ramp( -10.0f, 10.0f );
+		std::vector<float> out( BlockSize );
+		QBENCHMARK { fastSinfBlock( in.data(), out.data(), BlockSize ); }
+	}
+
+	void SinLibmBenchmark()
+	{
+		const std::vector<float> in = ramp( -10.0f, 10.0f );
+		std::vector<float> out( BlockSize );
+		QBENCHMARK
+		{
+			for( int i = 0; i < BlockSize; ++i ) { out[i] = std::sin( in[i] ); }
+		}
+	}
+
+	void CosBenchmark()
+	{
+		const std::vector<float> in = ramp( -10.0f, 10.0f );
+		std::vector<float> out( BlockSize );
+		QBENCHMARK { fastCosfBlock( in.data(), out.data(), BlockSize ); }
+	}
+
+	void TanhBenchmark()
+	{
+		const std::vector<float> in = ramp( -5.0f, 5.0f );
+		std::vector<float> out( BlockSize );
+		QBENCHMARK { fastTanhfBlock( in.data(), out.data(), BlockSize ); }
+	}
+
+	void TanhLibmBenchmark()
+	{
+		const std::vector<float> in = ramp( -5.0f, 5.0f );
+		std::vector<float> out( BlockSize );
+		QBENCHMARK
+		{
+			for( int i = 0; i < BlockSize; ++i ) { out[i] = std::tanh( in[i] ); }
+		}
+	}
+
+	void DbfsBenchmark()
+	{
+		const std::vector<float> in = ramp( -120.0f, 20.0f );
+		std::vector<float> out( BlockSize );
+		QBENCHMARK
+		{
+			fastDbfsToAmpBlock( in.data(), out.data(), BlockSize );
+			fastAmpToDbfsBlock( out.data(), out.data(), BlockSize );
+		}
+	}
+} FastMathTests;
+
+#include "FastMathTest.moc"